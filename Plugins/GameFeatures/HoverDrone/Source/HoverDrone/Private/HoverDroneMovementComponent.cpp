@@ -3,6 +3,9 @@
 #include "HoverDroneMovementComponent.h"
 #include "GameFramework/GameMode.h"
 #include "Components/CapsuleComponent.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogHoverDroneMovement, Log, All);
 
 UHoverDroneMovementComponent::UHoverDroneMovementComponent(const FObjectInitializer& ObjectInitializer)	: 
 	Super(ObjectInitializer),
@@ -62,123 +65,182 @@ bool UHoverDroneMovementComponent::ResolvePenetrationImpl(const FVector& Adjustm
 	return true;
 }
 
-// note: only dealing with yaw for now, since that's what we care about
-void UHoverDroneMovementComponent::ApplyControlInputToRotation(float DeltaTime)
+namespace HoverDroneMovement
 {
-	static auto GetVFOV = [](float ViewportAspectRatio, float HFOVDegrees)
+	static float GetVFOV(float ViewportAspectRatio, float HFOVDegrees)
 	{
 		float HFOVRads = FMath::DegreesToRadians(HFOVDegrees);
 		float InverseAspectRatio = 1.0f / ViewportAspectRatio;
 		float VFOVRads = 2.0f * FMath::Atan(FMath::Tan(HFOVRads * 0.5f) * InverseAspectRatio);
 		return FMath::RadiansToDegrees(VFOVRads);
-	};
+	}
 
-	// adjust rot accel and clamps for zoom
-	static float AssumedDefaultHFOV = 90.f;		// the fov we tweaked for
-	static float AssumedDefaultVFOV = GetVFOV(16.0f / 9.0f, AssumedDefaultHFOV);
-	static FVector AssumedDefaultFOV = FRotator(AssumedDefaultVFOV, AssumedDefaultHFOV, 0.0f).Euler();
+	// the fov we tweaked rotation rates for
+	static const float AssumedDefaultHFOV = 90.f;
+
+	static const FVector& GetAssumedDefaultFOV()
+	{
+		static const FVector AssumedDefaultFOV = FRotator(GetVFOV(16.0f / 9.0f, AssumedDefaultHFOV), AssumedDefaultHFOV, 0.0f).Euler();
+		return AssumedDefaultFOV;
+	}
+}
 
+bool UHoverDroneMovementComponent::GetRotationStepParams(FRotationStepParams& OutParams)
+{
 	const APlayerController* const PC = PawnOwner ? Cast<APlayerController>(PawnOwner->GetController()) : nullptr;
 
 	if (PC == nullptr)
 	{
-		return;
+		return false;
 	}
 
 	int ViewportWidth, ViewportHeight;
 	PC->GetViewportSize(ViewportWidth, ViewportHeight);
 	const float AspectRatio = (float)ViewportWidth / (float)ViewportHeight;
 
-	const float CurrentHFOV = (PC && PC->PlayerCameraManager) ? PC->PlayerCameraManager->GetFOVAngle() : AssumedDefaultHFOV;
-	const float CurrentVFOV = GetVFOV(AspectRatio, CurrentHFOV);
+	// adjust rot accel and clamps for zoom
+	const float CurrentHFOV = PC->PlayerCameraManager ? PC->PlayerCameraManager->GetFOVAngle() : HoverDroneMovement::AssumedDefaultHFOV;
+	const FVector& AdjScalar = GetFOVAdjustScalar(AspectRatio, CurrentHFOV);
+
+	OutParams.InputVec = RotationInput.Euler();
+	OutParams.bHasInput = RotationInput.IsZero() == false;
+	OutParams.MaxRotSpeed = GetMaxRotationSpeed().Euler() * AdjScalar;
+	OutParams.RotAccel = AdjScalar * (bTurbo ? TurboRotAcceleration : RotAcceleration);
+	OutParams.RotDecel = AdjScalar * (bTurbo ? TurboRotDeceleration : RotDeceleration);
+	return true;
+}
 
-	const FVector FOV = FRotator(CurrentVFOV, CurrentHFOV, 0.0f).Euler();
-	const FVector AdjScalar = FOV / AssumedDefaultFOV;
-	FVector RotVelocityVec(RotVelocity.Euler());
-	
-	if (RotationInput.IsZero())
-	{
-		// Decelerate towards zero!
-		const float CurrentRotDeacceleration = bTurbo ? TurboRotDeceleration : RotDeceleration;
-		const FVector AdjustedRotDecel = AdjScalar * CurrentRotDeacceleration;
-		const FVector VelocityDeltaVec = AdjustedRotDecel * -RotVelocityVec.GetSignVector() * DeltaTime;
-		const FVector VelocityMin = FVector::Min(FVector::ZeroVector, RotVelocityVec);
-		const FVector VelocityMax = FVector::Max(FVector::ZeroVector, RotVelocityVec);
-		RotVelocityVec = ClampVector(RotVelocityVec + VelocityDeltaVec, VelocityMin, VelocityMax);
-	}
-	else
+const FVector& UHoverDroneMovementComponent::GetFOVAdjustScalar(float AspectRatio, float HFOV)
+{
+	if (AspectRatio != CachedAspectRatio || HFOV != CachedHFOV)
 	{
-		// updating rotation to avoid overshooting badly on long frames!
-		// don't let the delta take us out of bounds.
-		// note that if we're already out of bounds, we'll stay there
-		const FVector InputVec(RotationInput.Euler());
-		const FRotator RotSpeed = GetMaxRotationSpeed();
-		const FVector AdjustedMaxRotSpeed = RotSpeed.Euler() * AdjScalar;
-		const float CurrentRotAcceleration = bTurbo ? TurboRotAcceleration : RotAcceleration;
-		const FVector AdjustedRotAccel = AdjScalar * CurrentRotAcceleration;
-
-		const FVector MaxVelMag = FVector::Min(FVector::OneVector, InputVec.GetAbs()) * AdjustedMaxRotSpeed;
-		const FVector MaxDeltaVel = FVector::Max(FVector::ZeroVector, MaxVelMag - RotVelocityVec);
-		const FVector MinDeltaVel = FVector::Min(FVector::ZeroVector, -(RotVelocityVec + MaxVelMag));
-		const FVector DeltaVel = InputVec * AdjustedRotAccel * DeltaTime;
-		RotVelocityVec += ClampVector(DeltaVel, MinDeltaVel, MaxDeltaVel);
-	}
+		CachedAspectRatio = AspectRatio;
+		CachedHFOV = HFOV;
 
-	RotVelocity = FRotator::MakeFromEuler(RotVelocityVec);
-}
+		const FVector FOV = FRotator(HoverDroneMovement::GetVFOV(AspectRatio, HFOV), HFOV, 0.0f).Euler();
+		CachedFOVAdjustScalar = FOV / HoverDroneMovement::GetAssumedDefaultFOV();
 
-void UHoverDroneMovementComponent::AddRotationInput(FRotator NewRotInput)
-{
-	RotationInput += NewRotInput;
+		// roll has no fov to scale by, leave it alone rather than dividing zero by zero
+		CachedFOVAdjustScalar.X = 1.0f;
+	}
+
+	return CachedFOVAdjustScalar;
 }
 
-void UHoverDroneMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+// note: only dealing with yaw for now, since that's what we care about
+FVector UHoverDroneMovementComponent::ApplyControlInputToRotation(const FRotationStepParams& Params, const FVector& RotVelocityVec, float DeltaTime)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	AController* Controller = PawnOwner->GetController();
-
-	if (PawnOwner == nullptr || UpdatedComponent == nullptr || Controller == nullptr || ShouldSkipUpdate(DeltaTime))
+	if (Params.bHasInput == false)
 	{
-		return;
+		// Decelerate towards zero!
+		const FVector VelocityDeltaVec = Params.RotDecel * -RotVelocityVec.GetSignVector() * DeltaTime;
+		const FVector VelocityMin = FVector::Min(FVector::ZeroVector, RotVelocityVec);
+		const FVector VelocityMax = FVector::Max(FVector::ZeroVector, RotVelocityVec);
+		return ClampVector(RotVelocityVec + VelocityDeltaVec, VelocityMin, VelocityMax);
 	}
 
+	// updating rotation to avoid overshooting badly on long frames!
+	// don't let the delta take us out of bounds.
+	// note that if we're already out of bounds, we'll stay there
+	const FVector MaxVelMag = FVector::Min(FVector::OneVector, Params.InputVec.GetAbs()) * Params.MaxRotSpeed;
+	const FVector MaxDeltaVel = FVector::Max(FVector::ZeroVector, MaxVelMag - RotVelocityVec);
+	const FVector MinDeltaVel = FVector::Min(FVector::ZeroVector, -(RotVelocityVec + MaxVelMag));
+	const FVector DeltaVel = Params.InputVec * Params.RotAccel * DeltaTime;
+	return RotVelocityVec + ClampVector(DeltaVel, MinDeltaVel, MaxDeltaVel);
+}
+
+int32 UHoverDroneMovementComponent::SimulateRotation(const FRotationStepParams* Params, FVector& InOutRotVelocityVec, FRotator& InOutRotation, float DeltaTime, float StepTime, float MinPitchLimit, float MaxPitchLimit)
+{
+	int32 NumSteps = 0;
 	float UnsimulatedTime = DeltaTime;
-	float StepTime = MaxSimulationTimestep > 0.f ? MaxSimulationTimestep : DeltaTime;
 
 	while (UnsimulatedTime > KINDA_SMALL_NUMBER)
 	{
 		// simulate!
 		float SimTime = FMath::Min(UnsimulatedTime, StepTime);
 
-		if (Controller->IsLocalPlayerController())
+		const FVector NewRotVelocityVec = Params ? ApplyControlInputToRotation(*Params, InOutRotVelocityVec, SimTime) : InOutRotVelocityVec;
+
+		// once a full step leaves the velocity alone it has settled on its clamps (or on zero), and every remaining step
+		// would rotate at the same rate. take them all at once, unless pitch would hit its limits on the way.
+		if (SimTime < UnsimulatedTime && NewRotVelocityVec.X == InOutRotVelocityVec.X && NewRotVelocityVec.Z == InOutRotVelocityVec.Z
+			&& InOutRotation.Pitch >= MinPitchLimit && InOutRotation.Pitch <= MaxPitchLimit)
 		{
-			ApplyControlInputToRotation(SimTime);
+			if (NewRotVelocityVec.Y == InOutRotVelocityVec.Y)
+			{
+				const float FinalPitch = InOutRotation.Pitch + NewRotVelocityVec.Y * UnsimulatedTime;
+				if (FinalPitch >= MinPitchLimit && FinalPitch <= MaxPitchLimit)
+				{
+					SimTime = UnsimulatedTime;
+				}
+			}
+			else if (InOutRotVelocityVec.Y == 0.f)
+			{
+				// pitch held against a limit: every step accelerates from zero into the limit and gets clamped back to zero,
+				// so it is settled as well, the remaining steps only leave pitch on the limit
+				const float StepDeltaPitch = NewRotVelocityVec.Y * SimTime;
+				if (StepDeltaPitch != FMath::Clamp(StepDeltaPitch, MinPitchLimit - (float)InOutRotation.Pitch, MaxPitchLimit - (float)InOutRotation.Pitch))
+				{
+					SimTime = UnsimulatedTime;
+				}
+			}
 		}
 
-		FRotator RotDelta = RotVelocity * SimTime;
+		InOutRotVelocityVec = NewRotVelocityVec;
+		FRotator RotDelta = FRotator::MakeFromEuler(InOutRotVelocityVec) * SimTime;
 
 		// enforce pitch limits
-		float const CurrentPitch = UpdatedComponent->GetComponentRotation().Pitch;
-		float const MinDeltaPitch = MinPitch - CurrentPitch;
-		float const MaxDeltaPitch = MaxPitch - CurrentPitch;
+		float const MinDeltaPitch = MinPitchLimit - InOutRotation.Pitch;
+		float const MaxDeltaPitch = MaxPitchLimit - InOutRotation.Pitch;
 		float const OldPitch = RotDelta.Pitch;
 		RotDelta.Pitch = FMath::Clamp(RotDelta.Pitch, MinDeltaPitch, MaxDeltaPitch);
 		if (OldPitch != RotDelta.Pitch)
 		{
 			// if we got clamped, zero the pitch velocity
-			RotVelocity.Pitch = 0.f;
+			InOutRotVelocityVec.Y = 0.f;
 		}
 
-		if (!RotDelta.IsNearlyZero())
-		{
-			FRotator const NewRot = UpdatedComponent->GetComponentRotation() + RotDelta;
+		InOutRotation += RotDelta;
+		UnsimulatedTime -= SimTime;
+		++NumSteps;
+	}
 
-			FHitResult Hit(1.f);
-			SafeMoveUpdatedComponent(FVector::ZeroVector, NewRot, false, Hit);
-		}
+	return NumSteps;
+}
 
-		UnsimulatedTime -= SimTime;
+void UHoverDroneMovementComponent::AddRotationInput(FRotator NewRotInput)
+{
+	RotationInput += NewRotInput;
+}
+
+void UHoverDroneMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	AController* Controller = PawnOwner->GetController();
+
+	if (PawnOwner == nullptr || UpdatedComponent == nullptr || Controller == nullptr || ShouldSkipUpdate(DeltaTime))
+	{
+		return;
+	}
+
+	float StepTime = MaxSimulationTimestep > 0.f ? MaxSimulationTimestep : DeltaTime;
+
+	// rotation rates only depend on this frame's input and fov, gather them once for every substep
+	FRotationStepParams RotationParams;
+	const bool bApplyRotationInput = Controller->IsLocalPlayerController() && GetRotationStepParams(RotationParams);
+
+	FVector RotVelocityVec(RotVelocity.Euler());
+	FRotator const OldRot = UpdatedComponent->GetComponentRotation();
+	FRotator NewRot = OldRot;
+	SimulateRotation(bApplyRotationInput ? &RotationParams : nullptr, RotVelocityVec, NewRot, DeltaTime, StepTime, MinPitch, MaxPitch);
+	RotVelocity = FRotator::MakeFromEuler(RotVelocityVec);
+
+	// the rotation isn't swept, so the substeps can be applied as a single move
+	if (!(NewRot - OldRot).IsNearlyZero())
+	{
+		FHitResult Hit(1.f);
+		SafeMoveUpdatedComponent(FVector::ZeroVector, NewRot, false, Hit);
 	}
 
 	if (Controller && Controller->IsLocalPlayerController())
@@ -268,3 +330,161 @@ void UHoverDroneMovementComponent::RestrictDroneInput()
 		AddInputVector(NewAccelInput, true);
 	}
 }
+
+
+/* FHoverDroneMovementTests
+ *****************************************************************************/
+
+struct FHoverDroneMovementTests
+{
+	static bool RunRotationHitchBenchmark(int32 NumFrames);
+};
+
+bool FHoverDroneMovementTests::RunRotationHitchBenchmark(int32 NumFrames)
+{
+	using FRotationStepParams = UHoverDroneMovementComponent::FRotationStepParams;
+
+	NumFrames = FMath::Max(NumFrames, 1);
+
+	UHoverDroneMovementComponent* MovementComponent = NewObject<UHoverDroneMovementComponent>(GetTransientPackage());
+	const float StepTime = MovementComponent->MaxSimulationTimestep > 0.f ? MovementComponent->MaxSimulationTimestep : 1.f / 60.f;
+
+	// a steady 60hz with a hitch every half second, from short stalls up to level streaming sized ones
+	const float FrameTime = 1.f / 60.f;
+	const float HitchTimes[] = { 0.1f, 0.25f, 0.5f, 1.0f, 2.0f };
+	const int32 NumBuckets = UE_ARRAY_COUNT(HitchTimes) + 1;
+
+	uint64 BucketCycles[2][NumBuckets] = {};
+	int32 BucketSteps[2][NumBuckets] = {};
+	int32 BucketFrames[NumBuckets] = {};
+
+	FVector RotVelocityVec[2] = { FVector::ZeroVector, FVector::ZeroVector };
+	FRotator Rotation[2] = { FRotator::ZeroRotator, FRotator::ZeroRotator };
+	bool bPassed = true;
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		const int32 Bucket = (Frame % 30 == 29) ? 1 + (Frame / 30) % UE_ARRAY_COUNT(HitchTimes) : 0;
+		const float DeltaTime = Bucket > 0 ? HitchTimes[Bucket - 1] : FrameTime;
+
+		// hold yaw and some pitch for a while, then let go, zooming in now and then
+		const bool bHasInput = (Frame % 150) < 90;
+		const FRotator RotationInput = bHasInput ? FRotator(0.5f, 1.f, 0.f) : FRotator::ZeroRotator;
+		const float HFOV = (Frame % 400) < 100 ? 40.f : 90.f;
+		const float AspectRatio = 16.f / 9.f;
+
+		// pass 0 is the old per substep path, recomputing the fov scale every step; pass 1 caches it and folds settled steps
+		for (int32 Pass = 0; Pass < 2; ++Pass)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			int32 NumSteps = 0;
+
+			if (Pass == 0)
+			{
+				float UnsimulatedTime = DeltaTime;
+				while (UnsimulatedTime > KINDA_SMALL_NUMBER)
+				{
+					const float SimTime = FMath::Min(UnsimulatedTime, StepTime);
+
+					const FVector FOV = FRotator(HoverDroneMovement::GetVFOV(AspectRatio, HFOV), HFOV, 0.0f).Euler();
+					FVector AdjScalar = FOV / HoverDroneMovement::GetAssumedDefaultFOV();
+					AdjScalar.X = 1.0f;
+
+					FRotationStepParams Params;
+					Params.InputVec = RotationInput.Euler();
+					Params.bHasInput = bHasInput;
+					Params.MaxRotSpeed = MovementComponent->GetMaxRotationSpeed().Euler() * AdjScalar;
+					Params.RotAccel = AdjScalar * MovementComponent->RotAcceleration;
+					Params.RotDecel = AdjScalar * MovementComponent->RotDeceleration;
+
+					NumSteps += UHoverDroneMovementComponent::SimulateRotation(&Params, RotVelocityVec[Pass], Rotation[Pass], SimTime, StepTime, MovementComponent->MinPitch, MovementComponent->MaxPitch);
+					UnsimulatedTime -= SimTime;
+				}
+			}
+			else
+			{
+				const FVector& AdjScalar = MovementComponent->GetFOVAdjustScalar(AspectRatio, HFOV);
+
+				FRotationStepParams Params;
+				Params.InputVec = RotationInput.Euler();
+				Params.bHasInput = bHasInput;
+				Params.MaxRotSpeed = MovementComponent->GetMaxRotationSpeed().Euler() * AdjScalar;
+				Params.RotAccel = AdjScalar * MovementComponent->RotAcceleration;
+				Params.RotDecel = AdjScalar * MovementComponent->RotDeceleration;
+
+				NumSteps = UHoverDroneMovementComponent::SimulateRotation(&Params, RotVelocityVec[Pass], Rotation[Pass], DeltaTime, StepTime, MovementComponent->MinPitch, MovementComponent->MaxPitch);
+			}
+
+			BucketCycles[Pass][Bucket] += FPlatformTime::Cycles64() - StartCycles;
+			BucketSteps[Pass][Bucket] += NumSteps;
+
+			// the component's rotation comes back normalized every frame
+			Rotation[Pass] = Rotation[Pass].GetNormalized();
+		}
+
+		++BucketFrames[Bucket];
+
+		bPassed &= Rotation[0].Equals(Rotation[1], 0.01f);
+		bPassed &= RotVelocityVec[0].Equals(RotVelocityVec[1], 0.01f);
+	}
+
+	// pitch held against its limit while yawing at full speed, the clamp zeroing the pitch velocity every step must not stop the fold
+	int32 HeldSteps[2] = {};
+	{
+		const float HitchTime = HitchTimes[UE_ARRAY_COUNT(HitchTimes) - 1];
+
+		FRotationStepParams Params;
+		Params.InputVec = FRotator(1.f, 1.f, 0.f).Euler();
+		Params.bHasInput = true;
+		Params.MaxRotSpeed = MovementComponent->GetMaxRotationSpeed().Euler();
+		Params.RotAccel = FVector(MovementComponent->RotAcceleration);
+		Params.RotDecel = FVector(MovementComponent->RotDeceleration);
+
+		FVector HeldRotVelocityVec[2] = { FVector(0.f, 0.f, Params.MaxRotSpeed.Z), FVector(0.f, 0.f, Params.MaxRotSpeed.Z) };
+		FRotator HeldRotation[2] = { FRotator(MovementComponent->MaxPitch, 0.f, 0.f), FRotator(MovementComponent->MaxPitch, 0.f, 0.f) };
+
+		float UnsimulatedTime = HitchTime;
+		while (UnsimulatedTime > KINDA_SMALL_NUMBER)
+		{
+			const float SimTime = FMath::Min(UnsimulatedTime, StepTime);
+			HeldSteps[0] += UHoverDroneMovementComponent::SimulateRotation(&Params, HeldRotVelocityVec[0], HeldRotation[0], SimTime, StepTime, MovementComponent->MinPitch, MovementComponent->MaxPitch);
+			UnsimulatedTime -= SimTime;
+		}
+
+		HeldSteps[1] = UHoverDroneMovementComponent::SimulateRotation(&Params, HeldRotVelocityVec[1], HeldRotation[1], HitchTime, StepTime, MovementComponent->MinPitch, MovementComponent->MaxPitch);
+
+		bPassed &= HeldSteps[1] == 1;
+		bPassed &= HeldRotation[0].Equals(HeldRotation[1], 0.01f);
+		bPassed &= HeldRotVelocityVec[0].Equals(HeldRotVelocityVec[1], 0.01f);
+	}
+
+	UE_LOG(LogHoverDroneMovement, Log, TEXT("Hover drone rotation hitch benchmark, %d frames:"), NumFrames);
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		if (BucketFrames[Bucket] == 0)
+		{
+			continue;
+		}
+
+		const double FrameCount = (double)BucketFrames[Bucket];
+		UE_LOG(LogHoverDroneMovement, Log, TEXT("  %.3f s frames (%d): substepped %.3f us, %.1f steps per frame; cached and folded %.3f us, %.1f steps per frame"),
+			Bucket > 0 ? HitchTimes[Bucket - 1] : FrameTime, BucketFrames[Bucket],
+			FPlatformTime::ToMilliseconds64(BucketCycles[0][Bucket]) * 1000.0 / FrameCount, BucketSteps[0][Bucket] / FrameCount,
+			FPlatformTime::ToMilliseconds64(BucketCycles[1][Bucket]) * 1000.0 / FrameCount, BucketSteps[1][Bucket] / FrameCount);
+	}
+
+	UE_LOG(LogHoverDroneMovement, Log, TEXT("  pitch held at its limit: substepped %d steps, folded %d steps"), HeldSteps[0], HeldSteps[1]);
+
+	// both paths take the same steps until the velocity settles, folding only changes float rounding
+	UE_LOG(LogHoverDroneMovement, Log, TEXT("%s"), bPassed ? TEXT("... TEST PASSED!") : TEXT("... TEST FAILED!"));
+	return bPassed;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs HoverDroneRotationBenchmarkCommand(
+	TEXT("HoverDrone.RotationHitchBenchmark"),
+	TEXT("Compare per substep and folded hover drone rotation over a frame sequence with hitches. Usage: HoverDrone.RotationHitchBenchmark [NumFrames]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumFrames = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 6000;
+		FHoverDroneMovementTests::RunRotationHitchBenchmark(NumFrames);
+	}));
@@ -98,7 +98,32 @@ protected:
 	
 private:
 
-	void ApplyControlInputToRotation(float DeltaTime);
+	/** Rotation input and FOV adjusted rotation rates, gathered once per tick and shared by all of its substeps. Vectors are in Euler order (roll, pitch, yaw). */
+	struct FRotationStepParams
+	{
+		FVector InputVec = FVector::ZeroVector;
+		FVector MaxRotSpeed = FVector::ZeroVector;
+		FVector RotAccel = FVector::ZeroVector;
+		FVector RotDecel = FVector::ZeroVector;
+		bool bHasInput = false;
+	};
+
+	/** Gathers this tick's rotation params from the player controller, returns false if there is none. */
+	bool GetRotationStepParams(FRotationStepParams& OutParams);
+
+	/** Scale applied to rotation rates for the current FOV, relative to the FOV they were tweaked for. Only recomputed when the FOV or aspect ratio change. */
+	const FVector& GetFOVAdjustScalar(float AspectRatio, float HFOV);
+
+	/** Applies rotation input to the rotation velocity for one substep. */
+	static FVector ApplyControlInputToRotation(const FRotationStepParams& Params, const FVector& RotVelocityVec, float DeltaTime);
+
+	/**
+	 * Integrates the rotation over DeltaTime in substeps of at most StepTime, without input if Params is null.
+	 * Once the rotation velocity settles the remaining substeps are taken as one, so long frames cost about the same as short ones.
+	 * Returns the number of substeps simulated.
+	 */
+	static int32 SimulateRotation(const FRotationStepParams* Params, FVector& InOutRotVelocityVec, FRotator& InOutRotation, float DeltaTime, float StepTime, float MinPitchLimit, float MaxPitchLimit);
+
 	float MeasureAltitude(FVector Location, float TestHeight, bool& bHitFoundOut, FVector& HitPositionOut) const;
 	FRotator GetMaxRotationSpeed() const;
 	void RestrictDroneInput();
@@ -126,6 +151,13 @@ private:
 	FVector LastGroundPosition;
 	bool bHasGround = true;
 	bool bLastGroundPositionValid = false;
+
+	/** FOV and aspect ratio CachedFOVAdjustScalar was computed for */
+	float CachedAspectRatio = 0.0f;
+	float CachedHFOV = 0.0f;
+	FVector CachedFOVAdjustScalar = FVector::OneVector;
+
+	friend struct FHoverDroneMovementTests;
 };
 
 
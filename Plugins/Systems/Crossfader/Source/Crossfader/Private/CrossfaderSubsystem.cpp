@@ -7,6 +7,13 @@
 #include "SoundControlBusMix.h"
 #include "UObject/SoftObjectPath.h"
 #include "Containers/UnrealString.h"
+#include "Stats/Stats.h"
+#include "Misc/CoreDelegates.h"
+
+DECLARE_STATS_GROUP(TEXT("Crossfader"), STATGROUP_Crossfader, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Deferred Mix Activations"), STAT_CrossfaderDeferredActivations, STATGROUP_Crossfader);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Redundant Mix Requests"), STAT_CrossfaderRedundantMixRequests, STATGROUP_Crossfader);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Submitted Mix Changes"), STAT_CrossfaderSubmittedMixChanges, STATGROUP_Crossfader);
 
 UCrossfaderSettings::UCrossfaderSettings(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -27,6 +34,9 @@ void UCrossfaderSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	// Cache World reference
 	World = GetWorld();
 
+	// Mix changes requested during a frame are submitted together once it ends
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UCrossfaderSubsystem::SubmitMixChanges);
+
 	// Get plugin settings on Subsystem initialization
 	const UCrossfaderSettings* CrossfaderSettings = GetDefault<UCrossfaderSettings>();
 
@@ -36,86 +46,132 @@ void UCrossfaderSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 		// Make sure plugin settings aren't empty
 		if (!CrossfaderSettings->MixStateBanks.IsEmpty())
 		{
-			// Loop through settings to collect bank data
-			for (auto It = CrossfaderSettings->MixStateBanks.CreateConstIterator(); It; ++It)
+			// Stream the banks in, their data is added to the master bank when they arrive
+			SettingsBanksHandle = StreamableManager.RequestAsyncLoad(CrossfaderSettings->MixStateBanks, FStreamableDelegate::CreateUObject(this, &UCrossfaderSubsystem::OnSettingsBanksLoaded));
+		}
+
+		// Activate mixes if not already activated
+		if (!bDefaultMixesActivated && World)
+		{
+			TArray<FSoftObjectPath> DefaultMixPaths = CrossfaderSettings->BaseProjectMixes;
+
+			if (CrossfaderSettings->UserMix.IsValid())
 			{
-				// Load to retrieve bank data
-				if (UObject* BankObj = It->TryLoad())
-				{
-					UMixStateBank* MixStateBank = Cast<UMixStateBank>(BankObj);
+				DefaultMixPaths.Add(CrossfaderSettings->UserMix);
+			}
 
-					if (MixStateBank)
-					{
-						// If bank is loaded, append stored data to master bank
-						AddBank(MixStateBank);
-					}
-					else
-					{
-						// Bank failed cast
-						const FString ObjName = BankObj->GetFullName();
-						UE_LOG(LogCrossfader, Warning, TEXT("Failed to cast %s to default MixStateBank during initialization."), *ObjName);
-					}
+			// Stream the mixes in, they are activated when they arrive
+			DefaultMixesHandle = StreamableManager.RequestAsyncLoad(DefaultMixPaths, FStreamableDelegate::CreateUObject(this, &UCrossfaderSubsystem::OnDefaultMixesLoaded));
+		}
+	}
+
+}
+
+void UCrossfaderSubsystem::OnSettingsBanksLoaded()
+{
+	const UCrossfaderSettings* CrossfaderSettings = GetDefault<UCrossfaderSettings>();
+
+	if (CrossfaderSettings)
+	{
+		// Loop through settings to collect bank data
+		for (auto It = CrossfaderSettings->MixStateBanks.CreateConstIterator(); It; ++It)
+		{
+			// Bank should be resident now
+			if (UObject* BankObj = It->ResolveObject())
+			{
+				UMixStateBank* MixStateBank = Cast<UMixStateBank>(BankObj);
+
+				if (MixStateBank)
+				{
+					// If bank is loaded, append stored data to master bank
+					AddBank(MixStateBank);
 				}
 				else
 				{
-					// Failed to load SoftObjectPath
-					const FString SoftObjPathName = It->GetAssetPathString();
-					UE_LOG(LogCrossfader, Warning, TEXT("Failed to load default MixStateBank SoftObjectPath %s during initialization."), *SoftObjPathName);
+					// Bank failed cast
+					const FString ObjName = BankObj->GetFullName();
+					UE_LOG(LogCrossfader, Warning, TEXT("Failed to cast %s to default MixStateBank during initialization."), *ObjName);
 				}
 			}
+			else
+			{
+				// Failed to load SoftObjectPath
+				const FString SoftObjPathName = It->GetAssetPathString();
+				UE_LOG(LogCrossfader, Warning, TEXT("Failed to load default MixStateBank SoftObjectPath %s during initialization."), *SoftObjPathName);
+			}
+		}
+	}
 
+	SettingsBanksHandle.Reset();
+}
+
+void UCrossfaderSubsystem::OnDefaultMixesLoaded()
+{
+	const UCrossfaderSettings* CrossfaderSettings = GetDefault<UCrossfaderSettings>();
+
+	// Activate mixes if not already activated
+	if (CrossfaderSettings && !bDefaultMixesActivated && World)
+	{
+		// Cast to a USoundControlBusMix
+		USoundControlBusMix* UserMix = Cast<USoundControlBusMix>(CrossfaderSettings->UserMix.ResolveObject());
 
+		// Activate if valid
+		if (UserMix)
+		{
+			UAudioModulationStatics::ActivateBusMix(World, UserMix);
+			ActivatedUserMix = UserMix;
 		}
 
-		// Activate mixes if not already activated
-		if (!bDefaultMixesActivated && World)
+		for (auto It = CrossfaderSettings->BaseProjectMixes.CreateConstIterator(); It; ++It)
 		{
-			// Get User Mix
-			FSoftObjectPath UserMixPath = CrossfaderSettings->UserMix;
+			// Cast to a USoundControlBusMix
+			USoundControlBusMix* BaseMix = Cast<USoundControlBusMix>(It->ResolveObject());
 
-			// Try to load the Mix
-			if (UObject* MixObj = UserMixPath.TryLoad())
+			// Activate if valid
+			if (BaseMix)
 			{
-				// Cast to a USoundControlBusMix
-				USoundControlBusMix* UserMix = Cast<USoundControlBusMix>(MixObj);
-
-				// Activate if valid
-				if (UserMix)
-				{
-					UAudioModulationStatics::ActivateBusMix(World, UserMix);
-					ActivatedUserMix = UserMix;
-				}
+				UAudioModulationStatics::ActivateBusMix(World, BaseMix);
+				ActivatedDefaultMixes.AddUnique(BaseMix);
 			}
+		}
 
-			for (auto It = CrossfaderSettings->BaseProjectMixes.CreateConstIterator(); It; ++It)
-			{
-				// Get Base Mix
-				FSoftObjectPath BaseMixPath = *It;
+		// Update activation state
+		bDefaultMixesActivated = true;
+	}
 
-				if (UObject* MixObj = BaseMixPath.TryLoad())
-				{
-					// Cast to a USoundControlBusMix
-					USoundControlBusMix* BaseMix = Cast<USoundControlBusMix>(MixObj);
+	DefaultMixesHandle.Reset();
+}
 
-					// Activate if valid
-					if (BaseMix)
-					{
-						UAudioModulationStatics::ActivateBusMix(World, BaseMix);
-						ActivatedDefaultMixes.AddUnique(BaseMix);
-					}
-				}
+void UCrossfaderSubsystem::Deinitialize()
+{
+	// Stop any loads still in flight, their callbacks must not fire on a deinitialized Subsystem
+	if (SettingsBanksHandle.IsValid())
+	{
+		SettingsBanksHandle->CancelHandle();
+		SettingsBanksHandle.Reset();
+	}
 
-			}
+	if (DefaultMixesHandle.IsValid())
+	{
+		DefaultMixesHandle->CancelHandle();
+		DefaultMixesHandle.Reset();
+	}
 
-			// Update activation state
-			bDefaultMixesActivated = true;
+	for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& BankMixHandle : BankMixHandles)
+	{
+		if (BankMixHandle.Value.IsValid())
+		{
+			BankMixHandle.Value->CancelHandle();
 		}
 	}
 
-}
+	BankMixHandles.Empty();
+	DeferredMixStates.Empty();
+
+	// Submit anything requested this frame before going away
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	SubmitMixChanges();
 
-void UCrossfaderSubsystem::Deinitialize()
-{
 	// Make sure World is still valid
 	if (World)
 	{
@@ -161,9 +217,51 @@ void UCrossfaderSubsystem::AddBank(const UMixStateBank* MixStateBank)
 		TArray<FCrossfaderMixPair> BankData;
 		BankData.Append(MixStateBank->MixStates);
 
+		// Collect every ControlBusMix the bank references so SetMixState never has to load from disk
+		TArray<FSoftObjectPath> BankMixPaths;
+
+		for (const FCrossfaderMixPair& MixPair : BankData)
+		{
+			if (MixPair.ControlBusMix.IsValid())
+			{
+				BankMixPaths.AddUnique(MixPair.ControlBusMix);
+			}
+		}
+
 		// Bank path is used as key so data can be removed and added easily
 		MasterMixStateBank.Add(BankPath, BankData);
+
+		RebuildMixStateIndex();
+
+		// The handle keeps the mixes resident for as long as the bank is in the master bank
+		TSharedPtr<FStreamableHandle> BankMixHandle = StreamableManager.RequestAsyncLoad(BankMixPaths, FStreamableDelegate::CreateUObject(this, &UCrossfaderSubsystem::OnBankMixesLoaded));
+		BankMixHandles.Add(BankPath, BankMixHandle);
+	}
+}
+
+void UCrossfaderSubsystem::OnBankMixesLoaded()
+{
+	if (DeferredMixStates.Num() == 0)
+	{
+		return;
 	}
+
+	// Replay deferred requests in the order they were made. Anything still loading is deferred again, anything whose
+	// mix failed to load is dropped
+	TArray<FCrossfaderDeferredMixState> MixStatesToReplay = MoveTemp(DeferredMixStates);
+	DeferredMixStates.Reset();
+
+	bReplayingDeferredMixStates = true;
+
+	for (const FCrossfaderDeferredMixState& DeferredMixState : MixStatesToReplay)
+	{
+		if (const UObject* WorldContextObject = DeferredMixState.WorldContextObject.Get())
+		{
+			SetMixState(WorldContextObject, DeferredMixState.MixState, DeferredMixState.bFallBackToNearestParent, DeferredMixState.bDeactivateChildren);
+		}
+	}
+
+	bReplayingDeferredMixStates = false;
 }
 
 void UCrossfaderSubsystem::RemoveBank(const UMixStateBank* MixStateBank)
@@ -177,10 +275,79 @@ void UCrossfaderSubsystem::RemoveBank(const UMixStateBank* MixStateBank)
 		{
 			// If key is found, remove the bank data from the Master Bank
 			MasterMixStateBank.Remove(BankKey);
+
+			RebuildMixStateIndex();
+		}
+
+		// Release the bank's mixes, mixes still active stay referenced by ActiveMixes
+		TSharedPtr<FStreamableHandle> BankMixHandle;
+
+		if (BankMixHandles.RemoveAndCopyValue(BankKey, BankMixHandle) && BankMixHandle.IsValid())
+		{
+			BankMixHandle->ReleaseHandle();
 		}
 	}
 }
 
+void UCrossfaderSubsystem::RebuildMixStateIndex()
+{
+	MixStateIndex.Reset();
+
+	for (const TPair<FSoftObjectPath, TArray<FCrossfaderMixPair>>& Bank : MasterMixStateBank)
+	{
+		for (const FCrossfaderMixPair& MixPair : Bank.Value)
+		{
+			// Keep the first definition of a MixState, matching the order the master bank is searched in
+			if (MixPair.MixState.IsValid() && !MixStateIndex.Contains(MixPair.MixState))
+			{
+				MixStateIndex.Add(MixPair.MixState, MixPair.ControlBusMix);
+			}
+		}
+	}
+}
+
+bool UCrossfaderSubsystem::IsBankMixLoading(const FSoftObjectPath& ControlBusMixPath) const
+{
+	TArray<FSoftObjectPath> RequestedMixPaths;
+
+	for (const TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& BankMixHandle : BankMixHandles)
+	{
+		if (BankMixHandle.Value.IsValid() && BankMixHandle.Value->IsLoadingInProgress())
+		{
+			RequestedMixPaths.Reset();
+			BankMixHandle.Value->GetRequestedAssets(RequestedMixPaths);
+
+			if (RequestedMixPaths.Contains(ControlBusMixPath))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void UCrossfaderSubsystem::RemoveSupersededDeferredMixStates(FGameplayTag MixState, bool bDeactivateChildren)
+{
+	const FGameplayTag MixStateParent = MixState.RequestDirectParent();
+
+	DeferredMixStates.RemoveAll([&MixState, &MixStateParent, bDeactivateChildren](const FCrossfaderDeferredMixState& DeferredMixState)
+	{
+		if (DeferredMixState.MixState == MixState)
+		{
+			return true;
+		}
+
+		// Top level MixStates have no group
+		if (!MixStateParent.IsValid())
+		{
+			return false;
+		}
+
+		return bDeactivateChildren ? DeferredMixState.MixState.MatchesTag(MixStateParent) : DeferredMixState.MixState.RequestDirectParent() == MixStateParent;
+	});
+}
+
 bool UCrossfaderSubsystem::SetMixState(const UObject* WorldContextObject, FGameplayTag MixState, bool bFallBackToNearestParent, bool bDeactivateChildren)
 {
 	// Validate UWorld and Tag
@@ -199,83 +366,56 @@ bool UCrossfaderSubsystem::SetMixState(const UObject* WorldContextObject, FGamep
 		return false;
 	}
 
-	// Loop through find exact match, if no exact match is found, look for exact parent match
-	TArray<TArray<FCrossfaderMixPair>> MasterListArray;
-	MasterMixStateBank.GenerateValueArray(MasterListArray);
-
 	// Set up variables for search
 	USoundControlBusMix* BankMixToAdd = nullptr;
-	FSoftObjectPath BankMixPath;
 	bool bExactMatchFound = false;
 	FGameplayTag MixStateParent = MixState.RequestDirectParent();
 	FGameplayTag SelectedMixState;
 
-	// Begin search
-	for (auto ItA = MasterListArray.CreateConstIterator(); ItA; ++ItA)
+	// Look for an exact match first, then walk up the MixState namespace if falling back to the nearest parent
+	for (FGameplayTag SearchTag = MixState; SearchTag.IsValid(); SearchTag = SearchTag.RequestDirectParent())
 	{
-		TArray<FCrossfaderMixPair> BankArray = *ItA;
-		
-		for (auto ItB = BankArray.CreateConstIterator(); ItB; ++ItB)
+		if (const FSoftObjectPath* BankMixPath = MixStateIndex.Find(SearchTag))
 		{
-			FGameplayTag BankTag = ItB->MixState;
-			
-			if (MixState.MatchesTagExact(BankTag))
+			// Only use resident mixes, the bank streams its mixes in when it's added
+			if (UObject* BankObj = BankMixPath->ResolveObject())
 			{
-				// Cache matching bank tag
-				SelectedMixState = BankTag;
-
-				// If we have an exact state match, set the BankMixPath
-				BankMixPath = ItB->ControlBusMix;
-
-				// Try to load the Bank Bus Mix
-				if (UObject* BankObj = BankMixPath.TryLoad())
-				{
-					// Cast to a USoundControlBusMix
-					BankMixToAdd = Cast<USoundControlBusMix>(BankObj);
+				// Cast to a USoundControlBusMix
+				BankMixToAdd = Cast<USoundControlBusMix>(BankObj);
 
-					// We found a match, set flag to true
-					bExactMatchFound = true;
+				// Cache matching bank tag
+				SelectedMixState = SearchTag;
+				bExactMatchFound = SearchTag == MixState;
 
-					// We found a match, we can leave the loop
-					break;
-				}
+				break;
 			}
-			else
-			{
-				// If we want to fall back to nearest parent, do so in this loop
-				if (bFallBackToNearestParent)
-				{
-					FGameplayTag MixStateTag = MixState;
 
-					// Search for nearest valid parent tag
-					for (uint32 i = 0; i < MixStateTagDepth; ++i)
-					{
-						MixStateTag = MixStateTag.RequestDirectParent();
+			if (IsBankMixLoading(*BankMixPath))
+			{
+				// The mix is still loading, set this MixState again once it arrives. It supersedes older pending requests in its group
+				RemoveSupersededDeferredMixStates(MixState, bDeactivateChildren);
 
-						if (MixStateTag.MatchesTagExact(BankTag))
-						{
-							// Cache matching bank tag
-							SelectedMixState = BankTag;
-
-							// If the MixStateTag matches, cache just in case we never find an exact match
-							BankMixPath = ItB->ControlBusMix;
-
-							// Try to load the Bank Bus Mix
-							if (UObject* BankObj = BankMixPath.TryLoad())
-							{
-								// Cast to a USoundControlBusMix
-								BankMixToAdd = Cast<USoundControlBusMix>(BankObj);
-							}
-						}
-					}
+				FCrossfaderDeferredMixState& DeferredMixState = DeferredMixStates.AddDefaulted_GetRef();
+				DeferredMixState.WorldContextObject = WorldContextObject;
+				DeferredMixState.MixState = MixState;
+				DeferredMixState.bFallBackToNearestParent = bFallBackToNearestParent;
+				DeferredMixState.bDeactivateChildren = bDeactivateChildren;
 
+				if (!bReplayingDeferredMixStates)
+				{
+					++NumDeferredActivations;
+					INC_DWORD_STAT(STAT_CrossfaderDeferredActivations);
 				}
+
+				return true;
 			}
+
+			// Nothing is loading the mix anymore (e.g. a missing asset), it will never arrive
+			UE_LOG(LogCrossfader, Warning, TEXT("ControlBusMix %s for MixState %s failed to load."), *BankMixPath->ToString(), *SearchTag.ToString());
 		}
 
-		if (bExactMatchFound)
+		if (!bFallBackToNearestParent)
 		{
-			// We found an exact match in the last sub-loop, we can leave the search
 			break;
 		}
 	}
@@ -286,7 +426,10 @@ bool UCrossfaderSubsystem::SetMixState(const UObject* WorldContextObject, FGamep
 		return false;
 	}
 
-	TArray<FGameplayTag> OldMixesToRemove;
+	// This request is newer than anything still waiting on a load in its group
+	RemoveSupersededDeferredMixStates(SelectedMixState, bDeactivateChildren);
+
+	TArray<FGameplayTag, TInlineAllocator<8>> OldMixesToRemove;
 	bool bMixAlreadyActive = false;
 	bool bMixesAreSiblings = false;
 
@@ -325,7 +468,7 @@ bool UCrossfaderSubsystem::SetMixState(const UObject* WorldContextObject, FGamep
 					if (OldBusMix)
 					{
 						// If the mix is still valid, deactivate it
-						UAudioModulationStatics::DeactivateBusMix(WorldContextObject, OldBusMix);
+						QueueBusMixActivation(WorldContextObject, OldBusMix, false);
 
 						bMixesAreSiblings = ActiveMixKey == SelectedMixStateParent;
 
@@ -357,7 +500,7 @@ bool UCrossfaderSubsystem::SetMixState(const UObject* WorldContextObject, FGamep
 	if (!bMixAlreadyActive)
 	{
 		// If mix is not already active, activate the mix
-		UAudioModulationStatics::ActivateBusMix(WorldContextObject, BankMixToAdd);
+		QueueBusMixActivation(WorldContextObject, BankMixToAdd, true);
 
 		// Set up Map Variables
 		FCrossfaderMixBusStatePair MixBusStatePairToAdd;
@@ -403,7 +546,13 @@ void UCrossfaderSubsystem::ClearMixState(const UObject* WorldContextObject, FGam
 	// Validate UWorld and Tag
 	if (WorldContextObject || MixState.IsValid())
 	{
-		TArray<FGameplayTag> OldMixesToRemove;
+		// A cleared MixState that is still waiting on its mix should never activate
+		DeferredMixStates.RemoveAll([&MixState, bDeactivateChildren](const FCrossfaderDeferredMixState& DeferredMixState)
+		{
+			return bDeactivateChildren ? DeferredMixState.MixState.MatchesTag(MixState) : DeferredMixState.MixState.MatchesTagExact(MixState);
+		});
+
+		TArray<FGameplayTag, TInlineAllocator<8>> OldMixesToRemove;
 		bool bMixAlreadyActive = false;
 
 		// Check Active Mixes to determine if we need to deactivate a current mix
@@ -446,7 +595,7 @@ void UCrossfaderSubsystem::ClearMixState(const UObject* WorldContextObject, FGam
 						if (OldBusMix)
 						{
 							// If the mix is still valid, deactivate it
-							UAudioModulationStatics::DeactivateBusMix(WorldContextObject, OldBusMix);
+							QueueBusMixActivation(WorldContextObject, OldBusMix, false);
 
 							OldMixesToRemove.AddUnique(ActiveMixKey);
 
@@ -474,17 +623,111 @@ void UCrossfaderSubsystem::ClearMixState(const UObject* WorldContextObject, FGam
 	}
 }
 
-uint32 UCrossfaderSubsystem::GameplayTagDepth(FGameplayTag GameplayTag)
+void UCrossfaderSubsystem::QueueBusMixActivation(const UObject* WorldContextObject, USoundControlBusMix* ControlBusMix, bool bActivate)
 {
-	// Convert to string
-	FString GameplayTagString = GameplayTag.ToString();
+	if (ControlBusMix)
+	{
+		if (bActivate)
+		{
+			DesiredMixes.Add(ControlBusMix);
+		}
+		else
+		{
+			DesiredMixes.Remove(ControlBusMix);
+		}
+
+		MixWorldContextObject = WorldContextObject;
+		++NumRequestedMixChanges;
+	}
+}
+
+void UCrossfaderSubsystem::SubmitMixChanges()
+{
+	if (NumRequestedMixChanges == 0)
+	{
+		return;
+	}
+
+	const UObject* WorldContextObject = MixWorldContextObject.IsValid() ? MixWorldContextObject.Get() : World;
+	int32 NumSubmittedMixChanges = 0;
+
+	if (WorldContextObject)
+	{
+		// Deactivate mixes that are no longer desired
+		for (auto It = SubmittedMixes.CreateIterator(); It; ++It)
+		{
+			if (!DesiredMixes.Contains(*It))
+			{
+				if (*It)
+				{
+					if (!bStubModulation)
+					{
+						UAudioModulationStatics::DeactivateBusMix(WorldContextObject, *It);
+					}
 
-	// Create an Array
-	TArray<FString> ParsedArray;
+					++NumSubmittedMixChanges;
+				}
 
-	// Parse string out into Array using "." as delimter
-	GameplayTagString.ParseIntoArray(ParsedArray, TEXT("."), true);
+				It.RemoveCurrent();
+			}
+		}
 
-	// Return num of elements in parsed array
-	return ParsedArray.Num();
-}
\ No newline at end of file
+		// Activate mixes that are newly desired
+		for (USoundControlBusMix* DesiredMix : DesiredMixes)
+		{
+			if (DesiredMix && !SubmittedMixes.Contains(DesiredMix))
+			{
+				if (!bStubModulation)
+				{
+					UAudioModulationStatics::ActivateBusMix(WorldContextObject, DesiredMix);
+				}
+
+				SubmittedMixes.Add(DesiredMix);
+				++NumSubmittedMixChanges;
+			}
+		}
+	}
+
+	// Every request that didn't end up changing the modulation system was redundant
+	const int32 NumRedundantRequests = FMath::Max(NumRequestedMixChanges - NumSubmittedMixChanges, 0);
+	NumRedundantMixRequests += NumRedundantRequests;
+
+	INC_DWORD_STAT_BY(STAT_CrossfaderRedundantMixRequests, NumRedundantRequests);
+	SET_DWORD_STAT(STAT_CrossfaderSubmittedMixChanges, NumSubmittedMixChanges);
+
+	NumRequestedMixChanges = 0;
+}
+
+bool UCrossfaderSubsystem::IsMixStatePending(FGameplayTag MixState) const
+{
+	return DeferredMixStates.ContainsByPredicate([MixState](const FCrossfaderDeferredMixState& DeferredMixState)
+	{
+		return DeferredMixState.MixState.MatchesTagExact(MixState);
+	});
+}
+
+bool UCrossfaderSubsystem::IsMixStateActive(FGameplayTag MixState) const
+{
+	for (const TPair<FGameplayTag, FCrossfaderMixBusStatePair>& ActiveMix : ActiveMixes)
+	{
+		if (ActiveMix.Value.MixState.MatchesTagExact(MixState))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+uint32 UCrossfaderSubsystem::GameplayTagDepth(FGameplayTag GameplayTag)
+{
+	uint32 Depth = 0;
+
+	// Count the tag and each of its parents, walking the tag tree avoids building and parsing the tag string
+	for (FGameplayTag ParentTag = GameplayTag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+	{
+		++Depth;
+	}
+
+	return Depth;
+}
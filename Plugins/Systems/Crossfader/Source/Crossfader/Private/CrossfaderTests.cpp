@@ -0,0 +1,405 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CrossfaderSubsystem.h"
+#include "Crossfader.h"
+#include "MixStateBank.h"
+#include "SoundControlBusMix.h"
+#include "GameplayTagsManager.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Gives Crossfader automation tests access to Subsystem internals. */
+struct FCrossfaderTests
+{
+	static const TMap<FGameplayTag, FCrossfaderMixBusStatePair>& GetActiveMixes(const UCrossfaderSubsystem* Subsystem)
+	{
+		return Subsystem->ActiveMixes;
+	}
+
+	static const TSet<USoundControlBusMix*>& GetSubmittedMixes(const UCrossfaderSubsystem* Subsystem)
+	{
+		return Subsystem->SubmittedMixes;
+	}
+};
+
+namespace CrossfaderTests
+{
+	// Latency samples of one Crossfader call, in microseconds
+	struct FLatencySamples
+	{
+		const TCHAR* Name;
+		TArray<double> Samples;
+
+		void Log()
+		{
+			if (Samples.Num() == 0)
+			{
+				return;
+			}
+
+			Samples.Sort();
+
+			auto Percentile = [this](double InPercentile)
+			{
+				return Samples[FMath::Clamp(FMath::FloorToInt(InPercentile * Samples.Num()), 0, Samples.Num() - 1)];
+			};
+
+			UE_LOG(LogCrossfader, Display, TEXT("Crossfader Benchmark: %-14s Calls: %6d, p50: %8.2f us, p90: %8.2f us, p99: %8.2f us, Max: %8.2f us"),
+				Name, Samples.Num(), Percentile(0.5), Percentile(0.9), Percentile(0.99), Samples.Last());
+		}
+	};
+
+	// A standalone game instance with its subsystems initialized, shut down when it goes out of scope
+	struct FScopedTestGameInstance
+	{
+		UGameInstance* GameInstance = nullptr;
+		UWorld* World = nullptr;
+
+		FScopedTestGameInstance()
+		{
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone();
+
+			World = GameInstance->GetWorld();
+		}
+
+		~FScopedTestGameInstance()
+		{
+			GameInstance->Shutdown();
+			GameInstance->RemoveFromRoot();
+
+			if (World)
+			{
+				GEngine->DestroyWorldContext(World);
+				World->DestroyWorld(false);
+			}
+		}
+	};
+
+	// Registers Root.BankNN.GroupNN.StateNN tags, NumGroups x NumStatesPerGroup per bank, and rebuilds the tag tree
+	// without them when it goes out of scope. Root must not be used by any project tag
+	struct FScopedTestBankTags
+	{
+		TArray<TArray<FGameplayTag>> BankTags;
+
+		FScopedTestBankTags(const TCHAR* Root, int32 NumBanks, int32 NumGroups, int32 NumStatesPerGroup)
+		{
+			UDataTable* TagTable = NewObject<UDataTable>(GetTransientPackage());
+			TagTable->RowStruct = FGameplayTagTableRow::StaticStruct();
+
+			TArray<TArray<FName>> BankTagNames;
+
+			for (int32 BankIndex = 0; BankIndex < NumBanks; ++BankIndex)
+			{
+				TArray<FName>& TagNames = BankTagNames.AddDefaulted_GetRef();
+
+				for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+				{
+					for (int32 StateIndex = 0; StateIndex < NumStatesPerGroup; ++StateIndex)
+					{
+						const FName TagName = *FString::Printf(TEXT("%s.Bank%02d.Group%02d.State%02d"), Root, BankIndex, GroupIndex, StateIndex);
+						TagTable->AddRow(TagName, FGameplayTagTableRow(TagName));
+						TagNames.Add(TagName);
+					}
+				}
+			}
+
+			UGameplayTagsManager::Get().PopulateTreeFromDataTable(TagTable);
+
+			for (const TArray<FName>& TagNames : BankTagNames)
+			{
+				TArray<FGameplayTag>& Tags = BankTags.AddDefaulted_GetRef();
+
+				for (const FName& TagName : TagNames)
+				{
+					Tags.Add(FGameplayTag::RequestGameplayTag(TagName, false));
+				}
+			}
+		}
+
+		~FScopedTestBankTags()
+		{
+			// The transient table isn't one of the project's tag tables, so rebuilding the tree from those drops its tags
+			UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+#if WITH_EDITOR
+			TagsManager.EditorRefreshGameplayTagTree();
+#else
+			TagsManager.DestroyGameplayTagTree();
+			TagsManager.ConstructGameplayTagTree();
+#endif
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCrossfaderBenchmarkTest, "Crossfader.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCrossfaderBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace CrossfaderTests;
+
+	const int32 NumBanks = 50;
+	const int32 NumGroupsPerBank = 10;
+	const int32 NumStatesPerGroup = 20;
+	const int32 NumOperations = 10000;
+	const int32 Seed = 0;
+
+	const TCHAR* TestTagRoot = TEXT("CrossfaderTest");
+
+	if (FGameplayTag::RequestGameplayTag(TestTagRoot, false).IsValid())
+	{
+		AddError(FString::Printf(TEXT("%s is reserved for the tags the test generates, but the project already uses it."), TestTagRoot));
+		return false;
+	}
+
+	TOptional<FScopedTestBankTags> TestBankTags;
+	TestBankTags.Emplace(TestTagRoot, NumBanks, NumGroupsPerBank, NumStatesPerGroup);
+
+	const TArray<TArray<FGameplayTag>>& BankTags = TestBankTags->BankTags;
+
+	for (const TArray<FGameplayTag>& Tags : BankTags)
+	{
+		for (const FGameplayTag& Tag : Tags)
+		{
+			if (Tag.IsValid() == false)
+			{
+				AddError(TEXT("Generated MixState tags were not registered."));
+				return false;
+			}
+		}
+	}
+
+	FScopedTestGameInstance TestGameInstance;
+
+	UCrossfaderSubsystem* Subsystem = TestGameInstance.GameInstance->GetSubsystem<UCrossfaderSubsystem>();
+
+	if (TestNotNull(TEXT("Crossfader Subsystem is created with the game instance"), Subsystem) == false)
+	{
+		return false;
+	}
+
+	Subsystem->SetModulationStubbed(true);
+
+	// Every MixState gets its own resident mix, so the mix of each active MixState can be checked
+	TArray<UMixStateBank*> Banks;
+	TMap<FGameplayTag, USoundControlBusMix*> TagMixes;
+	TMap<FGameplayTag, int32> TagBanks;
+
+	for (int32 BankIndex = 0; BankIndex < NumBanks; ++BankIndex)
+	{
+		UMixStateBank* Bank = NewObject<UMixStateBank>(GetTransientPackage());
+		Bank->AddToRoot();
+
+		for (const FGameplayTag& Tag : BankTags[BankIndex])
+		{
+			USoundControlBusMix* Mix = NewObject<USoundControlBusMix>(Bank);
+
+			FCrossfaderMixPair& MixPair = Bank->MixStates.AddDefaulted_GetRef();
+			MixPair.MixState = Tag;
+			MixPair.ControlBusMix = FSoftObjectPath(Mix);
+
+			TagMixes.Add(Tag, Mix);
+			TagBanks.Add(Tag, BankIndex);
+		}
+
+		Banks.Add(Bank);
+	}
+
+	TArray<FGameplayTag> Tags;
+
+	for (const TArray<FGameplayTag>& BankTagList : BankTags)
+	{
+		Tags.Append(BankTagList);
+	}
+
+	TArray<bool> BanksAdded;
+	BanksAdded.Init(false, Banks.Num());
+
+	// Expected state: every tag is a leaf, so setting one replaces whatever was active in its group and clearing one
+	// clears its whole group. Removing a bank leaves its active MixStates active.
+	TMap<FGameplayTag, FGameplayTag> ExpectedActiveMixStates;
+
+	FString FirstFailure;
+	int32 NumFailures = 0;
+
+	auto RecordFailure = [&FirstFailure, &NumFailures](int32 OperationIndex, const FString& Failure)
+	{
+		if (NumFailures++ == 0)
+		{
+			FirstFailure = FString::Printf(TEXT("Operation %d: %s"), OperationIndex, *Failure);
+		}
+	};
+
+	auto ValidateActiveMixes = [&](int32 OperationIndex)
+	{
+		const TMap<FGameplayTag, FCrossfaderMixBusStatePair>& ActiveMixes = FCrossfaderTests::GetActiveMixes(Subsystem);
+
+		if (ActiveMixes.Num() != ExpectedActiveMixStates.Num())
+		{
+			RecordFailure(OperationIndex, FString::Printf(TEXT("%d active mixes, expected %d"), ActiveMixes.Num(), ExpectedActiveMixStates.Num()));
+			return;
+		}
+
+		for (const TPair<FGameplayTag, FCrossfaderMixBusStatePair>& ActiveMix : ActiveMixes)
+		{
+			const FGameplayTag* ExpectedMixState = ExpectedActiveMixStates.Find(ActiveMix.Key);
+
+			if (ExpectedMixState == nullptr || *ExpectedMixState != ActiveMix.Value.MixState)
+			{
+				RecordFailure(OperationIndex, FString::Printf(TEXT("%s is active in group %s, expected %s"), *ActiveMix.Value.MixState.ToString(), *ActiveMix.Key.ToString(), ExpectedMixState ? *ExpectedMixState->ToString() : TEXT("nothing")));
+				return;
+			}
+
+			if (ActiveMix.Value.ControlBusMix != TagMixes.FindRef(ActiveMix.Value.MixState))
+			{
+				RecordFailure(OperationIndex, FString::Printf(TEXT("%s is active with the wrong mix"), *ActiveMix.Value.MixState.ToString()));
+				return;
+			}
+		}
+	};
+
+	auto ValidateSubmittedMixes = [&](int32 OperationIndex)
+	{
+		const TSet<USoundControlBusMix*>& SubmittedMixes = FCrossfaderTests::GetSubmittedMixes(Subsystem);
+
+		if (SubmittedMixes.Num() != ExpectedActiveMixStates.Num())
+		{
+			RecordFailure(OperationIndex, FString::Printf(TEXT("%d submitted mixes, expected %d"), SubmittedMixes.Num(), ExpectedActiveMixStates.Num()));
+			return;
+		}
+
+		for (const TPair<FGameplayTag, FGameplayTag>& ExpectedActiveMixState : ExpectedActiveMixStates)
+		{
+			if (SubmittedMixes.Contains(TagMixes.FindRef(ExpectedActiveMixState.Value)) == false)
+			{
+				RecordFailure(OperationIndex, FString::Printf(TEXT("The mix of %s was not submitted"), *ExpectedActiveMixState.Value.ToString()));
+				return;
+			}
+		}
+	};
+
+	FLatencySamples SetMixStateLatency{ TEXT("SetMixState") };
+	FLatencySamples ClearMixStateLatency{ TEXT("ClearMixState") };
+	FLatencySamples AddBankLatency{ TEXT("AddBank") };
+	FLatencySamples RemoveBankLatency{ TEXT("RemoveBank") };
+	FLatencySamples SubmitLatency{ TEXT("SubmitChanges") };
+
+	auto TimeCall = [](FLatencySamples& Latency, TFunctionRef<void()> Call)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Call();
+		Latency.Samples.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+	};
+
+	// Start with every bank in the master bank
+	for (int32 BankIndex = 0; BankIndex < Banks.Num(); ++BankIndex)
+	{
+		TimeCall(AddBankLatency, [&]() { Subsystem->AddBank(Banks[BankIndex]); });
+		BanksAdded[BankIndex] = true;
+	}
+
+	FRandomStream RandomStream(Seed);
+
+	for (int32 OperationIndex = 0; OperationIndex < NumOperations; ++OperationIndex)
+	{
+		const FGameplayTag Tag = Tags[RandomStream.RandRange(0, Tags.Num() - 1)];
+		const float Operation = RandomStream.FRand();
+
+		if (Operation < 0.45f)
+		{
+			bool bMixStateSet = false;
+			TimeCall(SetMixStateLatency, [&]() { bMixStateSet = Subsystem->SetMixState(Subsystem, Tag, false, true); });
+
+			const bool bBankAdded = BanksAdded[TagBanks.FindChecked(Tag)];
+
+			if (bBankAdded)
+			{
+				ExpectedActiveMixStates.Add(Tag.RequestDirectParent(), Tag);
+			}
+
+			// Banks are resident here, nothing should wait on a mix to load
+			if (bMixStateSet != bBankAdded || Subsystem->IsMixStatePending(Tag))
+			{
+				RecordFailure(OperationIndex, FString::Printf(TEXT("Setting %s returned %s, pending %s"), *Tag.ToString(), bMixStateSet ? TEXT("true") : TEXT("false"), Subsystem->IsMixStatePending(Tag) ? TEXT("true") : TEXT("false")));
+			}
+		}
+		else if (Operation < 0.8f)
+		{
+			TimeCall(ClearMixStateLatency, [&]() { Subsystem->ClearMixState(Subsystem, Tag, true); });
+
+			ExpectedActiveMixStates.Remove(Tag.RequestDirectParent());
+		}
+		else
+		{
+			const int32 BankIndex = RandomStream.RandRange(0, Banks.Num() - 1);
+
+			if (BanksAdded[BankIndex])
+			{
+				TimeCall(RemoveBankLatency, [&]() { Subsystem->RemoveBank(Banks[BankIndex]); });
+			}
+			else
+			{
+				TimeCall(AddBankLatency, [&]() { Subsystem->AddBank(Banks[BankIndex]); });
+			}
+
+			BanksAdded[BankIndex] = !BanksAdded[BankIndex];
+		}
+
+		ValidateActiveMixes(OperationIndex);
+
+		// Simulate a frame boundary every few calls
+		if (OperationIndex % 8 == 7)
+		{
+			TimeCall(SubmitLatency, [&]() { Subsystem->SubmitMixChanges(); });
+
+			ValidateSubmittedMixes(OperationIndex);
+		}
+	}
+
+	TimeCall(SubmitLatency, [&]() { Subsystem->SubmitMixChanges(); });
+
+	ValidateSubmittedMixes(NumOperations);
+
+	TestEqual(TEXT("Active and submitted mixes match the expected MixStates after every operation"), NumFailures, 0);
+
+	if (NumFailures > 0)
+	{
+		AddError(FString::Printf(TEXT("First failure: %s"), *FirstFailure));
+	}
+
+	UE_LOG(LogCrossfader, Display, TEXT("Crossfader Benchmark: %d banks x %d MixStates, %d operations, Redundant Requests: %d, Active Mixes: %d"),
+		NumBanks, NumGroupsPerBank * NumStatesPerGroup, NumOperations, Subsystem->GetNumRedundantMixRequests(), Subsystem->GetNumSubmittedMixes());
+
+	SetMixStateLatency.Log();
+	ClearMixStateLatency.Log();
+	AddBankLatency.Log();
+	RemoveBankLatency.Log();
+	SubmitLatency.Log();
+
+	// Release the synthetic data
+	for (int32 BankIndex = 0; BankIndex < Banks.Num(); ++BankIndex)
+	{
+		if (BanksAdded[BankIndex])
+		{
+			Subsystem->RemoveBank(Banks[BankIndex]);
+		}
+
+		Banks[BankIndex]->RemoveFromRoot();
+	}
+
+	TestBankTags.Reset();
+
+	TestFalse(TEXT("Generated MixState tags are unregistered"), FGameplayTag::RequestGameplayTag(TestTagRoot, false).IsValid());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -7,6 +7,7 @@
 #include "Engine/DeveloperSettings.h"
 #include "MixStateBank.h"
 #include "Containers/Map.h"
+#include "Engine/StreamableManager.h"
 #include "CrossfaderSubsystem.generated.h"
 
 class USoundControlBusMix;
@@ -72,6 +73,17 @@ struct CROSSFADER_API FCrossfaderMixBusStatePair
 	}
 };
 
+/** 
+* A MixState request whose ControlBusMix was not resident yet. It is replayed once the bank's mixes finish loading.
+*/
+struct FCrossfaderDeferredMixState
+{
+	TWeakObjectPtr<const UObject> WorldContextObject;
+	FGameplayTag MixState;
+	bool bFallBackToNearestParent = false;
+	bool bDeactivateChildren = true;
+};
+
 /**
  * CrossfaderSubsystem is the high-level manager that filters GameplayTag MixStates and activates/deactivates associated SoundControlBusMixes.
  */
@@ -101,6 +113,69 @@ private:
 	// Flag indicating default mixes have been activated (only need to activate on first world)
 	bool bDefaultMixesActivated = false;
 
+	// Streams banks and the ControlBusMixes they reference
+	FStreamableManager StreamableManager;
+
+	// Handle keeping the settings' banks loading
+	TSharedPtr<FStreamableHandle> SettingsBanksHandle;
+
+	// Handle keeping the User and Base Project mixes loading
+	TSharedPtr<FStreamableHandle> DefaultMixesHandle;
+
+	// Handles keeping each bank's ControlBusMixes resident, keyed by bank path
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> BankMixHandles;
+
+	// MixState requests waiting for their ControlBusMix to load
+	TArray<FCrossfaderDeferredMixState> DeferredMixStates;
+
+	// Total number of MixState activations that had to wait on a load
+	int32 NumDeferredActivations = 0;
+
+	// Set while deferred MixStates are replayed, so they are not counted twice
+	bool bReplayingDeferredMixStates = false;
+
+	// Called when the settings' banks finish loading
+	void OnSettingsBanksLoaded();
+
+	// Called when the default mixes finish loading
+	void OnDefaultMixesLoaded();
+
+	// Called when a bank's ControlBusMixes finish loading, replays deferred MixStates
+	void OnBankMixesLoaded();
+
+	// Returns true if a bank is still streaming in this ControlBusMix
+	bool IsBankMixLoading(const FSoftObjectPath& ControlBusMixPath) const;
+
+	// Forget deferred requests superseded by a request for this MixState: the same MixState, its siblings, and when
+	// deactivating children everything beneath its parent
+	void RemoveSupersededDeferredMixStates(FGameplayTag MixState, bool bDeactivateChildren);
+
+	// Mixes that should be active once this frame's requests are applied
+	UPROPERTY()
+	TSet<USoundControlBusMix*> DesiredMixes;
+
+	// Mixes that have been activated on the modulation system
+	UPROPERTY()
+	TSet<USoundControlBusMix*> SubmittedMixes;
+
+	// World context used to submit the coalesced activations
+	TWeakObjectPtr<const UObject> MixWorldContextObject;
+
+	// Number of activate/deactivate requests made since the last submission
+	int32 NumRequestedMixChanges = 0;
+
+	// Total number of requests that cancelled out before being submitted
+	int32 NumRedundantMixRequests = 0;
+
+	// Handle for the end of frame submission
+	FDelegateHandle EndFrameHandle;
+
+	// Request a ControlBusMix be activated or deactivated, requests are coalesced and submitted at the end of the frame
+	void QueueBusMixActivation(const UObject* WorldContextObject, USoundControlBusMix* ControlBusMix, bool bActivate);
+
+	// When true, mix changes are tracked but never sent to the modulation system
+	bool bStubModulation = false;
+
 public:
 	// Crossfader Subsystem API
 
@@ -130,11 +205,20 @@ public:
 	* up until a match is found or there are no more namespaces.
 	* @param bDeactivateChildren When set to true, as the state is set, that state's parent namespace and all children beneath it will
 	* be deactivated (not just siblings).
-	* @return Will return true if a MixState was set, otherwise it will return false if no matching MixState was found.
+	* @return Will return true if a MixState was set or is pending, otherwise it will return false if no matching MixState was found.
+	* A MixState is pending while its ControlBusMix is still loading (see IsMixStatePending). It is set once its mix arrives, unless
+	* a newer request for the same MixState group is set or cleared first.
 	*/
 	UFUNCTION(BlueprintCallable, Category = Crossfader, meta = (WorldContext = "WorldContextObject", Categories = "Crossfader"))
 	bool SetMixState(const UObject* WorldContextObject, FGameplayTag MixState, bool bFallBackToNearestParent = false, bool bDeactivateChildren = true);
 
+	/** 
+	* Returns true if a request for this exact MixState is waiting on its ControlBusMix to finish loading.
+	* @param MixState The MixState that was passed to SetMixState.
+	*/
+	UFUNCTION(BlueprintPure, Category = Crossfader, meta = (Categories = "Crossfader"))
+	bool IsMixStatePending(FGameplayTag MixState) const;
+
 	/** Clear an active Mix State.
 	* This function will look for a specific MixState and clear it. If it cannot find it, then there was no need to clear the state.
 	* @param MixState The MixState to clear.
@@ -144,15 +228,49 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Crossfader, meta = (WorldContext = "WorldContextObject", Categories = "Crossfader"))
 	void ClearMixState(const UObject* WorldContextObject, FGameplayTag MixState, bool bDeactivateChildren = true);
 
+	/** Returns how many mix activation requests were dropped because they cancelled out within a frame. */
+	UFUNCTION(BlueprintCallable, Category = Crossfader)
+	int32 GetNumRedundantMixRequests() const { return NumRedundantMixRequests; }
+
+	/** Returns how many MixState activations were deferred until their ControlBusMix finished loading. */
+	UFUNCTION(BlueprintCallable, Category = Crossfader)
+	int32 GetNumDeferredActivations() const { return NumDeferredActivations; }
+
+	/** Submit the difference between the desired and active mixes to the modulation system now, rather than at the end of the frame. */
+	void SubmitMixChanges();
+
+	/** Returns true if the MixState is currently set. */
+	bool IsMixStateActive(FGameplayTag MixState) const;
+
+	/** Returns how many mixes are currently active on the modulation system. */
+	int32 GetNumSubmittedMixes() const { return SubmittedMixes.Num(); }
+
+	/** 
+	* Track mix changes without sending them to the modulation system. Used to benchmark state resolution
+	* where AudioModulation isn't running.
+	*/
+	void SetModulationStubbed(bool bInStubModulation) { bStubModulation = bInStubModulation; }
+
 private:
 	/** The master list of bank data is stored as F Objects only (FSoftObjectPaths and FGameplayTags), no UObjects are stored in this list. */
 	TMap<FSoftObjectPath, TArray<FCrossfaderMixPair>> MasterMixStateBank;
 
+	/** 
+	* Flattened lookup of every MixState in the master bank to its ControlBusMix, rebuilt whenever banks are added or removed.
+	* When several banks define the same MixState, the first bank in the master bank wins.
+	*/
+	TMap<FGameplayTag, FSoftObjectPath> MixStateIndex;
+
+	// Rebuild the MixStateIndex from the master bank
+	void RebuildMixStateIndex();
+
 	/** A Map of Active Mixes, the Mix State Parent (x.y) is used as a key to a struct containing both the Active State (x.y.z or x.y) and a Control Bus Mix. */
 	UPROPERTY()
 	TMap<FGameplayTag, FCrossfaderMixBusStatePair> ActiveMixes;
 
 	// Helper funcction to determine how many tags are in the GameplayTag (e.g. x.y will return 2, x.y.z will return 3, etc.)
-	uint32 GameplayTagDepth(FGameplayTag GameplayTag);
+	static uint32 GameplayTagDepth(FGameplayTag GameplayTag);
+
+	friend struct FCrossfaderTests;
 
 };
@@ -1,6 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Soundscape.h"
+#include "SoundscapeSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 
 bool USoundscapeBPFunctionLibrary::SpawnSoundscapeColor(UObject* WorldContextObject, class USoundscapeColor* SoundscapeColorIn, UActiveSoundscapeColor*& ActiveSoundscapeColor)
 {
@@ -13,6 +16,21 @@ bool USoundscapeBPFunctionLibrary::SpawnSoundscapeColor(UObject* WorldContextObj
 		// Initialize parameters
 		ActiveSoundscapeColor->SetParameterValues(SoundscapeColorIn);
 
+		// Seed spawn decisions from the color asset
+		ActiveSoundscapeColor->SetSeedHash(GetTypeHash(SoundscapeColorIn->GetPathName()));
+
+		UWorld* World = WorldContextObject->GetWorld();
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+
+		if (USoundscapeSubsystem* SoundscapeSubsystem = GameInstance ? GameInstance->GetSubsystem<USoundscapeSubsystem>() : nullptr)
+		{
+			SoundscapeSubsystem->SeedColor(ActiveSoundscapeColor);
+		}
+		else
+		{
+			ActiveSoundscapeColor->SetRandomSeed(FMath::Rand());
+		}
+
 #if WITH_EDITOR
 		// Bind to delegate for live update from the SoundscapeColor Editor
 		ActiveSoundscapeColor->BindToParameterChangeDelegate(SoundscapeColorIn);
@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SoundscapeModule.h"
+#include "SoundscapeScheduler.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "TimerManager.h"
+
+namespace SoundscapeBenchmark
+{
+	/**
+	* Drives the same synthetic color update pattern through a standalone FTimerManager (one timer per color, re-armed
+	* from its own callback, as Active Soundscape Colors used to) and through the Soundscape Color Scheduler, one real frame at a time.
+	* Every frame one palette worth of colors is paused and another resumed, to compare per-timer pausing with group pausing.
+	* This only measures cost, scheduler behaviour is covered by the Soundscape.Scheduler automation test.
+	*/
+	struct FSchedulerBenchmark
+	{
+		int32 NumColors = 1000;
+		int32 ColorsPerPalette = 16;
+		int32 NumFrames = 600;
+		float MinDelay = 0.05f;
+		float MaxDelay = 0.5f;
+
+		FRandomStream RandomStream;
+
+		FTimerManager TimerManager;
+		TArray<FTimerHandle> TimerHandles;
+		TArray<FTimerDelegate> TimerDelegates;
+
+		FSoundscapeColorScheduler Scheduler;
+		TArray<FSoundscapeScheduleHandle> ScheduleHandles;
+		TArray<FSoundscapeScheduleHandle> DueHandles;
+		TArray<int32> Groups;
+
+		int32 FramesRun = 0;
+		int32 PausedPalette = INDEX_NONE;
+		int32 TimerUpdates = 0;
+		int32 SchedulerUpdates = 0;
+		double TimerSeconds = 0.0;
+		double SchedulerSeconds = 0.0;
+
+		int32 GetNumPalettes() const { return FMath::DivideAndRoundUp(NumColors, ColorsPerPalette); }
+
+		float GetRandomDelay() { return RandomStream.FRandRange(MinDelay, MaxDelay); }
+
+		void Start()
+		{
+			TimerHandles.SetNum(NumColors);
+			TimerDelegates.SetNum(NumColors);
+			ScheduleHandles.SetNum(NumColors);
+
+			for (int32 PaletteIndex = 0; PaletteIndex < GetNumPalettes(); ++PaletteIndex)
+			{
+				Groups.Add(Scheduler.CreateGroup());
+			}
+
+			for (int32 ColorIndex = 0; ColorIndex < NumColors; ++ColorIndex)
+			{
+				// Timer path re-arms itself from the callback like UpdateSoundscapeColor did
+				TimerDelegates[ColorIndex] = FTimerDelegate::CreateLambda([this, ColorIndex]()
+				{
+					++TimerUpdates;
+					TimerManager.SetTimer(TimerHandles[ColorIndex], TimerDelegates[ColorIndex], GetRandomDelay(), false);
+				});
+
+				TimerManager.SetTimer(TimerHandles[ColorIndex], TimerDelegates[ColorIndex], GetRandomDelay(), false);
+
+				ScheduleHandles[ColorIndex] = Scheduler.Register(nullptr, Groups[ColorIndex / ColorsPerPalette]);
+				Scheduler.Schedule(ScheduleHandles[ColorIndex], GetRandomDelay());
+			}
+		}
+
+		void Stop()
+		{
+			for (FTimerHandle& TimerHandle : TimerHandles)
+			{
+				TimerManager.ClearTimer(TimerHandle);
+			}
+
+			Scheduler.Reset();
+
+			UE_LOG(LogSoundscape, Display, TEXT("Soundscape Scheduler Benchmark: %d colors in %d palettes over %d frames"), NumColors, GetNumPalettes(), FramesRun);
+			UE_LOG(LogSoundscape, Display, TEXT("Soundscape Scheduler Benchmark: Timer Manager: %8.3f ms total, %6.3f us/frame, %d updates"),
+				TimerSeconds * 1000.0, TimerSeconds * 1000000.0 / FMath::Max(FramesRun, 1), TimerUpdates);
+			UE_LOG(LogSoundscape, Display, TEXT("Soundscape Scheduler Benchmark: Scheduler:     %8.3f ms total, %6.3f us/frame, %d updates"),
+				SchedulerSeconds * 1000.0, SchedulerSeconds * 1000000.0 / FMath::Max(FramesRun, 1), SchedulerUpdates);
+		}
+
+		// Returns false once every frame has been run
+		bool TickFrame(float DeltaTime)
+		{
+			const int32 PaletteToResume = PausedPalette;
+			const int32 PaletteToPause = RandomStream.RandRange(0, GetNumPalettes() - 1);
+			PausedPalette = PaletteToPause;
+
+			// Timer Manager: pausing a palette touches every timer in it
+			uint64 StartCycles = FPlatformTime::Cycles64();
+
+			for (int32 ColorIndex = 0; ColorIndex < NumColors; ++ColorIndex)
+			{
+				const int32 PaletteIndex = ColorIndex / ColorsPerPalette;
+
+				if (PaletteIndex == PaletteToResume)
+				{
+					TimerManager.UnPauseTimer(TimerHandles[ColorIndex]);
+				}
+
+				if (PaletteIndex == PaletteToPause)
+				{
+					TimerManager.PauseTimer(TimerHandles[ColorIndex]);
+				}
+			}
+
+			TimerManager.Tick(DeltaTime);
+			TimerSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+			// Scheduler: pausing a palette flips its group
+			StartCycles = FPlatformTime::Cycles64();
+
+			if (Groups.IsValidIndex(PaletteToResume))
+			{
+				Scheduler.ResumeGroup(Groups[PaletteToResume]);
+			}
+
+			Scheduler.PauseGroup(Groups[PaletteToPause]);
+
+			DueHandles.Reset();
+			Scheduler.Advance(DeltaTime, DueHandles);
+
+			for (const FSoundscapeScheduleHandle& DueHandle : DueHandles)
+			{
+				Scheduler.Schedule(DueHandle, GetRandomDelay());
+			}
+
+			SchedulerUpdates += DueHandles.Num();
+			SchedulerSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+			return ++FramesRun < NumFrames;
+		}
+	};
+
+	static FAutoConsoleCommand SchedulerBenchmarkCommand(
+		TEXT("Soundscape.Benchmark.Scheduler"),
+		TEXT("Compare per-color timers against the Soundscape Color Scheduler over real frames. Usage: Soundscape.Benchmark.Scheduler [NumColors] [NumFrames] [Seed]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			TSharedRef<FSchedulerBenchmark> Benchmark = MakeShared<FSchedulerBenchmark>();
+			Benchmark->NumColors = FMath::Max(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000, 1);
+			Benchmark->NumFrames = FMath::Max(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 600, 1);
+			Benchmark->RandomStream.Initialize(Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 0);
+
+			Benchmark->Start();
+
+			// The Timer Manager only ticks once per engine frame, so the benchmark runs on the core ticker
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Benchmark](float DeltaTime)
+			{
+				if (Benchmark->TickFrame(DeltaTime))
+				{
+					return true;
+				}
+
+				Benchmark->Stop();
+				return false;
+			}));
+		}));
+}
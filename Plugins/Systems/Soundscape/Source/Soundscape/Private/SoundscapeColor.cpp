@@ -5,9 +5,10 @@
 #include "UObject/WeakObjectPtr.h"
 #include "Components/AudioComponent.h"
 #include "AudioDevice.h"
-#include "TimerManager.h"
 #include "DrawDebugHelpers.h"
 #include "SoundscapeSubsystem.h"
+#include "SoundscapePalette.h"
+#include "Sound/SoundBase.h"
 
 USoundscapeColor::USoundscapeColor()
 	: VolumeBase(1.0f)
@@ -35,31 +36,12 @@ void USoundscapeColor::PostEditChangeProperty(FPropertyChangedEvent& PropertyCha
 }
 #endif
 
-void UActiveSoundscapeColorVoice::BeginDestroy()
-{
-	if (UWorld* World = GetWorld())
-	{
-		// Clear out all timers
-		World->GetTimerManager().ClearTimer(TimerHandle);
-	}
-
-	Super::BeginDestroy();
-}
-
-void UActiveSoundscapeColorVoice::StopLimitedDurationVoice(float FadeOutTime)
-{
-	if (AudioComponent)
-	{
-		AudioComponent->FadeOut(FadeOutTime, 0.0f);
-	}
-}
-
 void UActiveSoundscapeColor::BeginDestroy()
 {
-	if (UWorld* World = GetWorld())
+	if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
 	{
-		// Clear out all timers
-		World->GetTimerManager().ClearTimer(UpdateTimer);
+		// Release the scheduler slot
+		Subsystem->GetColorScheduler().Unregister(ScheduleHandle);
 	}
 
 	Super::BeginDestroy();
@@ -161,163 +143,522 @@ bool UActiveSoundscapeColor::IsPlaying()
 	return bIsPlaying;
 }
 
-void UActiveSoundscapeColor::UpdateSoundscapeColor()
+int32 UActiveSoundscapeColor::UpdateSoundscapeColor()
 {
+	int32 NumVoicesStarted = 0;
+
 	if (bIsPlaying)
 	{
-		Update();
+		FSoundscapeColorScheduler* Scheduler = GetScheduler();
+		const double Time = Scheduler ? Scheduler->GetTime() : NextSpawnTime;
+
+		// Retire limited duration voices in one batch
+		ExpireVoices(Time);
+
+		if (Time >= NextVirtualVoiceUpdateTime)
+		{
+			NumVoicesStarted += UpdateVirtualVoices(Time);
+		}
+
+		// The update may have been scheduled for a voice expiry only
+		if (Time >= NextSpawnTime)
+		{
+			NumVoicesStarted += Update(Time);
+		}
+
+		ScheduleNextUpdate();
+	}
+
+	return NumVoicesStarted;
+}
+
+void UActiveSoundscapeColor::SetRandomSeed(int32 Seed)
+{
+	RandomStream.Initialize(Seed);
+}
+
+int32 UActiveSoundscapeColor::GetRandomSeed() const
+{
+	return RandomStream.GetInitialSeed();
+}
+
+void UActiveSoundscapeColor::SetOwningPalette(UActiveSoundscapePalette* InOwningPalette)
+{
+	OwningPalette = InOwningPalette;
+}
+
+void UActiveSoundscapeColor::SetSchedulerGroup(int32 InSchedulerGroup)
+{
+	SchedulerGroup = InSchedulerGroup;
+
+	if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
+	{
+		Subsystem->GetColorScheduler().SetGroup(ScheduleHandle, SchedulerGroup);
+	}
+}
+
+FSoundscapeColorScheduler* UActiveSoundscapeColor::GetScheduler()
+{
+	if (SoundscapeSubsystem.IsValid() == false)
+	{
+		// A handle from a previous Subsystem means nothing to a new one
+		ScheduleHandle.Invalidate();
+		SoundscapeSubsystem.Reset();
+
+		if (UWorld* World = GetWorld())
+		{
+			if (UGameInstance* GameInstance = World->GetGameInstance())
+			{
+				SoundscapeSubsystem = GameInstance->GetSubsystem<USoundscapeSubsystem>();
+			}
+		}
+	}
+
+	if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
+	{
+		FSoundscapeColorScheduler& Scheduler = Subsystem->GetColorScheduler();
+
+		if (ScheduleHandle.IsValid() == false)
+		{
+			ScheduleHandle = Scheduler.Register(this, SchedulerGroup);
+		}
+
+		return &Scheduler;
+	}
+
+	return nullptr;
+}
+
+void UActiveSoundscapeColor::ScheduleNextUpdate()
+{
+	if (FSoundscapeColorScheduler* Scheduler = GetScheduler())
+	{
+		const double NextUpdateTime = FMath::Min3(NextSpawnTime, NextVoiceExpiryTime, NextVirtualVoiceUpdateTime);
+
+		if (NextUpdateTime < TNumericLimits<double>::Max())
+		{
+			Scheduler->ScheduleAt(ScheduleHandle, NextUpdateTime);
+		}
+		else
+		{
+			// Nothing left to spawn or expire
+			Scheduler->Cancel(ScheduleHandle);
+		}
+	}
+}
+
+int32 UActiveSoundscapeColor::AcquireVoice(UWorld* World)
+{
+	int32 VoiceIndex = INDEX_NONE;
+
+	if (FreeVoices.Num())
+	{
+		VoiceIndex = FreeVoices.Pop(false);
+	}
+	else
+	{
+		// Grow the voice table
+		UAudioComponent* NewAudioComponent = NewObject<UAudioComponent>(World);
+		NewAudioComponent->bAutoDestroy = false;
+
+		VoiceIndex = VoiceAudioComponents.Add(NewAudioComponent);
+		VoiceStates.Add(ESoundscapeColorVoiceState::Free);
+		VoiceExpiryTimes.Add(TNumericLimits<double>::Max());
+		VoiceFadeOutTimes.Add(0.0f);
+		VoiceLocations.Add(FVector::ZeroVector);
+
+		// Free the voice as soon as its playback finishes instead of polling the play state
+		NewAudioComponent->OnAudioFinishedNative.AddUObject(this, &UActiveSoundscapeColor::OnVoiceFinished, VoiceIndex);
+	}
+
+	VoiceStates[VoiceIndex] = ESoundscapeColorVoiceState::Playing;
+	VoiceExpiryTimes[VoiceIndex] = TNumericLimits<double>::Max();
+	++NumActiveVoices;
+
+	if (UActiveSoundscapePalette* Palette = OwningPalette.Get())
+	{
+		Palette->AddActiveVoice();
+	}
+
+	return VoiceIndex;
+}
+
+int32 UActiveSoundscapeColor::StartVoice(UWorld* World, double Time, const FSoundscapeColorVoiceParams& Params)
+{
+	// Take a voice from the free-list
+	const int32 VoiceIndex = AcquireVoice(World);
+
+	// Cache Audio Component ptr
+	UAudioComponent* NewAudioComponent = VoiceAudioComponents[VoiceIndex];
+	VoiceLocations[VoiceIndex] = Params.Location;
+
+	// Set World location of Audio Component
+	NewAudioComponent->SetWorldLocationAndRotation(Params.Location, Params.Rotation);
+
+	// Set relevant Audio Component values before playing
+	NewAudioComponent->SetPitchMultiplier(Params.Pitch);
+	NewAudioComponent->SetSound(Sound);
+
+	// Play the sound
+	NewAudioComponent->FadeIn(Params.FadeIn, Params.Volume, Params.StartTime);
+
+	// A sound that failed to start will never report finishing, return its voice right away
+	if (NewAudioComponent->IsPlaying() == false)
+	{
+		ReleaseVoice(VoiceIndex);
+	}
+	else if (Params.LimitedDuration > 0.0f)
+	{
+		// Expired in batch by ExpireVoices
+		VoiceExpiryTimes[VoiceIndex] = Time + Params.LimitedDuration;
+		VoiceFadeOutTimes[VoiceIndex] = Params.FadeOutTime;
+		LimitedDurationVoices.Add(VoiceIndex);
+
+		NextVoiceExpiryTime = FMath::Min(NextVoiceExpiryTime, VoiceExpiryTimes[VoiceIndex]);
+	}
+
+	return VoiceIndex;
+}
+
+bool UActiveSoundscapeColor::IsAudible(const FSoundscapeColorVoiceParams& Params) const
+{
+	if (Params.Volume <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	const FSoundAttenuationSettings* AttenuationSettings = Sound ? Sound->GetAttenuationSettingsToApply() : nullptr;
+
+	if (AttenuationSettings == nullptr || AttenuationSettings->bAttenuate == false)
+	{
+		// Unattenuated sounds are heard everywhere
+		return true;
+	}
+
+	const USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get();
+
+	if (Subsystem == nullptr || Subsystem->GetListeners().Num() == 0)
+	{
+		// Nothing to test against
+		return true;
+	}
+
+	const float MaxDistanceSquared = FMath::Square(AttenuationSettings->GetMaxDimension());
+
+	for (const FSoundscapeListener& Listener : Subsystem->GetListeners())
+	{
+		if (FVector::DistSquared(Listener.Location, Params.Location) <= MaxDistanceSquared)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UActiveSoundscapeColor::HasPaletteVoiceBudget() const
+{
+	const UActiveSoundscapePalette* Palette = OwningPalette.Get();
+	return Palette == nullptr || Palette->HasVoiceBudget();
+}
+
+void UActiveSoundscapeColor::VirtualizeVoice(double Time, const FSoundscapeColorVoiceParams& Params)
+{
+	FSoundscapeColorVirtualVoice& VirtualVoice = VirtualVoices.AddDefaulted_GetRef();
+	VirtualVoice.Params = Params;
+	VirtualVoice.SpawnTime = Time;
+
+	// Work out when the voice would have finished, looping voices only end with a limited duration or when the color stops
+	if (Params.LimitedDuration > 0.0f)
+	{
+		VirtualVoice.EndTime = Time + Params.LimitedDuration;
+	}
+	else if (Sound && Sound->IsLooping() == false && Sound->Duration < INDEFINITELY_LOOPING_DURATION)
+	{
+		VirtualVoice.EndTime = Time + FMath::Max(Sound->Duration - Params.StartTime, 0.0f) / FMath::Max(Params.Pitch, 0.0001f);
+	}
+	else
+	{
+		VirtualVoice.EndTime = TNumericLimits<double>::Max();
+	}
+
+	if (NextVirtualVoiceUpdateTime == TNumericLimits<double>::Max())
+	{
+		const USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get();
+		NextVirtualVoiceUpdateTime = Time + (Subsystem ? Subsystem->GetVirtualVoiceUpdateInterval() : 0.5f);
 	}
 }
 
+int32 UActiveSoundscapeColor::UpdateVirtualVoices(double Time)
+{
+	UWorld* World = GetWorld();
+	int32 NumVoicesResumed = 0;
+
+	for (int32 Index = VirtualVoices.Num() - 1; Index >= 0; --Index)
+	{
+		FSoundscapeColorVirtualVoice& VirtualVoice = VirtualVoices[Index];
+
+		if (VirtualVoice.EndTime <= Time)
+		{
+			// Would have finished by now
+			VirtualVoices.RemoveAtSwap(Index, 1, false);
+		}
+		else if (World && Sound && IsAudible(VirtualVoice.Params) && HasPaletteVoiceBudget())
+		{
+			// Resume where the voice would be on its virtual timeline
+			FSoundscapeColorVoiceParams ResumeParams = VirtualVoice.Params;
+			const float Elapsed = static_cast<float>(Time - VirtualVoice.SpawnTime);
+
+			if (Sound->Duration < INDEFINITELY_LOOPING_DURATION)
+			{
+				ResumeParams.StartTime += Elapsed * ResumeParams.Pitch;
+
+				if (Sound->IsLooping() && Sound->Duration > 0.0f)
+				{
+					ResumeParams.StartTime = FMath::Fmod(ResumeParams.StartTime, Sound->Duration);
+				}
+			}
+
+			if (ResumeParams.LimitedDuration > 0.0f)
+			{
+				ResumeParams.LimitedDuration = FMath::Max(ResumeParams.LimitedDuration - Elapsed, 0.0001f);
+			}
+
+			StartVoice(World, Time, ResumeParams);
+			++NumVoicesResumed;
+
+			VirtualVoices.RemoveAtSwap(Index, 1, false);
+		}
+	}
+
+	if (VirtualVoices.Num())
+	{
+		const USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get();
+		NextVirtualVoiceUpdateTime = Time + (Subsystem ? Subsystem->GetVirtualVoiceUpdateInterval() : 0.5f);
+	}
+	else
+	{
+		NextVirtualVoiceUpdateTime = TNumericLimits<double>::Max();
+	}
+
+	return NumVoicesResumed;
+}
+
+void UActiveSoundscapeColor::ReleaseVoice(int32 VoiceIndex)
+{
+	if (VoiceStates.IsValidIndex(VoiceIndex) && IsVoiceActive(VoiceIndex))
+	{
+		VoiceStates[VoiceIndex] = ESoundscapeColorVoiceState::Free;
+		VoiceExpiryTimes[VoiceIndex] = TNumericLimits<double>::Max();
+		FreeVoices.Add(VoiceIndex);
+		--NumActiveVoices;
+
+		if (UActiveSoundscapePalette* Palette = OwningPalette.Get())
+		{
+			Palette->RemoveActiveVoice();
+		}
+	}
+}
+
+void UActiveSoundscapeColor::ExpireVoices(double Time)
+{
+	if (Time < NextVoiceExpiryTime)
+	{
+		// Nothing due yet
+		return;
+	}
+
+	NextVoiceExpiryTime = TNumericLimits<double>::Max();
+
+	for (int32 Index = LimitedDurationVoices.Num() - 1; Index >= 0; --Index)
+	{
+		const int32 VoiceIndex = LimitedDurationVoices[Index];
+
+		if (VoiceStates[VoiceIndex] != ESoundscapeColorVoiceState::Playing)
+		{
+			// Finished or stopped before its limit
+			LimitedDurationVoices.RemoveAtSwap(Index, 1, false);
+		}
+		else if (VoiceExpiryTimes[VoiceIndex] <= Time)
+		{
+			if (UAudioComponent* VoiceAudioComponent = VoiceAudioComponents[VoiceIndex])
+			{
+				VoiceAudioComponent->FadeOut(VoiceFadeOutTimes[VoiceIndex], 0.0f);
+			}
+
+			VoiceStates[VoiceIndex] = ESoundscapeColorVoiceState::Stopping;
+			LimitedDurationVoices.RemoveAtSwap(Index, 1, false);
+		}
+		else
+		{
+			NextVoiceExpiryTime = FMath::Min(NextVoiceExpiryTime, VoiceExpiryTimes[VoiceIndex]);
+		}
+	}
+}
+
+void UActiveSoundscapeColor::OnVoiceFinished(UAudioComponent* AudioComponent, int32 VoiceIndex)
+{
+	ReleaseVoice(VoiceIndex);
+}
+
 void UActiveSoundscapeColor::StartPlaying()
 {
 	// Update state
 	bIsPlaying = true;
 	bFirstSpawn = true;
 
-	// Set up for first Timer delay
+	// Set up for first spawn delay
 	float FirstDelayTime = 0.0001f;
 
 	if (SpawnBehavior.bDelayFirstSpawn)
 	{
 		// If we delay the first spawn, then 
-		FirstDelayTime = FMath::FRandRange(SpawnBehavior.MinFirstSpawnDelay, SpawnBehavior.MaxFirstSpawnDelay);
+		FirstDelayTime = RandomStream.FRandRange(SpawnBehavior.MinFirstSpawnDelay, SpawnBehavior.MaxFirstSpawnDelay);
 	}
-	
-	if (UWorld* World = GetWorld())
+
+	if (FSoundscapeColorScheduler* Scheduler = GetScheduler())
 	{
-		World->GetTimerManager().SetTimer(UpdateTimer, this, &UActiveSoundscapeColor::UpdateSoundscapeColor, FirstDelayTime);
+		if (SpawnBehavior.bDelayFirstSpawn == false)
+		{
+			// Spread the first spawns of colors starting together, so a palette transition does not spawn every voice on one frame
+			FirstDelayTime = FMath::Max(FirstDelayTime, RandomStream.FRandRange(0.0f, SoundscapeSubsystem->GetFirstSpawnJitter()));
+		}
+
+		NextSpawnTime = Scheduler->GetTime() + FirstDelayTime;
+		ScheduleNextUpdate();
 	}
 }
 
 void UActiveSoundscapeColor::StopPlaying()
 {
-	// Stop with appropriate fade time
-	for (UActiveSoundscapeColorVoice* SoundscapeColorVoice : SoundscapeColorVoicePool)
+	// Stop with appropriate fade time, voices are freed when their Audio Components finish
+	for (int32 VoiceIndex = 0; VoiceIndex < VoiceStates.Num(); ++VoiceIndex)
 	{
-		if (SoundscapeColorVoice)
+		if (VoiceStates[VoiceIndex] == ESoundscapeColorVoiceState::Playing)
 		{
-
-			if (UAudioComponent* VoiceAudioComponent = SoundscapeColorVoice->AudioComponent)
+			if (UAudioComponent* VoiceAudioComponent = VoiceAudioComponents[VoiceIndex])
 			{
-				if (EAudioComponentPlayState::Stopped != VoiceAudioComponent->GetPlayState())
-				{
-					VoiceAudioComponent->FadeOut(FadeOutMin, 0.0f);
-				}
-
-				if (UWorld* World = GetWorld())
-				{
-					// Clear out all timers
-					World->GetTimerManager().ClearTimer(SoundscapeColorVoice->TimerHandle);
-				}
-				
+				VoiceAudioComponent->FadeOut(FadeOutMin, 0.0f);
 			}
+
+			VoiceStates[VoiceIndex] = ESoundscapeColorVoiceState::Stopping;
 		}
 	}
 
+	// Drop pending expiries, spawns and virtual voices
+	LimitedDurationVoices.Reset();
+	VirtualVoices.Reset();
+	NextVoiceExpiryTime = TNumericLimits<double>::Max();
+	NextSpawnTime = TNumericLimits<double>::Max();
+	NextVirtualVoiceUpdateTime = TNumericLimits<double>::Max();
+
+	if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
+	{
+		// Drop the pending update
+		Subsystem->GetColorScheduler().Cancel(ScheduleHandle);
+	}
+
 	bIsPlaying = false;
 }
 
-void UActiveSoundscapeColor::Update()
+int32 UActiveSoundscapeColor::Update(double Time)
 {
 	UWorld* World = GetWorld();
 	bool bNeedToSpawnSound = false;
-	bool bVoiceInPoolFree = false;
-	int32 ActiveVoicesPlaying = 0;
+	int32 NumVoicesStarted = 0;
+
+	// Listeners to place voices around, nearby split screen listeners are merged so they share voices
+	TConstArrayView<FSoundscapeListener> ListenerClusters;
+	int32 ListenerClusterIndex = 0;
 
-	// Free up old voices
-	for (UActiveSoundscapeColorVoice* SoundscapeColorVoice : SoundscapeColorVoicePool)
+	if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
 	{
-		if (SoundscapeColorVoice)
-		{
-			
-			if (UAudioComponent* VoiceAudioComponent = SoundscapeColorVoice->AudioComponent)
-			{
+		ListenerClusters = Subsystem->GetListenerClusters();
+	}
 
-				if (EAudioComponentPlayState::Stopped == VoiceAudioComponent->GetPlayState())
-				{
-					// Voice is not in use, mark it as free to use
-					SoundscapeColorVoice->bFree = true;
+	// Determine if conditions are right to play a new sound
+	if (ListenerClusters.Num() > 1)
+	{
+		// Split the spawn budget across listener clusters, attributing each active voice to its nearest cluster. Active voices
+		// are the ones NumActiveVoices counts, so the budget means the same as with a single listener
+		TArray<int32, TInlineAllocator<4>> ActiveVoicesPerCluster;
+		ActiveVoicesPerCluster.SetNumZeroed(ListenerClusters.Num());
 
-					// Flag that a voice is available
-					bVoiceInPoolFree = true;
-				}
-				else
-				{
-					// Voice is in use, increment active voice count
-					++ActiveVoicesPlaying;
-				}
+		for (int32 VoiceIndex = 0; VoiceIndex < VoiceStates.Num(); ++VoiceIndex)
+		{
+			if (IsVoiceActive(VoiceIndex))
+			{
+				++ActiveVoicesPerCluster[SoundscapeListeners::FindNearestCluster(VoiceLocations[VoiceIndex], ListenerClusters)];
 			}
 		}
-	}
 
-	// Determine if conditions are right to play a new sound
-	if (ActiveVoicesPlaying < SpawnBehavior.MaxNumberOfSpawnedElements)
+		for (const FSoundscapeColorVirtualVoice& VirtualVoice : VirtualVoices)
+		{
+			++ActiveVoicesPerCluster[SoundscapeListeners::FindNearestCluster(VirtualVoice.Params.Location, ListenerClusters)];
+		}
+
+		ListenerClusterIndex = SoundscapeListeners::SelectClusterForSpawn(ActiveVoicesPerCluster, SpawnBehavior.MaxNumberOfSpawnedElements);
+		bNeedToSpawnSound = ListenerClusterIndex != INDEX_NONE;
+	}
+	else if (NumActiveVoices + VirtualVoices.Num() < SpawnBehavior.MaxNumberOfSpawnedElements)
 	{
 		bNeedToSpawnSound = true;
 	}
 
-	// Set up timer if needed
+	// Set up the next spawn if needed
 	if (SpawnBehavior.bContinuouslyRespawn)
 	{
 		// Set random range spawn time, with a minimum value of 0.0001f (which is basically next frame)
-		float SpawnDelayTime = FMath::Max(0.0001f, FMath::FRandRange(SpawnBehavior.MinSpawnDelay, SpawnBehavior.MaxSpawnDelay));
+		float SpawnDelayTime = FMath::Max(0.0001f, RandomStream.FRandRange(SpawnBehavior.MinSpawnDelay, SpawnBehavior.MaxSpawnDelay));
 
-		// Set off timer again
-		if (World)
-		{
-			World->GetTimerManager().SetTimer(UpdateTimer, this, &UActiveSoundscapeColor::UpdateSoundscapeColor, SpawnDelayTime);
-		}
+		NextSpawnTime = Time + SpawnDelayTime;
+	}
+	else
+	{
+		NextSpawnTime = TNumericLimits<double>::Max();
 	}
 
 	// Play Sound if needed and valid sound available
 	if (Sound && bNeedToSpawnSound && World)
 	{
 		// Get the new sound's volume
-		float NewRandVolume = ModulationBehavior.bRandomizeVolume ? FMath::FRandRange(ModulationBehavior.VolumeMin, ModulationBehavior.VolumeMax) : 1.0f;
+		float NewRandVolume = ModulationBehavior.bRandomizeVolume ? RandomStream.FRandRange(ModulationBehavior.VolumeMin, ModulationBehavior.VolumeMax) : 1.0f;
 		float NewSoundVolume = VolumeMod * VolumeBase * NewRandVolume;
 
 		// Get the new sound's pitch
-		float NewRandPitch = ModulationBehavior.bRandomizePitch ? FMath::FRandRange(ModulationBehavior.PitchMin, ModulationBehavior.PitchMax) : 1.0f;
+		float NewRandPitch = ModulationBehavior.bRandomizePitch ? RandomStream.FRandRange(ModulationBehavior.PitchMin, ModulationBehavior.PitchMax) : 1.0f;
 		float NewSoundPitch = PitchMod * PitchBase * NewRandPitch;
 
 		// Get the new sound's fade in time
-		float NewRandFadeIn = ModulationBehavior.bFadeVolume ? FMath::FRandRange(ModulationBehavior.MinFadeInTime, ModulationBehavior.MaxFadeInTime) : 0.0f;
+		float NewRandFadeIn = ModulationBehavior.bFadeVolume ? RandomStream.FRandRange(ModulationBehavior.MinFadeInTime, ModulationBehavior.MaxFadeInTime) : 0.0f;
 		float NewSoundFadeIn = bFirstSpawn ? FMath::Max(FadeInMin, NewRandFadeIn) : NewRandFadeIn;
 		NewSoundFadeIn = (bFirstSpawn && ModulationBehavior.bOnlyFadeInOnRetrigger) ? 0.0f : NewSoundFadeIn;
 
 		// Get the new sound's start time
-		float NewSoundStartTime = PlaybackBehavior.bRandomizeStartingSeekTime ? FMath::FRandRange(0.0f, Sound->Duration) : 0.0f;
+		float NewSoundStartTime = PlaybackBehavior.bRandomizeStartingSeekTime ? RandomStream.FRandRange(0.0f, Sound->Duration) : 0.0f;
 
 		FVector NewSoundSpawnLocation;
-		FVector ListenerLocation;
-		FVector ListenerForward;
-		FVector ListenerUp;
 
-		if (FAudioDevice* AudioDevice = World->GetAudioDeviceRaw())
-		{
-			// Get available Listener Proxies
-			TArray<FListenerProxy>& ListenerProxies = AudioDevice->ListenerProxies;
+		// Get Location and Direction from the selected Listener cluster
+		FSoundscapeListener Listener;
 
-			// TODO: Handle Split Screen
-			if (ListenerProxies.Num())
-			{
-				// Get Location and Direction from Listener
-				FTransform& ListenerTransform = ListenerProxies[0].Transform;
-				ListenerLocation = ListenerTransform.GetLocation();
-				ListenerForward = ListenerTransform.GetRotation().GetForwardVector();
-				ListenerUp = ListenerTransform.GetRotation().GetUpVector();
-			}
+		if (ListenerClusters.IsValidIndex(ListenerClusterIndex))
+		{
+			Listener = ListenerClusters[ListenerClusterIndex];
 		}
 
+		const FVector ListenerLocation = Listener.Location;
+		const FVector ListenerForward = Listener.Forward;
+		const FVector ListenerUp = Listener.Up;
+
 		// Get random distance based on range
-		float NewSpawnDistance = FMath::RandRange(SpawnBehavior.MinSpawnDistance, SpawnBehavior.MaxSpawnDistance);
+		float NewSpawnDistance = RandomStream.FRandRange(SpawnBehavior.MinSpawnDistance, SpawnBehavior.MaxSpawnDistance);
 
 		// Get angle from min/max range then
-		float NewSpawnAngle = FMath::RandRange(SpawnBehavior.MinSpawnAngle, SpawnBehavior.MaxSpawnAngle);
+		float NewSpawnAngle = RandomStream.FRandRange(SpawnBehavior.MinSpawnAngle, SpawnBehavior.MaxSpawnAngle);
 
 		// Sometimes Left Sometimes Right
-		if (FMath::RandBool())
+		if (RandomStream.RandRange(0, 1) == 1)
 		{
 			NewSpawnAngle = NewSpawnAngle * (-1.0f);
 		}
@@ -326,7 +667,7 @@ void UActiveSoundscapeColor::Update()
 		NewSoundSpawnLocation = ListenerForward.RotateAngleAxis(NewSpawnAngle, ListenerUp);
 
 		// Random Z Vector
-		NewSoundSpawnLocation.Z = FMath::RandRange(-1.0f, 1.0f);
+		NewSoundSpawnLocation.Z = RandomStream.FRandRange(-1.0f, 1.0f);
 
 		// Scale Vector and add to Listener Location
 		NewSoundSpawnLocation = (NewSoundSpawnLocation * NewSpawnDistance) + ListenerLocation;
@@ -338,94 +679,50 @@ void UActiveSoundscapeColor::Update()
 
 		if (SpawnBehavior.bRotateSoundSource)
 		{
-			NewSoundRotation.Yaw = FMath::Max(0.0f, FMath::FRandRange(SpawnBehavior.MinAzimuthalRotationAngle, SpawnBehavior.MaxAzimuthalRotationAngle));
-			NewSoundRotation.Pitch = FMath::Max(0.0f, FMath::FRandRange(SpawnBehavior.MinAltitudinalRotationAngle, SpawnBehavior.MaxAltitudinalRotationAngle));
+			NewSoundRotation.Yaw = FMath::Max(0.0f, RandomStream.FRandRange(SpawnBehavior.MinAzimuthalRotationAngle, SpawnBehavior.MaxAzimuthalRotationAngle));
+			NewSoundRotation.Pitch = FMath::Max(0.0f, RandomStream.FRandRange(SpawnBehavior.MinAltitudinalRotationAngle, SpawnBehavior.MaxAltitudinalRotationAngle));
 		}
 
-		// Set up Voice and Component
-		UActiveSoundscapeColorVoice* NewActiveSoundscapeColorVoice = nullptr;
-		UAudioComponent* NewAudioComponent = nullptr;
-
-		// If there's a free voice in the pool, get first available voice
-		if (bVoiceInPoolFree)
-		{
-			for (UActiveSoundscapeColorVoice* ActiveSoundscapeColorVoice : SoundscapeColorVoicePool)
-			{
-				if (ActiveSoundscapeColorVoice)
-				{
-					// Get first free voice
-					if (ActiveSoundscapeColorVoice->bFree)
-					{
-						// Cache pointer to this voice
-						NewActiveSoundscapeColorVoice = ActiveSoundscapeColorVoice;
+		FSoundscapeColorVoiceParams VoiceParams;
+		VoiceParams.Location = NewSoundSpawnLocation;
+		VoiceParams.Rotation = NewSoundRotation.Quaternion();
+		VoiceParams.Volume = NewSoundVolume;
+		VoiceParams.Pitch = NewSoundPitch;
+		VoiceParams.FadeIn = NewSoundFadeIn;
+		VoiceParams.StartTime = NewSoundStartTime;
 
-						break;
-					}
+		float DebugDrawDuration = Sound->Duration;
 
-				}
-			}
-		}
-		
-		// If the ActiveSoundscapeColorVoice is still null, create a new one
-		if (NewActiveSoundscapeColorVoice == nullptr)
+		// Handle limited duration sounds
+		if (PlaybackBehavior.bLimitPlaybackDuration)
 		{
-			// Create new voice
-			NewActiveSoundscapeColorVoice = NewObject<UActiveSoundscapeColorVoice>(World);
+			VoiceParams.FadeOutTime = FMath::Max(0.0001f, RandomStream.FRandRange(ModulationBehavior.MinFadeOutTime, ModulationBehavior.MaxFadeOutTime));
+			VoiceParams.LimitedDuration = FMath::Max(0.0001f, RandomStream.FRandRange(PlaybackBehavior.MinPlaybackDuration, PlaybackBehavior.MaxPlaybackDuration));
 
-			// Add new voice to the pool
-			SoundscapeColorVoicePool.Add(NewActiveSoundscapeColorVoice);
+			DebugDrawDuration = VoiceParams.LimitedDuration;
 		}
 
-		// If the Audio Component invalid, create a new one
-		if (NewActiveSoundscapeColorVoice->AudioComponent == nullptr)
+		// Only spend an Audio Component on voices that can be heard and fit the palette budget
+		const bool bSpawnVoice = IsAudible(VoiceParams) && HasPaletteVoiceBudget();
+
+		if (bSpawnVoice)
 		{
-			NewActiveSoundscapeColorVoice->AudioComponent = NewObject<UAudioComponent>(World);
+			StartVoice(World, Time, VoiceParams);
+			++NumVoicesStarted;
 		}
-
-		// Cache Audio Component ptr
-		NewAudioComponent = NewActiveSoundscapeColorVoice->AudioComponent;
-
-		// Set World location of Audio Component
-		NewAudioComponent->SetWorldLocationAndRotation(NewSoundSpawnLocation, NewSoundRotation.Quaternion());
-
-		// Set relevant Audio Component values before playing
-		NewAudioComponent->SetPitchMultiplier(NewSoundPitch);
-		NewAudioComponent->SetSound(Sound);
-
-		NewAudioComponent->bAutoDestroy = false;
-
-		// Play the sound
-		NewAudioComponent->FadeIn(NewSoundFadeIn, NewSoundVolume, NewSoundStartTime);
-
-		// Voice is no longer free
-		NewActiveSoundscapeColorVoice->bFree = false;
-
-		float DebugDrawDuration = Sound->Duration;
-
-		// Handle limited duration sounds
-		if (PlaybackBehavior.bLimitPlaybackDuration)
+		else
 		{
-			float FadeOutDuration = FMath::Max(0.0001f, FMath::FRandRange(ModulationBehavior.MinFadeOutTime, ModulationBehavior.MaxFadeOutTime));
-			float LimitedDuration = FMath::Max(0.0001f, FMath::FRandRange(PlaybackBehavior.MinPlaybackDuration, PlaybackBehavior.MaxPlaybackDuration));
-			FTimerDelegate TimerDelegate;
-
-			DebugDrawDuration = LimitedDuration;
-
-			TimerDelegate.BindUFunction(NewActiveSoundscapeColorVoice, FName("StopLimitedDurationVoice"), FadeOutDuration);
-			GetWorld()->GetTimerManager().SetTimer(NewActiveSoundscapeColorVoice->TimerHandle, TimerDelegate, LimitedDuration, false);
+			VirtualizeVoice(Time, VoiceParams);
 		}
 
-		// Draw debug spheres if in debug mode
-		if (UGameInstance* GameInstance = World->GetGameInstance())
+		// Draw debug spheres if in debug mode, virtual voices in red
+		if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
 		{
-			if (USoundscapeSubsystem* SoundscapeSubsystem = GameInstance->GetSubsystem<USoundscapeSubsystem>())
+			if (Subsystem->bDebugMode)
 			{
-				if (SoundscapeSubsystem->bDebugMode)
-				{
-					DebugDrawDuration = DebugDrawDuration / FMath::Max(NewSoundPitch, 0.0001f);
-					DrawDebugSphere(World, NewSoundSpawnLocation, 20.0f, 10, FColor::Green, false, DebugDrawDuration);
+				DebugDrawDuration = DebugDrawDuration / FMath::Max(NewSoundPitch, 0.0001f);
+				DrawDebugSphere(World, NewSoundSpawnLocation, 20.0f, 10, bSpawnVoice ? FColor::Green : FColor::Red, false, DebugDrawDuration);
 
-				}
 			}
 		}
 
@@ -433,4 +730,6 @@ void UActiveSoundscapeColor::Update()
 
 	// No longer the first time
 	bFirstSpawn = false;
+
+	return NumVoicesStarted;
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SoundscapeListeners.h"
+#include "AudioDevice.h"
+
+void SoundscapeListeners::GatherListeners(const FAudioDevice* AudioDevice, TArray<FSoundscapeListener>& OutListeners)
+{
+	OutListeners.Reset();
+
+	if (AudioDevice)
+	{
+		for (const FListenerProxy& ListenerProxy : AudioDevice->ListenerProxies)
+		{
+			// Get Location and Direction from Listener
+			const FTransform& ListenerTransform = ListenerProxy.Transform;
+
+			FSoundscapeListener& Listener = OutListeners.AddDefaulted_GetRef();
+			Listener.Location = ListenerTransform.GetLocation();
+			Listener.Forward = ListenerTransform.GetRotation().GetForwardVector();
+			Listener.Up = ListenerTransform.GetRotation().GetUpVector();
+		}
+	}
+}
+
+void SoundscapeListeners::ClusterListeners(TConstArrayView<FSoundscapeListener> Listeners, float MergeDistance, TArray<FSoundscapeListener>& OutClusters)
+{
+	OutClusters.Reset();
+
+	const float MergeDistanceSquared = FMath::Square(FMath::Max(MergeDistance, 0.0f));
+
+	// Local player counts are tiny, a greedy pass is enough
+	for (const FSoundscapeListener& Listener : Listeners)
+	{
+		FSoundscapeListener* MergeCluster = nullptr;
+
+		for (FSoundscapeListener& Cluster : OutClusters)
+		{
+			if (FVector::DistSquared(Cluster.Location, Listener.Location) <= MergeDistanceSquared)
+			{
+				MergeCluster = &Cluster;
+				break;
+			}
+		}
+
+		if (MergeCluster)
+		{
+			// Move the centroid towards the merged listener
+			++MergeCluster->NumMerged;
+			MergeCluster->Location += (Listener.Location - MergeCluster->Location) / MergeCluster->NumMerged;
+		}
+		else
+		{
+			FSoundscapeListener& Cluster = OutClusters.Add_GetRef(Listener);
+			Cluster.NumMerged = 1;
+		}
+	}
+}
+
+int32 SoundscapeListeners::FindNearestCluster(const FVector& Location, TConstArrayView<FSoundscapeListener> Clusters)
+{
+	int32 NearestClusterIndex = INDEX_NONE;
+	float NearestDistanceSquared = TNumericLimits<float>::Max();
+
+	for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ++ClusterIndex)
+	{
+		const float DistanceSquared = FVector::DistSquared(Clusters[ClusterIndex].Location, Location);
+
+		if (DistanceSquared < NearestDistanceSquared)
+		{
+			NearestDistanceSquared = DistanceSquared;
+			NearestClusterIndex = ClusterIndex;
+		}
+	}
+
+	return NearestClusterIndex;
+}
+
+int32 SoundscapeListeners::SelectClusterForSpawn(TConstArrayView<int32> ActiveVoicesPerCluster, int32 MaxVoices)
+{
+	if (ActiveVoicesPerCluster.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Every cluster gets at least one voice, so distant split screen players all hear the color
+	const int32 VoicesPerCluster = FMath::Max(1, FMath::DivideAndRoundUp(MaxVoices, ActiveVoicesPerCluster.Num()));
+
+	int32 SelectedClusterIndex = INDEX_NONE;
+	int32 SelectedActiveVoices = VoicesPerCluster;
+
+	for (int32 ClusterIndex = 0; ClusterIndex < ActiveVoicesPerCluster.Num(); ++ClusterIndex)
+	{
+		if (ActiveVoicesPerCluster[ClusterIndex] < SelectedActiveVoices)
+		{
+			SelectedActiveVoices = ActiveVoicesPerCluster[ClusterIndex];
+			SelectedClusterIndex = ClusterIndex;
+		}
+	}
+
+	return SelectedClusterIndex;
+}
@@ -2,6 +2,7 @@
 
 #include "SoundscapePalette.h"
 #include "SoundscapeColor.h"
+#include "SoundscapeSubsystem.h"
 #include "Engine/World.h"
 #include "AudioDevice.h"
 #include "DrawDebugHelpers.h"
@@ -21,13 +22,46 @@ void USoundscapePalette::Serialize(FArchive& Ar)
 	Super::Serialize(Ar);
 }
 
+void UActiveSoundscapePalette::BeginDestroy()
+{
+	if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
+	{
+		// Release the scheduler group
+		Subsystem->GetColorScheduler().DestroyGroup(SchedulerGroup);
+	}
+
+	Super::BeginDestroy();
+}
+
 void UActiveSoundscapePalette::InitializeSettings(UObject* WorldContextObject, USoundscapePalette* SoundscapePalette)
 {
 	if (SoundscapePalette && WorldContextObject)
 	{
+		World = WorldContextObject->GetWorld();
+		MaxActiveVoices = SoundscapePalette->MaxActiveVoices;
+
+		// Group the palette's colors in the scheduler so they can be paused together
+		if (World && SoundscapeSubsystem.IsValid() == false)
+		{
+			if (UGameInstance* GameInstance = World->GetGameInstance())
+			{
+				if (USoundscapeSubsystem* Subsystem = GameInstance->GetSubsystem<USoundscapeSubsystem>())
+				{
+					SoundscapeSubsystem = Subsystem;
+					SchedulerGroup = Subsystem->GetColorScheduler().CreateGroup();
+				}
+			}
+		}
+
+		// Palette part of every color's seed hash, from the path so it is stable across runs
+		const uint32 PaletteSeedHash = GetTypeHash(SoundscapePalette->GetPathName());
+		int32 ColorSlot = 0;
+
 		// Set up Soundscape Colors
 		for (FSoundscapePaletteColor& SoundscapePaletteColor : SoundscapePalette->Colors)
 		{
+			++ColorSlot;
+
 			if (USoundscapeColor* SoundscapeColor = SoundscapePaletteColor.SoundscapeColor)
 			{
 				// Verify that the input SoundscapeElement is not null
@@ -38,6 +72,14 @@ void UActiveSoundscapePalette::InitializeSettings(UObject* WorldContextObject, U
 
 					//
 					ActiveSoundscapeColor->SetParameterValues(SoundscapeColor);
+					ActiveSoundscapeColor->SetSchedulerGroup(SchedulerGroup);
+					ActiveSoundscapeColor->SetOwningPalette(this);
+					ActiveSoundscapeColor->SetSeedHash(HashCombine(PaletteSeedHash, HashCombine(GetTypeHash(SoundscapeColor->GetPathName()), GetTypeHash(ColorSlot))));
+
+					if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
+					{
+						Subsystem->SeedColor(ActiveSoundscapeColor);
+					}
 
 #if WITH_EDITOR
 					ActiveSoundscapeColor->BindToParameterChangeDelegate(SoundscapeColor);
@@ -81,3 +123,39 @@ void UActiveSoundscapePalette::Stop()
 
 }
 
+void UActiveSoundscapePalette::Pause()
+{
+	if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
+	{
+		Subsystem->GetColorScheduler().PauseGroup(SchedulerGroup);
+	}
+}
+
+void UActiveSoundscapePalette::Resume()
+{
+	if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
+	{
+		Subsystem->GetColorScheduler().ResumeGroup(SchedulerGroup);
+	}
+}
+
+bool UActiveSoundscapePalette::IsPaused() const
+{
+	if (const USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
+	{
+		return Subsystem->GetColorScheduler().IsGroupPaused(SchedulerGroup);
+	}
+
+	return false;
+}
+
+void UActiveSoundscapePalette::SeedColors()
+{
+	if (USoundscapeSubsystem* Subsystem = SoundscapeSubsystem.Get())
+	{
+		for (UActiveSoundscapeColor* ActiveSoundscapeColor : ActiveSoundscapeColors)
+		{
+			Subsystem->SeedColor(ActiveSoundscapeColor);
+		}
+	}
+}
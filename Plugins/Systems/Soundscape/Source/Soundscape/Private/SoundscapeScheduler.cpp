@@ -0,0 +1,269 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SoundscapeScheduler.h"
+#include "SoundscapeColor.h"
+
+FSoundscapeScheduleHandle FSoundscapeColorScheduler::Register(UActiveSoundscapeColor* Color, int32 GroupIndex)
+{
+	// Reuse a released slot when there is one
+	int32 SlotIndex = INDEX_NONE;
+
+	if (FreeSlots.Num())
+	{
+		SlotIndex = FreeSlots.Pop(false);
+	}
+	else
+	{
+		SlotIndex = Slots.AddDefaulted();
+	}
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.Color = Color;
+	Slot.GroupIndex = Groups.IsValidIndex(GroupIndex) && Groups[GroupIndex].bAllocated ? GroupIndex : INDEX_NONE;
+	Slot.bRegistered = true;
+	Slot.bScheduled = false;
+
+	// Bump the serial so handles to the previous occupant stay invalid
+	++Slot.Serial;
+
+	FSoundscapeScheduleHandle Handle;
+	Handle.SlotIndex = SlotIndex;
+	Handle.Serial = Slot.Serial;
+
+	return Handle;
+}
+
+void FSoundscapeColorScheduler::Unregister(FSoundscapeScheduleHandle& Handle)
+{
+	if (FSlot* Slot = FindSlot(Handle))
+	{
+		Cancel(Handle);
+
+		Slot->Color.Reset();
+		Slot->GroupIndex = INDEX_NONE;
+		Slot->bRegistered = false;
+		++Slot->Serial;
+
+		FreeSlots.Add(Handle.SlotIndex);
+	}
+
+	Handle.Invalidate();
+}
+
+void FSoundscapeColorScheduler::Schedule(const FSoundscapeScheduleHandle& Handle, float Delay)
+{
+	ScheduleAt(Handle, CurrentTime + FMath::Max(Delay, 0.0f));
+}
+
+void FSoundscapeColorScheduler::ScheduleAt(const FSoundscapeScheduleHandle& Handle, double FireTime)
+{
+	if (FSlot* Slot = FindSlot(Handle))
+	{
+		if (Slot->bScheduled == false)
+		{
+			++NumScheduled;
+		}
+
+		// A new schedule serial turns any previous heap or parked entry stale
+		Slot->bScheduled = true;
+		++Slot->ScheduleSerial;
+
+		Heap.HeapPush(FHeapEntry{ FMath::Max(FireTime, CurrentTime), Handle.SlotIndex, Slot->ScheduleSerial });
+
+		CompactHeap();
+	}
+}
+
+void FSoundscapeColorScheduler::Cancel(const FSoundscapeScheduleHandle& Handle)
+{
+	if (FSlot* Slot = FindSlot(Handle))
+	{
+		if (Slot->bScheduled)
+		{
+			// Stale entries are dropped lazily when they reach the top of the heap
+			Slot->bScheduled = false;
+			++Slot->ScheduleSerial;
+			--NumScheduled;
+		}
+	}
+}
+
+bool FSoundscapeColorScheduler::IsScheduled(const FSoundscapeScheduleHandle& Handle) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	return Slot && Slot->bScheduled;
+}
+
+UActiveSoundscapeColor* FSoundscapeColorScheduler::GetColor(const FSoundscapeScheduleHandle& Handle) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	return Slot ? Slot->Color.Get() : nullptr;
+}
+
+int32 FSoundscapeColorScheduler::CreateGroup()
+{
+	int32 GroupIndex = INDEX_NONE;
+
+	if (FreeGroups.Num())
+	{
+		GroupIndex = FreeGroups.Pop(false);
+	}
+	else
+	{
+		GroupIndex = Groups.AddDefaulted();
+	}
+
+	FGroup& Group = Groups[GroupIndex];
+	Group.bAllocated = true;
+	Group.bPaused = false;
+	Group.ParkedEntries.Reset();
+
+	return GroupIndex;
+}
+
+void FSoundscapeColorScheduler::DestroyGroup(int32 GroupIndex)
+{
+	if (Groups.IsValidIndex(GroupIndex) && Groups[GroupIndex].bAllocated)
+	{
+		// Release parked updates so the colors are not lost with the group
+		ResumeGroup(GroupIndex);
+
+		for (FSlot& Slot : Slots)
+		{
+			if (Slot.GroupIndex == GroupIndex)
+			{
+				Slot.GroupIndex = INDEX_NONE;
+			}
+		}
+
+		Groups[GroupIndex].bAllocated = false;
+		FreeGroups.Add(GroupIndex);
+	}
+}
+
+void FSoundscapeColorScheduler::SetGroup(const FSoundscapeScheduleHandle& Handle, int32 GroupIndex)
+{
+	if (FSlot* Slot = FindSlot(Handle))
+	{
+		Slot->GroupIndex = Groups.IsValidIndex(GroupIndex) && Groups[GroupIndex].bAllocated ? GroupIndex : INDEX_NONE;
+	}
+}
+
+void FSoundscapeColorScheduler::PauseGroup(int32 GroupIndex)
+{
+	if (Groups.IsValidIndex(GroupIndex) && Groups[GroupIndex].bAllocated)
+	{
+		// Due colors are parked lazily by Advance, so pausing does not touch the heap
+		Groups[GroupIndex].bPaused = true;
+	}
+}
+
+void FSoundscapeColorScheduler::ResumeGroup(int32 GroupIndex)
+{
+	if (Groups.IsValidIndex(GroupIndex) && Groups[GroupIndex].bAllocated)
+	{
+		FGroup& Group = Groups[GroupIndex];
+		Group.bPaused = false;
+
+		// Parked updates were already due, fire them on the next Advance
+		for (FHeapEntry& ParkedEntry : Group.ParkedEntries)
+		{
+			if (IsEntryCurrent(ParkedEntry))
+			{
+				ParkedEntry.FireTime = CurrentTime;
+				Heap.HeapPush(ParkedEntry);
+			}
+		}
+
+		Group.ParkedEntries.Reset();
+	}
+}
+
+bool FSoundscapeColorScheduler::IsGroupPaused(int32 GroupIndex) const
+{
+	return Groups.IsValidIndex(GroupIndex) && Groups[GroupIndex].bAllocated && Groups[GroupIndex].bPaused;
+}
+
+bool FSoundscapeColorScheduler::IsPaused(const FSoundscapeScheduleHandle& Handle) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	return Slot && IsGroupPaused(Slot->GroupIndex);
+}
+
+void FSoundscapeColorScheduler::Advance(float DeltaTime, TArray<FSoundscapeScheduleHandle>& OutDueHandles)
+{
+	CurrentTime += FMath::Max(DeltaTime, 0.0f);
+
+	while (Heap.Num() && Heap.HeapTop().FireTime <= CurrentTime)
+	{
+		FHeapEntry Entry;
+		Heap.HeapPop(Entry, false);
+
+		if (IsEntryCurrent(Entry) == false)
+		{
+			continue;
+		}
+
+		FSlot& Slot = Slots[Entry.SlotIndex];
+
+		// Park updates of paused groups until the group resumes
+		if (Slot.GroupIndex != INDEX_NONE && Groups[Slot.GroupIndex].bPaused)
+		{
+			Groups[Slot.GroupIndex].ParkedEntries.Add(Entry);
+			continue;
+		}
+
+		Slot.bScheduled = false;
+		--NumScheduled;
+
+		FSoundscapeScheduleHandle& DueHandle = OutDueHandles.AddDefaulted_GetRef();
+		DueHandle.SlotIndex = Entry.SlotIndex;
+		DueHandle.Serial = Slot.Serial;
+	}
+}
+
+void FSoundscapeColorScheduler::Reset()
+{
+	Slots.Reset();
+	FreeSlots.Reset();
+	Heap.Reset();
+	Groups.Reset();
+	FreeGroups.Reset();
+	NumScheduled = 0;
+}
+
+FSoundscapeColorScheduler::FSlot* FSoundscapeColorScheduler::FindSlot(const FSoundscapeScheduleHandle& Handle)
+{
+	if (Slots.IsValidIndex(Handle.SlotIndex))
+	{
+		FSlot& Slot = Slots[Handle.SlotIndex];
+
+		if (Slot.bRegistered && Slot.Serial == Handle.Serial)
+		{
+			return &Slot;
+		}
+	}
+
+	return nullptr;
+}
+
+const FSoundscapeColorScheduler::FSlot* FSoundscapeColorScheduler::FindSlot(const FSoundscapeScheduleHandle& Handle) const
+{
+	return const_cast<FSoundscapeColorScheduler*>(this)->FindSlot(Handle);
+}
+
+bool FSoundscapeColorScheduler::IsEntryCurrent(const FHeapEntry& Entry) const
+{
+	const FSlot& Slot = Slots[Entry.SlotIndex];
+	return Slot.bRegistered && Slot.bScheduled && Slot.ScheduleSerial == Entry.ScheduleSerial;
+}
+
+void FSoundscapeColorScheduler::CompactHeap()
+{
+	if (Heap.Num() > 64 && Heap.Num() > NumScheduled * 2)
+	{
+		Heap.RemoveAllSwap([this](const FHeapEntry& Entry) { return IsEntryCurrent(Entry) == false; }, false);
+		Heap.Heapify();
+	}
+}
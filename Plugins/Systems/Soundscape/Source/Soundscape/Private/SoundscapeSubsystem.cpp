@@ -4,7 +4,21 @@
 #include "SoundscapeSubsystem.h"
 #include "SoundscapeSettings.h"
 #include "SoundscapePalette.h"
+#include "SoundscapeColor.h"
+#include "SoundscapeModule.h"
 #include "AudioDevice.h"
+#include "Engine/GameInstance.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("Soundscape"), STATGROUP_Soundscape, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Soundscape Subsystem Tick"), STAT_SoundscapeSubsystemTick, STATGROUP_Soundscape);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Colors"), STAT_SoundscapeScheduledColors, STATGROUP_Soundscape);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Color Updates"), STAT_SoundscapeColorUpdates, STATGROUP_Soundscape);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Voices Spawned"), STAT_SoundscapeVoicesSpawned, STATGROUP_Soundscape);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred Color Updates"), STAT_SoundscapeDeferredColorUpdates, STATGROUP_Soundscape);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Palettes Evaluated"), STAT_SoundscapePalettesEvaluated, STATGROUP_Soundscape);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Palettes"), STAT_SoundscapeActivePalettes, STATGROUP_Soundscape);
 
 void USoundscapeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -40,12 +54,134 @@ void USoundscapeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 		}
 
 		bDebugMode = ProjectSettings->bDebugDraw;
+		ListenerMergeDistance = ProjectSettings->ListenerMergeDistance;
+		VirtualVoiceUpdateInterval = ProjectSettings->VirtualVoiceUpdateInterval;
+		MaxSpawnsPerFrame = ProjectSettings->MaxSpawnsPerFrame;
+		MaxSpawnTimePerFrameMs = ProjectSettings->MaxSpawnTimePerFrameMs;
+		FirstSpawnJitter = ProjectSettings->FirstSpawnJitter;
+		bDeterministicSpawning = ProjectSettings->bDeterministicSpawning;
+		DeterministicSeed = ProjectSettings->DeterministicSeed;
 	}
+
+	bInitialized = true;
 }
 
 void USoundscapeSubsystem::Deinitialize()
 {
+	bInitialized = false;
+
+	// Stop any loads still in flight, their callbacks must not fire on a deinitialized Subsystem
+	for (TPair<FName, TSharedPtr<FStreamableHandle>>& PaletteCollectionHandle : PaletteCollectionHandles)
+	{
+		if (PaletteCollectionHandle.Value.IsValid())
+		{
+			PaletteCollectionHandle.Value->CancelHandle();
+		}
+	}
+
+	for (TPair<FName, TSharedPtr<FStreamableHandle>>& PrefetchHandle : PrefetchHandles)
+	{
+		if (PrefetchHandle.Value.IsValid())
+		{
+			PrefetchHandle.Value->CancelHandle();
+		}
+	}
+
+	PaletteCollectionHandles.Empty();
+	PrefetchHandles.Empty();
+	LoadedPaletteCollectionNames.Empty();
+
+	// Colors outliving the Subsystem re-register with the next one
+	ColorScheduler.Reset();
+	PendingColorUpdates.Reset();
+}
+
+void USoundscapeSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SoundscapeSubsystemTick);
+
+	// Gather listeners once for every color updated this frame
+	if (UWorld* World = GetWorld())
+	{
+		SoundscapeListeners::GatherListeners(World->GetAudioDeviceRaw(), Listeners);
+		SoundscapeListeners::ClusterListeners(Listeners, ListenerMergeDistance, ListenerClusters);
+	}
+
+	// Collect every color due this frame in one batch and queue them with the updates deferred from previous frames
+	DueColorHandles.Reset();
+	ColorScheduler.Advance(DeltaTime, DueColorHandles);
+
+	for (const FSoundscapeScheduleHandle& DueColorHandle : DueColorHandles)
+	{
+		if (UActiveSoundscapeColor* ActiveSoundscapeColor = ColorScheduler.GetColor(DueColorHandle))
+		{
+			PendingColorUpdates.HeapPush(FSoundscapePendingColorUpdate{ DueColorHandle, ActiveSoundscapeColor->GetSpawnPriority(), ColorScheduler.GetTime() });
+		}
+	}
+
+	// Run updates by priority until the frame's spawn budget is spent
+	const double StartTime = FPlatformTime::Seconds();
+	const double MaxSpawnTime = MaxSpawnTimePerFrameMs > 0.0f ? MaxSpawnTimePerFrameMs / 1000.0 : TNumericLimits<double>::Max();
+	const int32 MaxSpawns = MaxSpawnsPerFrame > 0 ? MaxSpawnsPerFrame : MAX_int32;
+
+	int32 NumColorUpdates = 0;
+	int32 NumVoicesSpawned = 0;
 
+	while (PendingColorUpdates.Num())
+	{
+		// The first update always runs so a spent budget never starves the queue
+		if (NumColorUpdates > 0 && (NumVoicesSpawned >= MaxSpawns || FPlatformTime::Seconds() - StartTime >= MaxSpawnTime))
+		{
+			break;
+		}
+
+		FSoundscapePendingColorUpdate PendingColorUpdate;
+		PendingColorUpdates.HeapPop(PendingColorUpdate, false);
+
+		// Skip colors that were unregistered or rescheduled (stopped and restarted) while deferred
+		if (ColorScheduler.IsScheduled(PendingColorUpdate.Handle))
+		{
+			continue;
+		}
+
+		// Hand updates of palettes paused while deferred back to the scheduler, which parks them until the palette resumes
+		if (ColorScheduler.IsPaused(PendingColorUpdate.Handle))
+		{
+			ColorScheduler.ScheduleAt(PendingColorUpdate.Handle, ColorScheduler.GetTime());
+			continue;
+		}
+
+		if (UActiveSoundscapeColor* ActiveSoundscapeColor = ColorScheduler.GetColor(PendingColorUpdate.Handle))
+		{
+			NumVoicesSpawned += ActiveSoundscapeColor->UpdateSoundscapeColor();
+			++NumColorUpdates;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SoundscapeScheduledColors, ColorScheduler.GetNumScheduled());
+	SET_DWORD_STAT(STAT_SoundscapeColorUpdates, NumColorUpdates);
+	SET_DWORD_STAT(STAT_SoundscapeVoicesSpawned, NumVoicesSpawned);
+	SET_DWORD_STAT(STAT_SoundscapeDeferredColorUpdates, PendingColorUpdates.Num());
+}
+
+bool USoundscapeSubsystem::IsTickable() const
+{
+	return bInitialized && IsTemplate() == false;
+}
+
+bool USoundscapeSubsystem::IsTickableInEditor() const
+{
+	return false;
+}
+
+bool USoundscapeSubsystem::IsTickableWhenPaused() const
+{
+	return false;
+}
+
+TStatId USoundscapeSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_SoundscapeSubsystemTick);
 }
 
 bool USoundscapeSubsystem::ShouldCreateSubsystem(UObject* Outer) const
@@ -72,23 +208,23 @@ bool USoundscapeSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 void USoundscapeSubsystem::SetState(FGameplayTag SoundscapeState)
 {
-	if (SoundscapeState.IsValid())
+	if (SoundscapeState.IsValid() && SubsystemState.HasTagExact(SoundscapeState) == false)
 	{
 		// Add new state to the container
 		SubsystemState.AddLeafTag(SoundscapeState);
 
-		UpdateState();
+		UpdateStateForTag(SoundscapeState);
 	}
 }
 
 void USoundscapeSubsystem::ClearState(FGameplayTag SoundscapeState)
 {
-	if (SoundscapeState.IsValid())
+	if (SoundscapeState.IsValid() && SubsystemState.HasTagExact(SoundscapeState))
 	{
-		// Add new state to the container
+		// Remove state from the container
 		SubsystemState.RemoveTag(SoundscapeState);
 
-		UpdateState();
+		UpdateStateForTag(SoundscapeState);
 	}
 }
 
@@ -98,11 +234,8 @@ bool USoundscapeSubsystem::AddPaletteCollection(FName PaletteCollectionName, FSo
 	{
 		UnloadedPaletteCollections.Add(PaletteCollectionName, PaletteCollection);
 
-		bool bLoaded = LoadPaletteCollection(PaletteCollectionName);
-
-		UpdateState();
-
-		return bLoaded;
+		// Palettes are added to the loaded set, and state updated, once they have streamed in
+		return LoadPaletteCollection(PaletteCollectionName);
 	}
 
 	return false;
@@ -126,24 +259,93 @@ bool USoundscapeSubsystem::RemovePaletteCollection(FName PaletteCollectionName)
 	return false;
 }
 
-bool USoundscapeSubsystem::LoadPaletteCollection(FName PaletteCollectionName)
+void USoundscapeSubsystem::SetDeterministicSpawning(bool bEnabled, int32 WorldSeed)
 {
-	if (UnloadedPaletteCollections.Contains(PaletteCollectionName))
+	bDeterministicSpawning = bEnabled;
+	DeterministicSeed = WorldSeed;
+
+	// Reseed existing colors so the new mode applies right away
+	for (TPair<USoundscapePalette*, UActiveSoundscapePalette*>& ActivePalette : ActivePalettes)
 	{
-		FSoundscapePaletteCollection PaletteCollectionToLoad = UnloadedPaletteCollections.FindRef(PaletteCollectionName);
+		if (ActivePalette.Value)
+		{
+			ActivePalette.Value->SeedColors();
+		}
+	}
 
-		for (FSoftObjectPath& ObjPath : PaletteCollectionToLoad.SoundscapePaletteCollection)
+	for (TPair<USoundscapePalette*, UActiveSoundscapePalette*>& InactivePalette : InactivePalettes)
+	{
+		if (InactivePalette.Value)
 		{
-			if (UObject* PalettePath = ObjPath.TryLoad())
-			{
-				USoundscapePalette* SoundscapePalette = Cast<USoundscapePalette>(PalettePath);
+			InactivePalette.Value->SeedColors();
+		}
+	}
+}
 
-				if (SoundscapePalette)
-				{
-					// If palette is valid, add it to the Subsystem Collection
-					LoadedPaletteCollectionSet.Add(SoundscapePalette);
-				}
-			}
+void USoundscapeSubsystem::SeedColor(UActiveSoundscapeColor* ActiveSoundscapeColor) const
+{
+	if (ActiveSoundscapeColor)
+	{
+		const int32 Seed = bDeterministicSpawning ? static_cast<int32>(HashCombine(ActiveSoundscapeColor->GetSeedHash(), GetTypeHash(DeterministicSeed))) : FMath::Rand();
+		ActiveSoundscapeColor->SetRandomSeed(Seed);
+	}
+}
+
+bool USoundscapeSubsystem::IsPaletteCollectionLoaded(FName PaletteCollectionName) const
+{
+	return LoadedPaletteCollectionNames.Contains(PaletteCollectionName);
+}
+
+void USoundscapeSubsystem::PrefetchPaletteCollection(FName PaletteCollectionName, FSoundscapePaletteCollection PaletteCollection)
+{
+	if (PrefetchHandles.Contains(PaletteCollectionName) || PaletteCollectionHandles.Contains(PaletteCollectionName))
+	{
+		// Already streaming
+		return;
+	}
+
+	// No callback, the handle only keeps the palettes streaming and resident until the collection is added or the prefetch released
+	TSharedPtr<FStreamableHandle> PrefetchHandle = StreamableManager.RequestAsyncLoad(PaletteCollection.SoundscapePaletteCollection.Array());
+
+	if (PrefetchHandle.IsValid())
+	{
+		PrefetchHandles.Add(PaletteCollectionName, PrefetchHandle);
+	}
+}
+
+void USoundscapeSubsystem::ReleasePrefetchedPaletteCollection(FName PaletteCollectionName)
+{
+	TSharedPtr<FStreamableHandle> PrefetchHandle;
+
+	if (PrefetchHandles.RemoveAndCopyValue(PaletteCollectionName, PrefetchHandle) && PrefetchHandle.IsValid())
+	{
+		if (PrefetchHandle->IsLoadingInProgress())
+		{
+			PrefetchHandle->CancelHandle();
+		}
+		else
+		{
+			PrefetchHandle->ReleaseHandle();
+		}
+	}
+}
+
+bool USoundscapeSubsystem::LoadPaletteCollection(FName PaletteCollectionName)
+{
+	if (const FSoundscapePaletteCollection* PaletteCollectionToLoad = UnloadedPaletteCollections.Find(PaletteCollectionName))
+	{
+		// Stream the palettes in, they are added to the loaded set when they arrive
+		TSharedPtr<FStreamableHandle> PaletteCollectionHandle = StreamableManager.RequestAsyncLoad(PaletteCollectionToLoad->SoundscapePaletteCollection.Array(),
+			FStreamableDelegate::CreateUObject(this, &USoundscapeSubsystem::OnPaletteCollectionStreamed, PaletteCollectionName));
+
+		if (PaletteCollectionHandle.IsValid())
+		{
+			PaletteCollectionHandles.Add(PaletteCollectionName, PaletteCollectionHandle);
+		}
+		else
+		{
+			// Nothing to stream
+			OnPaletteCollectionStreamed(PaletteCollectionName);
 		}
 
 		return true;
@@ -152,6 +354,36 @@ bool USoundscapeSubsystem::LoadPaletteCollection(FName PaletteCollectionName)
 	return false;
 }
 
+void USoundscapeSubsystem::OnPaletteCollectionStreamed(FName PaletteCollectionName)
+{
+	const FSoundscapePaletteCollection* PaletteCollection = UnloadedPaletteCollections.Find(PaletteCollectionName);
+
+	if (PaletteCollection == nullptr || LoadedPaletteCollectionNames.Contains(PaletteCollectionName))
+	{
+		// Removed while streaming, or already handled
+		return;
+	}
+
+	for (const FSoftObjectPath& ObjPath : PaletteCollection->SoundscapePaletteCollection)
+	{
+		// Palettes should be resident now
+		if (USoundscapePalette* SoundscapePalette = Cast<USoundscapePalette>(ObjPath.ResolveObject()))
+		{
+			// If palette is valid, add it to the Subsystem Collection
+			LoadedPaletteCollectionSet.Add(SoundscapePalette);
+		}
+	}
+
+	LoadedPaletteCollectionNames.Add(PaletteCollectionName);
+
+	// The collection's own handle keeps the palettes resident now
+	ReleasePrefetchedPaletteCollection(PaletteCollectionName);
+
+	UpdateState();
+
+	OnPaletteCollectionLoaded.Broadcast(PaletteCollectionName);
+}
+
 bool USoundscapeSubsystem::UnloadPaletteCollection(FName PaletteCollectionName)
 {
 	if (UnloadedPaletteCollections.Find(PaletteCollectionName))
@@ -177,10 +409,10 @@ bool USoundscapeSubsystem::UnloadPaletteCollection(FName PaletteCollectionName)
 		// Temp set of palettes to remove and stop
 		TSet<USoundscapePalette*> PalettesToUnloadStopAndRemove;
 
-		// Go through collection, get their loaded pointers, add to temp removal set
+		// Go through collection, get their loaded pointers, add to temp removal set, palettes that never streamed in are not playing
 		for (FSoftObjectPath& ObjPath : PaletteCollectionSetToUnload)
 		{
-			if (UObject* PalettePath = ObjPath.TryLoad())
+			if (UObject* PalettePath = ObjPath.ResolveObject())
 			{
 				USoundscapePalette* SoundscapePalette = Cast<USoundscapePalette>(PalettePath);
 
@@ -192,7 +424,7 @@ bool USoundscapeSubsystem::UnloadPaletteCollection(FName PaletteCollectionName)
 			}
 		}
 
-		// Stop and remove from Active list
+		// Stop and remove from Active list and the pool
 		for (USoundscapePalette* PaletteKeyToStop : PalettesToUnloadStopAndRemove)
 		{
 			if (PaletteKeyToStop)
@@ -203,12 +435,31 @@ bool USoundscapeSubsystem::UnloadPaletteCollection(FName PaletteCollectionName)
 
 					ActivePalettes.Remove(PaletteKeyToStop);
 				}
+
+				InactivePalettes.Remove(PaletteKeyToStop);
 			}
 		}
 
 		// Remove from main list of loaded palettes
 		LoadedPaletteCollectionSet = LoadedPaletteCollectionSet.Difference(PalettesToUnloadStopAndRemove);
 
+		// Release the collection's handle, palettes shared with other collections stay resident through their handles
+		TSharedPtr<FStreamableHandle> PaletteCollectionHandle;
+
+		if (PaletteCollectionHandles.RemoveAndCopyValue(PaletteCollectionName, PaletteCollectionHandle) && PaletteCollectionHandle.IsValid())
+		{
+			if (PaletteCollectionHandle->IsLoadingInProgress())
+			{
+				PaletteCollectionHandle->CancelHandle();
+			}
+			else
+			{
+				PaletteCollectionHandle->ReleaseHandle();
+			}
+		}
+
+		LoadedPaletteCollectionNames.Remove(PaletteCollectionName);
+
 		return true;
 	}
 
@@ -217,56 +468,121 @@ bool USoundscapeSubsystem::UnloadPaletteCollection(FName PaletteCollectionName)
 
 void USoundscapeSubsystem::UpdateState()
 {
-	// Palettes the keep
-	TMap<USoundscapePalette*, UActiveSoundscapePalette*> ActivePalettesToKeep;
+	// The loaded set changed, re-index it
+	RebuildPaletteTagIndex();
 
-	// Remove tags that don't match
-	for (const TPair<USoundscapePalette*, UActiveSoundscapePalette*> ActiveSoundscapePalettePair : ActivePalettes)
+	// Evaluate every loaded palette, the loaded set only holds palettes that have finished streaming in
+	for (USoundscapePalette* SoundscapePalette : LoadedPaletteCollectionSet)
 	{
-		USoundscapePalette* SoundscapePalette = ActiveSoundscapePalettePair.Key;
-		UActiveSoundscapePalette* ActiveSoundscapePalette = ActiveSoundscapePalettePair.Value;
+		EvaluatePalette(SoundscapePalette);
+	}
+
+	SET_DWORD_STAT(STAT_SoundscapeActivePalettes, ActivePalettes.Num());
+}
+
+void USoundscapeSubsystem::UpdateStateForTag(FGameplayTag ChangedTag)
+{
+	// Queries match tags against the state with its parents, so a change can affect queries on the tag or any of its parents
+	const FGameplayTagContainer ChangedTagAndParents = ChangedTag.GetGameplayTagParents();
+
+	TSet<USoundscapePalette*, DefaultKeyFuncs<USoundscapePalette*>, TInlineSetAllocator<16>> PalettesToEvaluate;
 
-		if (SoundscapePalette && ActiveSoundscapePalette)
+	for (const FGameplayTag& Tag : ChangedTagAndParents)
+	{
+		if (const TArray<USoundscapePalette*>* IndexedPalettes = PaletteTagIndex.Find(Tag))
 		{
-			if (SoundscapePalette->SoundscapePalettePlaybackConditions.Matches(SubsystemState))
-			{
-				ActivePalettesToKeep.Add(SoundscapePalette, ActiveSoundscapePalette);
-			}
-			else
-			{
-				ActiveSoundscapePalette->Stop();
-			}
+			PalettesToEvaluate.Append(*IndexedPalettes);
 		}
 	}
 
-	// Empty active palettes an append ones to keep
-	ActivePalettes.Empty();
-	ActivePalettes.Append(ActivePalettesToKeep);
+	for (USoundscapePalette* SoundscapePalette : PalettesToEvaluate)
+	{
+		EvaluatePalette(SoundscapePalette);
+	}
+
+	SET_DWORD_STAT(STAT_SoundscapeActivePalettes, ActivePalettes.Num());
+}
+
+void USoundscapeSubsystem::RebuildPaletteTagIndex()
+{
+	PaletteTagIndex.Reset();
 
-	// Add matching palettes
-	for (auto PaletteIterator = LoadedPaletteCollectionSet.CreateConstIterator(); PaletteIterator; ++PaletteIterator)
+	for (USoundscapePalette* SoundscapePalette : LoadedPaletteCollectionSet)
 	{
-		if (USoundscapePalette* SoundscapePalette = *PaletteIterator)
+		if (SoundscapePalette)
 		{
-			// Evaluate if the Soundscape Palette matches
-			if (SoundscapePalette->SoundscapePalettePlaybackConditions.Matches(SubsystemState) && ActivePalettes.Contains(SoundscapePalette) == false)
+			// Palettes whose conditions reference no tags never change with state, they are only evaluated by UpdateState
+			for (const FGameplayTag& Tag : SoundscapePalette->SoundscapePalettePlaybackConditions.GetGameplayTagArray())
 			{
-				UWorld* World = GetWorld();
+				PaletteTagIndex.FindOrAdd(Tag).AddUnique(SoundscapePalette);
+			}
+		}
+	}
+}
 
-				if (World)
-				{
-					// Create a new ActiveSoundscapeColor
-					UActiveSoundscapePalette* ActiveSoundscapePalette = NewObject<UActiveSoundscapePalette>(World);
+void USoundscapeSubsystem::EvaluatePalette(USoundscapePalette* SoundscapePalette)
+{
+	if (SoundscapePalette == nullptr)
+	{
+		return;
+	}
 
-					//
-					ActiveSoundscapePalette->InitializeSettings(World, SoundscapePalette);
+	INC_DWORD_STAT(STAT_SoundscapePalettesEvaluated);
 
-					ActiveSoundscapePalette->Play();
+	const bool bShouldPlay = SoundscapePalette->SoundscapePalettePlaybackConditions.Matches(SubsystemState);
+	UActiveSoundscapePalette* ActiveSoundscapePalette = ActivePalettes.FindRef(SoundscapePalette);
 
-					ActivePalettes.Add(SoundscapePalette, ActiveSoundscapePalette);
+	if (bShouldPlay && ActiveSoundscapePalette == nullptr)
+	{
+		// Reuse the palette's stopped instance if it has one
+		InactivePalettes.RemoveAndCopyValue(SoundscapePalette, ActiveSoundscapePalette);
 
-				}
+		if (ActiveSoundscapePalette == nullptr)
+		{
+			UWorld* World = GetWorld();
+
+			if (World == nullptr)
+			{
+				return;
 			}
+
+			// Create a new ActiveSoundscapePalette
+			ActiveSoundscapePalette = NewObject<UActiveSoundscapePalette>(World);
+			ActiveSoundscapePalette->InitializeSettings(World, SoundscapePalette);
 		}
+
+		ActiveSoundscapePalette->Play();
+
+		ActivePalettes.Add(SoundscapePalette, ActiveSoundscapePalette);
+	}
+	else if (bShouldPlay == false && ActiveSoundscapePalette)
+	{
+		ActiveSoundscapePalette->Stop();
+
+		// Pool the stopped instance for the next time the palette matches
+		ActivePalettes.Remove(SoundscapePalette);
+		InactivePalettes.Add(SoundscapePalette, ActiveSoundscapePalette);
 	}
 }
+
+static FAutoConsoleCommandWithWorldAndArgs SoundscapeDeterministicCommand(
+	TEXT("Soundscape.Deterministic"),
+	TEXT("Replay identical Soundscape spawn patterns run to run. Usage: Soundscape.Deterministic <WorldSeed> | Off"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		USoundscapeSubsystem* SoundscapeSubsystem = GameInstance ? GameInstance->GetSubsystem<USoundscapeSubsystem>() : nullptr;
+
+		if (SoundscapeSubsystem == nullptr)
+		{
+			UE_LOG(LogSoundscape, Warning, TEXT("Soundscape.Deterministic: No Soundscape Subsystem."));
+			return;
+		}
+
+		const bool bEnabled = Args.Num() == 0 || Args[0].Equals(TEXT("Off"), ESearchCase::IgnoreCase) == false;
+		const int32 WorldSeed = Args.Num() > 0 && bEnabled ? FCString::Atoi(*Args[0]) : 0;
+
+		SoundscapeSubsystem->SetDeterministicSpawning(bEnabled, WorldSeed);
+
+		UE_LOG(LogSoundscape, Display, TEXT("Soundscape.Deterministic: %s, World Seed %d"), bEnabled ? TEXT("On") : TEXT("Off"), WorldSeed);
+	}));
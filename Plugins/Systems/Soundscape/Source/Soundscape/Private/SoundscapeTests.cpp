@@ -0,0 +1,344 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SoundscapeListeners.h"
+#include "SoundscapeScheduler.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SoundscapeTests
+{
+	static FSoundscapeListener MakeListener(const FVector& Location)
+	{
+		FSoundscapeListener Listener;
+		Listener.Location = Location;
+		return Listener;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSoundscapeListenersTest, "Soundscape.Listeners", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSoundscapeListenersTest::RunTest(const FString& Parameters)
+{
+	using SoundscapeTests::MakeListener;
+
+	const float MergeDistance = 1500.0f;
+	TArray<FSoundscapeListener> Clusters;
+
+	// No listeners
+	SoundscapeListeners::ClusterListeners({}, MergeDistance, Clusters);
+	TestEqual(TEXT("No listeners produce no clusters"), Clusters.Num(), 0);
+	TestEqual(TEXT("No clusters select nothing"), SoundscapeListeners::SelectClusterForSpawn({}, 4), (int32)INDEX_NONE);
+
+	// Single player
+	{
+		const FSoundscapeListener Listeners[] = { MakeListener(FVector(100.0f, 0.0f, 0.0f)) };
+		SoundscapeListeners::ClusterListeners(Listeners, MergeDistance, Clusters);
+
+		if (TestEqual(TEXT("Single listener is its own cluster"), Clusters.Num(), 1))
+		{
+			TestEqual(TEXT("Single listener cluster sits on the listener"), Clusters[0].Location, Listeners[0].Location);
+		}
+	}
+
+	// Two players standing together share voices
+	{
+		const FSoundscapeListener Listeners[] = { MakeListener(FVector(0.0f)), MakeListener(FVector(200.0f, 0.0f, 0.0f)) };
+		SoundscapeListeners::ClusterListeners(Listeners, MergeDistance, Clusters);
+
+		if (TestEqual(TEXT("Nearby listeners merge"), Clusters.Num(), 1))
+		{
+			TestEqual(TEXT("Merged cluster counts both listeners"), Clusters[0].NumMerged, 2);
+			TestEqual(TEXT("Merged cluster sits at the centroid"), Clusters[0].Location, FVector(100.0f, 0.0f, 0.0f));
+		}
+	}
+
+	// Two players far apart each get their own voices
+	{
+		const FSoundscapeListener Listeners[] = { MakeListener(FVector(0.0f)), MakeListener(FVector(10000.0f, 0.0f, 0.0f)) };
+		SoundscapeListeners::ClusterListeners(Listeners, MergeDistance, Clusters);
+
+		TestEqual(TEXT("Distant listeners do not merge"), Clusters.Num(), 2);
+		TestEqual(TEXT("Voice is attributed to its nearest cluster"), SoundscapeListeners::FindNearestCluster(FVector(9000.0f, 0.0f, 0.0f), Clusters), 1);
+	}
+
+	// Four players in two groups
+	{
+		const FSoundscapeListener Listeners[] =
+		{
+			MakeListener(FVector(0.0f)),
+			MakeListener(FVector(10000.0f, 0.0f, 0.0f)),
+			MakeListener(FVector(300.0f, 0.0f, 0.0f)),
+			MakeListener(FVector(10000.0f, 400.0f, 0.0f))
+		};
+
+		SoundscapeListeners::ClusterListeners(Listeners, MergeDistance, Clusters);
+		TestEqual(TEXT("Four listeners in two groups make two clusters"), Clusters.Num(), 2);
+	}
+
+	// Spawn budget distribution
+	{
+		const int32 EmptyClusters[] = { 0, 0 };
+		TestEqual(TEXT("First voice goes to the first cluster"), SoundscapeListeners::SelectClusterForSpawn(EmptyClusters, 4), 0);
+
+		const int32 OneVoiceInFirst[] = { 1, 0 };
+		TestEqual(TEXT("Next voice goes to the cluster with the fewest voices"), SoundscapeListeners::SelectClusterForSpawn(OneVoiceInFirst, 4), 1);
+
+		const int32 BudgetSpent[] = { 2, 2 };
+		TestEqual(TEXT("No voice once every cluster has its share"), SoundscapeListeners::SelectClusterForSpawn(BudgetSpent, 4), (int32)INDEX_NONE);
+
+		const int32 SingleVoiceBudget[] = { 1, 0 };
+		TestEqual(TEXT("Every cluster gets at least one voice"), SoundscapeListeners::SelectClusterForSpawn(SingleVoiceBudget, 1), 1);
+
+		const int32 UnevenClusters[] = { 3, 1 };
+		TestEqual(TEXT("Budget share rounds up"), SoundscapeListeners::SelectClusterForSpawn(UnevenClusters, 5), 1);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSoundscapeSchedulerTest, "Soundscape.Scheduler", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSoundscapeSchedulerTest::RunTest(const FString& Parameters)
+{
+	TArray<FSoundscapeScheduleHandle> DueHandles;
+
+	// Due colors fire once, in fire time order
+	{
+		FSoundscapeColorScheduler Scheduler;
+		const FSoundscapeScheduleHandle Handles[] = { Scheduler.Register(nullptr), Scheduler.Register(nullptr), Scheduler.Register(nullptr) };
+
+		Scheduler.Schedule(Handles[0], 0.3f);
+		Scheduler.Schedule(Handles[1], 0.1f);
+		Scheduler.Schedule(Handles[2], 0.2f);
+		TestEqual(TEXT("Scheduled colors are counted"), Scheduler.GetNumScheduled(), 3);
+
+		Scheduler.Advance(0.05f, DueHandles);
+		TestEqual(TEXT("Nothing fires early"), DueHandles.Num(), 0);
+
+		Scheduler.Advance(0.3f, DueHandles);
+		TestEqual(TEXT("Every due color fires"), DueHandles.Num(), 3);
+
+		if (DueHandles.Num() == 3)
+		{
+			TestEqual(TEXT("Earliest color fires first"), DueHandles[0].SlotIndex, Handles[1].SlotIndex);
+			TestEqual(TEXT("Colors fire in fire time order"), DueHandles[1].SlotIndex, Handles[2].SlotIndex);
+			TestEqual(TEXT("Latest color fires last"), DueHandles[2].SlotIndex, Handles[0].SlotIndex);
+		}
+
+		TestEqual(TEXT("Fired colors are no longer scheduled"), Scheduler.GetNumScheduled(), 0);
+
+		DueHandles.Reset();
+		Scheduler.Advance(1.0f, DueHandles);
+		TestEqual(TEXT("Colors fire once per schedule"), DueHandles.Num(), 0);
+	}
+
+	// Rescheduling replaces the pending update, cancelling drops it
+	{
+		FSoundscapeColorScheduler Scheduler;
+		const FSoundscapeScheduleHandle Rescheduled = Scheduler.Register(nullptr);
+		const FSoundscapeScheduleHandle Cancelled = Scheduler.Register(nullptr);
+
+		Scheduler.Schedule(Rescheduled, 0.1f);
+		Scheduler.Schedule(Rescheduled, 0.5f);
+		Scheduler.Schedule(Cancelled, 0.1f);
+		Scheduler.Cancel(Cancelled);
+
+		TestFalse(TEXT("Cancelled color is not scheduled"), Scheduler.IsScheduled(Cancelled));
+		TestEqual(TEXT("Rescheduling counts once"), Scheduler.GetNumScheduled(), 1);
+
+		DueHandles.Reset();
+		Scheduler.Advance(0.2f, DueHandles);
+		TestEqual(TEXT("Replaced and cancelled updates do not fire"), DueHandles.Num(), 0);
+
+		Scheduler.Advance(0.4f, DueHandles);
+		TestEqual(TEXT("Rescheduled color fires once at its new time"), DueHandles.Num(), 1);
+	}
+
+	// Handles of unregistered colors stay invalid once their slot is reused
+	{
+		FSoundscapeColorScheduler Scheduler;
+		FSoundscapeScheduleHandle Unregistered = Scheduler.Register(nullptr);
+		const FSoundscapeScheduleHandle StaleHandle = Unregistered;
+
+		Scheduler.Schedule(Unregistered, 0.1f);
+		Scheduler.Unregister(Unregistered);
+
+		TestFalse(TEXT("Unregistering invalidates the handle"), Unregistered.IsValid());
+
+		const FSoundscapeScheduleHandle Reused = Scheduler.Register(nullptr);
+		TestEqual(TEXT("Released slot is reused"), Reused.SlotIndex, StaleHandle.SlotIndex);
+
+		Scheduler.Schedule(StaleHandle, 0.0f);
+		TestFalse(TEXT("Stale handle cannot schedule the new occupant"), Scheduler.IsScheduled(Reused));
+		TestEqual(TEXT("Only the new occupant is registered"), Scheduler.GetNumRegistered(), 1);
+
+		DueHandles.Reset();
+		Scheduler.Advance(0.2f, DueHandles);
+		TestEqual(TEXT("Update of an unregistered color does not fire"), DueHandles.Num(), 0);
+	}
+
+	// Paused groups park due updates until they resume
+	{
+		FSoundscapeColorScheduler Scheduler;
+		const int32 Group = Scheduler.CreateGroup();
+		const FSoundscapeScheduleHandle Grouped = Scheduler.Register(nullptr, Group);
+		const FSoundscapeScheduleHandle Ungrouped = Scheduler.Register(nullptr);
+
+		Scheduler.Schedule(Grouped, 0.1f);
+		Scheduler.Schedule(Ungrouped, 0.1f);
+		Scheduler.PauseGroup(Group);
+
+		TestTrue(TEXT("Color of a paused group is paused"), Scheduler.IsPaused(Grouped));
+
+		DueHandles.Reset();
+		Scheduler.Advance(0.2f, DueHandles);
+		TestEqual(TEXT("Only colors outside the paused group fire"), DueHandles.Num(), 1);
+		TestTrue(TEXT("Parked update is still scheduled"), Scheduler.IsScheduled(Grouped));
+
+		Scheduler.ResumeGroup(Group);
+
+		DueHandles.Reset();
+		Scheduler.Advance(0.0f, DueHandles);
+		TestEqual(TEXT("Parked update fires on the first Advance after resuming"), DueHandles.Num(), 1);
+
+		// Rescheduling a parked color replaces the parked update
+		Scheduler.Schedule(Grouped, 0.1f);
+		Scheduler.PauseGroup(Group);
+		Scheduler.Advance(0.2f, DueHandles);
+		Scheduler.Schedule(Grouped, 1.0f);
+		Scheduler.ResumeGroup(Group);
+
+		DueHandles.Reset();
+		Scheduler.Advance(0.0f, DueHandles);
+		TestEqual(TEXT("Replaced parked update does not fire"), DueHandles.Num(), 0);
+
+		Scheduler.Advance(1.0f, DueHandles);
+		TestEqual(TEXT("Rescheduled parked color fires at its new time"), DueHandles.Num(), 1);
+
+		// Destroying a paused group releases its parked updates
+		Scheduler.Schedule(Grouped, 0.1f);
+		Scheduler.PauseGroup(Group);
+		Scheduler.Advance(0.2f, DueHandles);
+		Scheduler.DestroyGroup(Group);
+
+		TestFalse(TEXT("Color leaves its destroyed group"), Scheduler.IsPaused(Grouped));
+
+		DueHandles.Reset();
+		Scheduler.Advance(0.0f, DueHandles);
+		TestEqual(TEXT("Parked update fires once its group is destroyed"), DueHandles.Num(), 1);
+	}
+
+	// Random schedules, cancels and group pauses match a brute force model, with enough churn to compact the heap
+	{
+		const int32 NumColors = 200;
+		const int32 NumGroups = 8;
+		const int32 NumFrames = 2000;
+
+		FRandomStream RandomStream(0);
+		FSoundscapeColorScheduler Scheduler;
+
+		TArray<int32> Groups;
+		TArray<bool> GroupPaused;
+
+		for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+		{
+			Groups.Add(Scheduler.CreateGroup());
+			GroupPaused.Add(false);
+		}
+
+		TArray<FSoundscapeScheduleHandle> Handles;
+		TArray<double> ExpectedFireTimes;
+
+		for (int32 ColorIndex = 0; ColorIndex < NumColors; ++ColorIndex)
+		{
+			Handles.Add(Scheduler.Register(nullptr, Groups[ColorIndex % NumGroups]));
+			ExpectedFireTimes.Add(-1.0);
+		}
+
+		int32 NumMismatchedFrames = 0;
+		int32 NumUpdates = 0;
+
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+		{
+			for (int32 OperationIndex = 0; OperationIndex < 20; ++OperationIndex)
+			{
+				const int32 ColorIndex = RandomStream.RandRange(0, NumColors - 1);
+				const float Operation = RandomStream.FRand();
+
+				if (Operation < 0.8f)
+				{
+					const float Delay = RandomStream.FRandRange(0.0f, 0.5f);
+					Scheduler.Schedule(Handles[ColorIndex], Delay);
+					ExpectedFireTimes[ColorIndex] = Scheduler.GetTime() + Delay;
+				}
+				else if (Operation < 0.9f)
+				{
+					Scheduler.Cancel(Handles[ColorIndex]);
+					ExpectedFireTimes[ColorIndex] = -1.0;
+				}
+				else
+				{
+					const int32 GroupIndex = ColorIndex % NumGroups;
+
+					if (GroupPaused[GroupIndex])
+					{
+						Scheduler.ResumeGroup(Groups[GroupIndex]);
+					}
+					else
+					{
+						Scheduler.PauseGroup(Groups[GroupIndex]);
+					}
+
+					GroupPaused[GroupIndex] = !GroupPaused[GroupIndex];
+				}
+			}
+
+			DueHandles.Reset();
+			Scheduler.Advance(RandomStream.FRandRange(0.0f, 0.05f), DueHandles);
+
+			// A color is due once its fire time has passed and its group is not paused
+			TSet<int32> ExpectedDueSlots;
+
+			for (int32 ColorIndex = 0; ColorIndex < NumColors; ++ColorIndex)
+			{
+				if (ExpectedFireTimes[ColorIndex] >= 0.0 && ExpectedFireTimes[ColorIndex] <= Scheduler.GetTime() && GroupPaused[ColorIndex % NumGroups] == false)
+				{
+					ExpectedDueSlots.Add(Handles[ColorIndex].SlotIndex);
+					ExpectedFireTimes[ColorIndex] = -1.0;
+				}
+			}
+
+			TSet<int32> DueSlots;
+
+			for (const FSoundscapeScheduleHandle& DueHandle : DueHandles)
+			{
+				DueSlots.Add(DueHandle.SlotIndex);
+			}
+
+			if (DueHandles.Num() != ExpectedDueSlots.Num() || DueSlots.Num() != ExpectedDueSlots.Num() || DueSlots.Includes(ExpectedDueSlots) == false)
+			{
+				++NumMismatchedFrames;
+			}
+
+			NumUpdates += DueHandles.Num();
+		}
+
+		int32 NumExpectedScheduled = 0;
+
+		for (double ExpectedFireTime : ExpectedFireTimes)
+		{
+			NumExpectedScheduled += ExpectedFireTime >= 0.0 ? 1 : 0;
+		}
+
+		TestEqual(TEXT("Every frame fires exactly the due colors of unpaused groups"), NumMismatchedFrames, 0);
+		TestEqual(TEXT("Scheduled count matches the model"), Scheduler.GetNumScheduled(), NumExpectedScheduled);
+		TestTrue(TEXT("Colors were updated"), NumUpdates > 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -6,10 +6,14 @@
 #include "Engine/EngineTypes.h"
 #include "Engine/UserDefinedEnum.h"
 #include "UObject/NoExportTypes.h"
+#include "Math/RandomStream.h"
+#include "SoundscapeScheduler.h"
 #include "SoundscapeColor.generated.h"
 
 class USoundBase;
 class UAudioComponent;
+class USoundscapeSubsystem;
+class UActiveSoundscapePalette;
 
 #if WITH_EDITOR
 /** UObject delegate to broadcast parameter changes to ActiveSoundscapeColor instances. */
@@ -46,6 +50,10 @@ struct SOUNDSCAPE_API FSoundscapeColorSpawnSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpawnBehavior", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bContinuouslyRespawn"))
 	float MaxSpawnDelay = 3.0f;
 
+	// Colors with a higher priority spawn first when the Soundscape Subsystem's per-frame spawn budget is spent, lower ones are deferred
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpawnBehavior", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float SpawnPriority = 1.0f;
+
 	// Max number of concurrent Elements of this type playing back at once, will not Spawn New ones until current ones are Finished Playing
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpawnBehavior", meta = (ClampMin = "1", UIMin = "1"))
 	int32 MaxNumberOfSpawnedElements = 1;
@@ -234,28 +242,42 @@ public:
 #endif
 };
 
-UCLASS()
-class SOUNDSCAPE_API UActiveSoundscapeColorVoice : public UObject
+// State of a voice in an Active Soundscape Color's voice table
+enum class ESoundscapeColorVoiceState : uint8
 {
-	GENERATED_BODY()
-
-public:
-	// ~UObject Interface
-	void BeginDestroy();
-	//~UObject Interface End
+	// Idle, on the free-list
+	Free,
+	// Playing, counts against MaxNumberOfSpawnedElements
+	Playing,
+	// Fading out, still counts until its Audio Component finishes
+	Stopping
+};
 
-	UPROPERTY(EditAnywhere)
-	UAudioComponent* AudioComponent = nullptr;
+// Playback parameters of a voice, kept while the voice is virtual so it can be resumed where it would have been
+struct FSoundscapeColorVoiceParams
+{
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	float Volume = 1.0f;
+	float Pitch = 1.0f;
+	float FadeIn = 0.0f;
+	float StartTime = 0.0f;
+
+	// Limited playback duration, zero when the voice plays until its sound finishes
+	float LimitedDuration = 0.0f;
+	float FadeOutTime = 0.0f;
+};
 
-	UPROPERTY(EditAnywhere)
-	FTimerHandle TimerHandle;
+// A voice that would be playing if it were audible and within budget, tracked on a virtual timeline
+struct FSoundscapeColorVirtualVoice
+{
+	FSoundscapeColorVoiceParams Params;
 
-	UPROPERTY(EditAnywhere)
-	bool bFree = false;
+	// Scheduler time the voice was spawned at
+	double SpawnTime = 0.0;
 
-	// Limited duration timer
-	UFUNCTION()
-	void StopLimitedDurationVoice(float FadeOutTime);
+	// Scheduler time the voice would have finished playing
+	double EndTime = 0.0;
 };
 
 UCLASS(BlueprintType, ClassGroup = Soundscape)
@@ -340,30 +362,124 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Soundscape")
 	bool IsPlaying();
 
-	// Timer Update Call
-	UFUNCTION()
-	void UpdateSoundscapeColor();
+	// Scheduler Update Call, returns the number of voices started
+	int32 UpdateSoundscapeColor();
+
+	// Priority of this color's updates under the per-frame spawn budget
+	float GetSpawnPriority() const { return SpawnBehavior.SpawnPriority; }
+
+	// Scheduler group this color's updates belong to, set by the owning Active Soundscape Palette
+	void SetSchedulerGroup(int32 InSchedulerGroup);
+
+	// Palette whose voice budget this color's voices count against
+	void SetOwningPalette(UActiveSoundscapePalette* InOwningPalette);
+
+	// Hash identifying this color (palette, color asset and slot), combined with the world seed in deterministic mode
+	void SetSeedHash(uint32 InSeedHash) { SeedHash = InSeedHash; }
+	uint32 GetSeedHash() const { return SeedHash; }
 
-	// Timer delegate for amortized updates
-	FTimerHandle UpdateTimer;
+	// Seed the stream driving every spawn decision of this color
+	void SetRandomSeed(int32 Seed);
+	int32 GetRandomSeed() const;
+
+	// Number of voices tracked virtually instead of playing
+	int32 GetNumVirtualVoices() const { return VirtualVoices.Num(); }
 
 private:
-	// Internal begin playing and bind FTimer Delegate set first time delays
+	// Resolve the Soundscape Subsystem's scheduler, null if there is no Subsystem
+	FSoundscapeColorScheduler* GetScheduler();
+
+	// Schedule the next amortized update at the earliest of the next spawn, voice expiry and virtual voice update
+	void ScheduleNextUpdate();
+
+	// Internal begin playing and schedule the first update after the first time delay
 	void StartPlaying();
 
-	// Internal stop playing, tear down FTimer delegate, etc.
+	// Internal stop playing, cancel the scheduled update, etc.
 	void StopPlaying();
 
-	// Internal update call
-	void Update();
+	// Internal update call, Time is the scheduler time of the update, returns the number of voices started
+	int32 Update(double Time);
+
+	// Take a voice from the free-list, or grow the voice table if there is none
+	int32 AcquireVoice(UWorld* World);
+
+	// Start playing a voice, returns its index
+	int32 StartVoice(UWorld* World, double Time, const FSoundscapeColorVoiceParams& Params);
 
-	// Audio Component Pool
+	// True if a voice with these parameters would be heard by any listener, based on the sound's attenuation
+	bool IsAudible(const FSoundscapeColorVoiceParams& Params) const;
+
+	// True if the owning palette has room for another playing voice
+	bool HasPaletteVoiceBudget() const;
+
+	// Track a voice virtually instead of playing it
+	void VirtualizeVoice(double Time, const FSoundscapeColorVoiceParams& Params);
+
+	// Resume virtual voices that have become audible and retire the ones that would have finished, returns the number resumed
+	int32 UpdateVirtualVoices(double Time);
+
+	// Return a voice to the free-list
+	void ReleaseVoice(int32 VoiceIndex);
+
+	// Fade out every limited duration voice whose playback time has run out
+	void ExpireVoices(double Time);
+
+	// Bound to each voice's Audio Component, frees the voice when playback finishes
+	void OnVoiceFinished(UAudioComponent* AudioComponent, int32 VoiceIndex);
+
+	// Voice table, one entry per voice in each array
 	UPROPERTY()
-	TArray<UActiveSoundscapeColorVoice*> SoundscapeColorVoicePool;
+	TArray<UAudioComponent*> VoiceAudioComponents;
+	TArray<ESoundscapeColorVoiceState> VoiceStates;
+	TArray<double> VoiceExpiryTimes;
+	TArray<float> VoiceFadeOutTimes;
+	TArray<FVector> VoiceLocations;
+
+	// Indices of idle voices
+	TArray<int32> FreeVoices;
+
+	// Indices of voices with a pending limited duration expiry
+	TArray<int32> LimitedDurationVoices;
+
+	// Number of voices Playing or Stopping
+	int32 NumActiveVoices = 0;
+
+	// Whether a voice counts against MaxNumberOfSpawnedElements, the voices NumActiveVoices counts
+	bool IsVoiceActive(int32 VoiceIndex) const { return VoiceStates[VoiceIndex] != ESoundscapeColorVoiceState::Free; }
+
+	// Scheduler time of the earliest limited duration expiry
+	double NextVoiceExpiryTime = TNumericLimits<double>::Max();
+
+	// Scheduler time of the next spawn update
+	double NextSpawnTime = TNumericLimits<double>::Max();
+
+	// Voices out of range or over the palette budget
+	TArray<FSoundscapeColorVirtualVoice> VirtualVoices;
+
+	// Scheduler time virtual voices are next checked for audibility
+	double NextVirtualVoiceUpdateTime = TNumericLimits<double>::Max();
+
+	// Palette whose voice budget this color's voices count against
+	TWeakObjectPtr<UActiveSoundscapePalette> OwningPalette;
+
+	// Stream for spawn timing, placement, rotation and modulation
+	FRandomStream RandomStream;
+
+	uint32 SeedHash = 0;
 
 	// Is Playing Bool
 	bool bIsPlaying = false;
 
 	// First Spawn
 	bool bFirstSpawn = true;
+
+	// Subsystem owning the scheduler this color is registered with
+	TWeakObjectPtr<USoundscapeSubsystem> SoundscapeSubsystem;
+
+	// Handle for amortized updates
+	FSoundscapeScheduleHandle ScheduleHandle;
+
+	// Scheduler group, INDEX_NONE when the color is not owned by a palette
+	int32 SchedulerGroup = INDEX_NONE;
 };
\ No newline at end of file
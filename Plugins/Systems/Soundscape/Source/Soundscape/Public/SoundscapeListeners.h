@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAudioDevice;
+
+// Listener position and orientation Soundscape voices are placed around
+struct SOUNDSCAPE_API FSoundscapeListener
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Forward = FVector::ForwardVector;
+	FVector Up = FVector::UpVector;
+
+	// Number of listeners merged into this one
+	int32 NumMerged = 1;
+};
+
+namespace SoundscapeListeners
+{
+	// Gather every listener of an audio device, one per local player in split screen
+	SOUNDSCAPE_API void GatherListeners(const FAudioDevice* AudioDevice, TArray<FSoundscapeListener>& OutListeners);
+
+	/**
+	* Merge listeners closer than MergeDistance to each other, so nearby local players share the same voices.
+	* A merged listener sits at the centroid of its listeners and keeps the orientation of the first one.
+	*/
+	SOUNDSCAPE_API void ClusterListeners(TConstArrayView<FSoundscapeListener> Listeners, float MergeDistance, TArray<FSoundscapeListener>& OutClusters);
+
+	// Index of the cluster nearest to a location, INDEX_NONE if there are no clusters
+	SOUNDSCAPE_API int32 FindNearestCluster(const FVector& Location, TConstArrayView<FSoundscapeListener> Clusters);
+
+	/**
+	* Pick the cluster a color's next voice should be spawned around. The color's MaxVoices budget is split across clusters,
+	* each cluster getting at least one voice, and the cluster with the fewest active voices goes first.
+	* Returns INDEX_NONE if every cluster is at its share of the budget.
+	*/
+	SOUNDSCAPE_API int32 SelectClusterForSpawn(TConstArrayView<int32> ActiveVoicesPerCluster, int32 MaxVoices);
+}
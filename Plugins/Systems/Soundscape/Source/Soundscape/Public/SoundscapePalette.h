@@ -10,6 +10,7 @@
 
 class USoundscapeColor;
 class UActiveSoundscapeColor;
+class USoundscapeSubsystem;
 
 // Struct storing Modulation State
 USTRUCT(BlueprintType)
@@ -54,6 +55,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SoundscapePalette")
 	TArray<FSoundscapePaletteColor> Colors;
 
+	// Max number of voices playing at once across all the palette's Colors, further voices are tracked virtually until there is room. Zero for no limit
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SoundscapePalette", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxActiveVoices = 0;
+
 	//~ Begin UObject Interface
 	virtual void PostLoad() override;
 	virtual void Serialize(FArchive& Ar) override;
@@ -67,6 +72,10 @@ class SOUNDSCAPE_API UActiveSoundscapePalette : public UObject
 	GENERATED_BODY()
 
 public:
+	// ~UObject Interface
+	virtual void BeginDestroy() override;
+	//~UObject Interface End
+
 	void InitializeSettings(UObject* WorldContextObject, USoundscapePalette* SoundscapePalette);
 
 	UFUNCTION(BlueprintCallable, Category = "Soundscape")
@@ -75,6 +84,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Soundscape")
 	void Stop();
 
+	// Pause the amortized updates of every color in the palette, voices already playing are left alone
+	UFUNCTION(BlueprintCallable, Category = "Soundscape")
+	void Pause();
+
+	// Resume the amortized updates of every color in the palette
+	UFUNCTION(BlueprintCallable, Category = "Soundscape")
+	void Resume();
+
+	UFUNCTION(BlueprintCallable, Category = "Soundscape")
+	bool IsPaused() const;
+
+	// Seed every color's random stream according to the Subsystem's determinism mode
+	void SeedColors();
+
+	// Voice budget shared by the palette's colors
+	bool HasVoiceBudget() const { return MaxActiveVoices <= 0 || NumActiveVoices < MaxActiveVoices; }
+	void AddActiveVoice() { ++NumActiveVoices; }
+	void RemoveActiveVoice() { NumActiveVoices = FMath::Max(NumActiveVoices - 1, 0); }
+
 private:
 	UPROPERTY()
 	UWorld* World;
@@ -82,4 +110,14 @@ private:
 	UPROPERTY()
 	TArray<UActiveSoundscapeColor*> ActiveSoundscapeColors;
 
+	// Subsystem owning the scheduler group
+	TWeakObjectPtr<USoundscapeSubsystem> SoundscapeSubsystem;
+
+	// Scheduler group shared by every color in the palette
+	int32 SchedulerGroup = INDEX_NONE;
+
+	// Voice budget from the palette settings, and voices currently playing against it
+	int32 MaxActiveVoices = 0;
+	int32 NumActiveVoices = 0;
+
 };
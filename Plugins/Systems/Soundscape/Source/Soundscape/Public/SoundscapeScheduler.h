@@ -0,0 +1,144 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UActiveSoundscapeColor;
+
+// Handle to an Active Soundscape Color registered with the Soundscape Color Scheduler
+struct SOUNDSCAPE_API FSoundscapeScheduleHandle
+{
+	int32 SlotIndex = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return SlotIndex != INDEX_NONE; }
+	void Invalidate() { SlotIndex = INDEX_NONE; Serial = 0; }
+};
+
+// A due color update waiting for the Soundscape Subsystem's per-frame spawn budget
+struct SOUNDSCAPE_API FSoundscapePendingColorUpdate
+{
+	FSoundscapeScheduleHandle Handle;
+	float Priority = 0.0f;
+	double DueTime = 0.0;
+
+	// Heap order, highest priority first then earliest due
+	bool operator<(const FSoundscapePendingColorUpdate& Other) const
+	{
+		return Priority != Other.Priority ? Priority > Other.Priority : DueTime < Other.DueTime;
+	}
+};
+
+/**
+* Schedules the amortized updates of every Active Soundscape Color from a single binary heap keyed by next fire time.
+* Due colors are collected in one batch per Advance. Colors can be grouped (one group per Active Soundscape Palette)
+* so that a whole palette can be paused or resumed with a flag flip; updates that come due while paused are parked
+* on the group and fire on the first Advance after the group resumes.
+*/
+class SOUNDSCAPE_API FSoundscapeColorScheduler
+{
+public:
+	// Register a color under an optional group, returns the handle used to schedule it
+	FSoundscapeScheduleHandle Register(UActiveSoundscapeColor* Color, int32 GroupIndex = INDEX_NONE);
+
+	// Unregister a color and invalidate its handle, any pending update is dropped
+	void Unregister(FSoundscapeScheduleHandle& Handle);
+
+	// Schedule the next update of a color Delay seconds from now, replacing any pending update
+	void Schedule(const FSoundscapeScheduleHandle& Handle, float Delay);
+
+	// Schedule the next update of a color at an absolute scheduler time, replacing any pending update
+	void ScheduleAt(const FSoundscapeScheduleHandle& Handle, double FireTime);
+
+	// Drop the pending update of a color
+	void Cancel(const FSoundscapeScheduleHandle& Handle);
+
+	// Returns true if the color has an update pending (including parked updates)
+	bool IsScheduled(const FSoundscapeScheduleHandle& Handle) const;
+
+	// Returns the color registered under a handle, null if it has been unregistered or garbage collected
+	UActiveSoundscapeColor* GetColor(const FSoundscapeScheduleHandle& Handle) const;
+
+	// Create a group of colors that can be paused together
+	int32 CreateGroup();
+
+	// Destroy a group, colors still registered under it are moved out of the group
+	void DestroyGroup(int32 GroupIndex);
+
+	// Move a registered color into a group
+	void SetGroup(const FSoundscapeScheduleHandle& Handle, int32 GroupIndex);
+
+	// Pause every color in a group
+	void PauseGroup(int32 GroupIndex);
+
+	// Resume every color in a group, parked updates fire on the next Advance
+	void ResumeGroup(int32 GroupIndex);
+
+	bool IsGroupPaused(int32 GroupIndex) const;
+
+	// Returns true if the color belongs to a paused group
+	bool IsPaused(const FSoundscapeScheduleHandle& Handle) const;
+
+	// Advance the scheduler clock and collect every color due this frame, in fire time order
+	void Advance(float DeltaTime, TArray<FSoundscapeScheduleHandle>& OutDueHandles);
+
+	// Scheduler clock in seconds
+	double GetTime() const { return CurrentTime; }
+
+	// Number of colors with a pending update
+	int32 GetNumScheduled() const { return NumScheduled; }
+
+	// Number of registered colors
+	int32 GetNumRegistered() const { return Slots.Num() - FreeSlots.Num(); }
+
+	// Release every slot and group
+	void Reset();
+
+private:
+	struct FSlot
+	{
+		TWeakObjectPtr<UActiveSoundscapeColor> Color;
+		int32 GroupIndex = INDEX_NONE;
+		uint32 Serial = 0;
+		uint32 ScheduleSerial = 0;
+		bool bRegistered = false;
+		bool bScheduled = false;
+	};
+
+	struct FHeapEntry
+	{
+		double FireTime;
+		int32 SlotIndex;
+		uint32 ScheduleSerial;
+
+		bool operator<(const FHeapEntry& Other) const { return FireTime < Other.FireTime; }
+	};
+
+	struct FGroup
+	{
+		TArray<FHeapEntry> ParkedEntries;
+		bool bAllocated = false;
+		bool bPaused = false;
+	};
+
+	FSlot* FindSlot(const FSoundscapeScheduleHandle& Handle);
+	const FSlot* FindSlot(const FSoundscapeScheduleHandle& Handle) const;
+
+	bool IsEntryCurrent(const FHeapEntry& Entry) const;
+
+	// Drop stale heap entries once they outnumber the live ones
+	void CompactHeap();
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	TArray<FHeapEntry> Heap;
+
+	TArray<FGroup> Groups;
+	TArray<int32> FreeGroups;
+
+	double CurrentTime = 0.0;
+	int32 NumScheduled = 0;
+};
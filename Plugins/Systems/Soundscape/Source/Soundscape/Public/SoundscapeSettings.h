@@ -24,6 +24,34 @@ public:
 	UPROPERTY(config, EditAnywhere)
 	bool bDebugDraw = false;
 
+	// Split screen listeners closer than this share the same Soundscape voices
+	UPROPERTY(config, EditAnywhere, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float ListenerMergeDistance = 1500.0f;
+
+	// How often, in seconds, voices that are out of range or over their palette's budget are checked for resuming
+	UPROPERTY(config, EditAnywhere, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float VirtualVoiceUpdateInterval = 0.5f;
+
+	// Most voices started by Soundscape Colors per frame, further spawns are deferred to later frames by priority. Zero for no limit
+	UPROPERTY(config, EditAnywhere, meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxSpawnsPerFrame = 4;
+
+	// Most time, in milliseconds, spent updating Soundscape Colors per frame, further updates are deferred to later frames by priority. Zero for no limit
+	UPROPERTY(config, EditAnywhere, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float MaxSpawnTimePerFrameMs = 1.0f;
+
+	// Colors without a first spawn delay get a random one up to this many seconds, spreading palette transitions over several frames
+	UPROPERTY(config, EditAnywhere, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float FirstSpawnJitter = 0.25f;
+
+	// Seed every color's spawn decisions from its palette, color and the world seed, so runs replay identical spawn patterns
+	UPROPERTY(config, EditAnywhere)
+	bool bDeterministicSpawning = false;
+
+	// World seed used when spawning is deterministic
+	UPROPERTY(config, EditAnywhere, meta = (EditCondition = "bDeterministicSpawning"))
+	int32 DeterministicSeed = 0;
+
 public:
 
 	// Beginning of UDeveloperSettings Interface
@@ -6,11 +6,17 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "GameplayTagContainer.h"
 #include "Audio.h"
+#include "Tickable.h"
+#include "Engine/StreamableManager.h"
+#include "SoundscapeScheduler.h"
+#include "SoundscapeListeners.h"
 #include "SoundscapeSubsystem.generated.h"
 
 class USoundscapePalette;
 class UActiveSoundscapePalette;
+class UActiveSoundscapeColor;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSoundscapePaletteCollectionLoaded, FName, PaletteCollectionName);
 
 // Struct 
 USTRUCT(BlueprintType)
@@ -38,7 +44,7 @@ struct SOUNDSCAPE_API FSoundscapePaletteCollectionLoaded
  * 
  */
 UCLASS()
-class SOUNDSCAPE_API USoundscapeSubsystem : public UGameInstanceSubsystem
+class SOUNDSCAPE_API USoundscapeSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 	
@@ -49,6 +55,14 @@ public:
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 	// End USubsystem
 
+	// Begin FTickableGameObject
+	void Tick(float DeltaTime) override;
+	bool IsTickable() const override;
+	bool IsTickableInEditor() const override;
+	bool IsTickableWhenPaused() const override;
+	TStatId GetStatId() const override;
+	// End FTickableGameObject
+
 
 	// Settings
 public:
@@ -65,8 +79,52 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Soundscape")
 	bool RemovePaletteCollection(FName PaletteCollectionName);
 
+	// Returns true once every palette of an added collection is resident and can play
+	UFUNCTION(BlueprintCallable, Category = "Soundscape")
+	bool IsPaletteCollectionLoaded(FName PaletteCollectionName) const;
+
+	// Start streaming a collection's palettes without adding it, so a later AddPaletteCollection of the same collection resolves without waiting
+	UFUNCTION(BlueprintCallable, Category = "Soundscape")
+	void PrefetchPaletteCollection(FName PaletteCollectionName, FSoundscapePaletteCollection PaletteCollection);
+
+	// Release a prefetch, its palettes may be unloaded unless an added collection holds them
+	UFUNCTION(BlueprintCallable, Category = "Soundscape")
+	void ReleasePrefetchedPaletteCollection(FName PaletteCollectionName);
+
+	// Seed every color from its palette, color and the world seed so spawn patterns replay identically, reseeds existing colors
+	UFUNCTION(BlueprintCallable, Category = "Soundscape")
+	void SetDeterministicSpawning(bool bEnabled, int32 WorldSeed = 0);
+
+	UFUNCTION(BlueprintCallable, Category = "Soundscape")
+	bool IsDeterministicSpawning() const { return bDeterministicSpawning; }
+
+	// Seed a color's random stream according to the determinism mode
+	void SeedColor(UActiveSoundscapeColor* ActiveSoundscapeColor) const;
+
+	// Broadcast when an added collection's palettes have finished streaming in
+	UPROPERTY(BlueprintAssignable, Category = "Soundscape")
+	FOnSoundscapePaletteCollectionLoaded OnPaletteCollectionLoaded;
+
 	bool bDebugMode = false;
 
+	// Scheduler driving the amortized updates of every Active Soundscape Color
+	FSoundscapeColorScheduler& GetColorScheduler() { return ColorScheduler; }
+	const FSoundscapeColorScheduler& GetColorScheduler() const { return ColorScheduler; }
+
+	// This frame's listeners, with nearby split screen listeners merged
+	const TArray<FSoundscapeListener>& GetListenerClusters() const { return ListenerClusters; }
+
+	// This frame's listeners, one per local player
+	const TArray<FSoundscapeListener>& GetListeners() const { return Listeners; }
+
+	float GetVirtualVoiceUpdateInterval() const { return VirtualVoiceUpdateInterval; }
+
+	// Upper bound of the random delay added to first spawns
+	float GetFirstSpawnJitter() const { return FirstSpawnJitter; }
+
+	// Number of due color updates deferred by the per-frame spawn budget
+	int32 GetNumDeferredColorUpdates() const { return PendingColorUpdates.Num(); }
+
 private:
 	UPROPERTY()
 	TSet<USoundscapePalette*> LoadedPaletteCollectionSet;
@@ -79,13 +137,68 @@ private:
 	UPROPERTY()
 	TMap<USoundscapePalette*, UActiveSoundscapePalette*> ActivePalettes;
 
+	// Stopped Active Soundscape Palettes, kept for reuse when their palette matches again
+	UPROPERTY()
+	TMap<USoundscapePalette*, UActiveSoundscapePalette*> InactivePalettes;
+
+	// Gameplay tags referenced by each loaded palette's playback conditions, mapped to those palettes
+	TMap<FGameplayTag, TArray<USoundscapePalette*>> PaletteTagIndex;
+
 	bool LoadPaletteCollection(FName PaletteCollectionName);
 
 	bool UnloadPaletteCollection(FName PaletteCollectionName);
 
+	// Called when a collection's palettes are resident, adds them to the loaded set
+	void OnPaletteCollectionStreamed(FName PaletteCollectionName);
+
+	FStreamableManager StreamableManager;
+
+	// Handles keeping each added collection's palettes loading or resident
+	TMap<FName, TSharedPtr<FStreamableHandle>> PaletteCollectionHandles;
+
+	// Handles keeping prefetched collections' palettes loading or resident
+	TMap<FName, TSharedPtr<FStreamableHandle>> PrefetchHandles;
+
+	// Added collections whose palettes are resident
+	TSet<FName> LoadedPaletteCollectionNames;
+
+	// Re-index and evaluate every loaded palette, used when the loaded set changes
 	void UpdateState();
 
+	// Evaluate only the palettes whose playback conditions reference the changed tag or one of its parents
+	void UpdateStateForTag(FGameplayTag ChangedTag);
+
+	void RebuildPaletteTagIndex();
+
+	// Start or stop a palette according to its playback conditions
+	void EvaluatePalette(USoundscapePalette* SoundscapePalette);
+
 private:
 
 	Audio::FDeviceId AudioDeviceID;
+
+	FSoundscapeColorScheduler ColorScheduler;
+
+	// Colors due this frame, kept to avoid reallocating every Tick
+	TArray<FSoundscapeScheduleHandle> DueColorHandles;
+
+	// Heap of due color updates waiting for spawn budget, carried over to the next frame when the budget runs out
+	TArray<FSoundscapePendingColorUpdate> PendingColorUpdates;
+
+	// Listeners gathered from the audio device every Tick, and their clusters
+	TArray<FSoundscapeListener> Listeners;
+	TArray<FSoundscapeListener> ListenerClusters;
+
+	float ListenerMergeDistance = 1500.0f;
+
+	float VirtualVoiceUpdateInterval = 0.5f;
+
+	int32 MaxSpawnsPerFrame = 4;
+	float MaxSpawnTimePerFrameMs = 1.0f;
+	float FirstSpawnJitter = 0.25f;
+
+	bool bDeterministicSpawning = false;
+	int32 DeterministicSeed = 0;
+
+	bool bInitialized = false;
 };
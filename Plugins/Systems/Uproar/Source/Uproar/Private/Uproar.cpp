@@ -19,5 +19,7 @@ void FUproarModule::ShutdownModule()
 	
 DEFINE_LOG_CATEGORY(LogUproar);
 
+UE_TRACE_CHANNEL_DEFINE(UproarChannel);
+
 IMPLEMENT_MODULE(FUproarModule, Uproar)
 
@@ -15,19 +15,44 @@
 
 UUproarChaosListenerComponent::UUproarChaosListenerComponent()
 	: ParentActor(nullptr)
-	, bInitialized(false)
 {
+	// Events are dispatched by the Uproar Subsystem, this component only ticks while waiting for a Geometry Collection to listen to
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UUproarChaosListenerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	InitializeComponent();
+
+	// The Geometry Collection Component may be created after the owner begins play, keep trying until it shows up
+	if (ParentsGeometryCollectionComponents.Num() == 0)
+	{
+		SetComponentTickEnabled(true);
+	}
 }
 
 void UUproarChaosListenerComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
-	// Initialization requires registering with a child component that may not be created yet, so we try until we succeed
-	if (!bInitialized)
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	InitializeComponent();
+
+	if (ParentsGeometryCollectionComponents.Num() > 0)
 	{
-		InitializeComponent();
+		SetComponentTickEnabled(false);
 	}
 }
 
+void UUproarChaosListenerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterChaosEvents();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UUproarChaosListenerComponent::OnBreakEvent(const FChaosBreakEvent& ChaosBreakEvent)
 {
 	UWorld* World = GetWorld();
@@ -37,21 +62,8 @@ void UUproarChaosListenerComponent::OnBreakEvent(const FChaosBreakEvent& ChaosBr
 		// Get length of Angular Velocity vector
 		float AngularVelocityLength = ChaosBreakEvent.AngularVelocity.Size();
 
-		// Initialize our Physical Surface Type
-		EPhysicalSurface PhysicalSurfaceType = EPhysicalSurface::SurfaceType_Default;
-
-		// Cast to Static Mesh
-		if (UStaticMeshComponent* StaticMeshComponent = static_cast<UStaticMeshComponent*>(ChaosBreakEvent.Component))
-		{
-			// Retrieve Physical Surface type off Geometry
-			UPhysicalMaterial* GCCPhysMat = ChaosBreakEvent.Component->GetMaterial(0)->GetPhysicalMaterial();
-
-			// If Physical Material is valid, get listed SurfaceType
-			if (GCCPhysMat)
-			{
-				PhysicalSurfaceType = GCCPhysMat->SurfaceType;
-			}
-		}
+		// Retrieve Physical Surface type off Geometry, resolved once per material slot
+		EPhysicalSurface PhysicalSurfaceType = SurfaceTypeCache.GetSurfaceType(ChaosBreakEvent.Component);
 
 		// Make sure Settings are still valid
 		if (UproarChaosBreakEventSettings)
@@ -111,21 +123,8 @@ void UUproarChaosListenerComponent::OnCollisionEvent(const FChaosPhysicsCollisio
 		// Get length of Velocity vector
 		float VelocityLength = ChaosPhysicsCollisionInfo.Velocity.Size();
 
-		// Initialize our Physical Surface Type
-		EPhysicalSurface PhysicalSurfaceType = EPhysicalSurface::SurfaceType_Default;
-
-		// Cast to Static Mesh
-		if (UStaticMeshComponent* StaticMeshComponent = static_cast<UStaticMeshComponent*>(ChaosPhysicsCollisionInfo.Component))
-		{
-			// Retrieve Physical Surface type off Geometry
-			UPhysicalMaterial* GCCPhysMat = ChaosPhysicsCollisionInfo.Component->GetMaterial(0)->GetPhysicalMaterial();
-
-			// If Physical Material is valid, get listed SurfaceType
-			if (GCCPhysMat)
-			{
-				PhysicalSurfaceType = GCCPhysMat->SurfaceType;
-			}
-		}
+		// Retrieve Physical Surface type off Geometry, resolved once per material slot
+		EPhysicalSurface PhysicalSurfaceType = SurfaceTypeCache.GetSurfaceType(ChaosPhysicsCollisionInfo.Component);
 
 		// Make sure Settings are still valid
 		if (UproarChaosCollisionEventSettings)
@@ -211,23 +210,36 @@ void UUproarChaosListenerComponent::InitializeComponent()
 
 void UUproarChaosListenerComponent::RegisterChaosEvents(UGeometryCollectionComponent* GeometryCollectionComponent)
 {
-	if (GeometryCollectionComponent)
+	UWorld* World = GetWorld();
+
+	if (World && GeometryCollectionComponent)
 	{
-		// If we have valid Geometry Collection Component to listen to, try to bind events
-		// This function may be called several times until binding is successful
-		if (!BreakEventDelegate.IsBoundToObject(this))
+		// If UproarSubsystem exists, have it route this Geometry Collection's events to us
+		if (UUproarSubsystem* UproarSubsystem = World->GetSubsystem<UUproarSubsystem>())
 		{
-			BreakEventDelegate.BindUFunction(this, TEXT("OnBreakEvent"));
-			GeometryCollectionComponent->OnChaosBreakEvent.Add(BreakEventDelegate);
+			UproarSubsystem->RegisterChaosListener(GeometryCollectionComponent, this);
 		}
+	}
+}
 
-		if (!PhysicsCollisionDelegate.IsBoundToObject(this))
+void UUproarChaosListenerComponent::UnregisterChaosEvents()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UUproarSubsystem* UproarSubsystem = World->GetSubsystem<UUproarSubsystem>())
 		{
-			PhysicsCollisionDelegate.BindUFunction(this, TEXT("OnCollisionEvent"));
-			GeometryCollectionComponent->OnChaosPhysicsCollision.Add(PhysicsCollisionDelegate);
+			for (UGeometryCollectionComponent* GeometryCollectionComponent : ParentsGeometryCollectionComponents)
+			{
+				UproarSubsystem->UnregisterChaosListener(GeometryCollectionComponent, this);
+			}
 		}
+	}
 
-		// If we've successfully bound both Break and Collision events, flag as initialized
-		bInitialized = (BreakEventDelegate.IsBoundToObject(this) && PhysicsCollisionDelegate.IsBoundToObject(this));
+	// Events of these components are no longer routed to us, drop their cached surfaces
+	for (UGeometryCollectionComponent* GeometryCollectionComponent : ParentsGeometryCollectionComponents)
+	{
+		SurfaceTypeCache.Invalidate(GeometryCollectionComponent);
 	}
-}
\ No newline at end of file
+
+	ParentsGeometryCollectionComponents.Empty();
+}
@@ -2,6 +2,8 @@
 
 
 #include "UproarDataTypes.h"
+#include "Components/PrimitiveComponent.h"
+#include "Materials/MaterialInterface.h"
 
 int32 UproarFunctionLibrary::GenerateUproarSoundDefinitionKey(
 	const TEnumAsByte<EPhysicalSurface> SurfaceType
@@ -33,4 +35,88 @@ int32 UproarFunctionLibrary::GenerateUproarSoundDefinitionKey(
 		+ ((int32)Magnitude	* EventTypeDomain) 
 		+ ((int32)Speed		* MagnitudeDomain) 
 		;
-}
\ No newline at end of file
+}
+
+EPhysicalSurface FUproarSurfaceTypeCache::GetSurfaceType(const UPrimitiveComponent* PrimitiveComponent, int32 MaterialIndex)
+{
+	if (PrimitiveComponent == nullptr || MaterialIndex < 0)
+	{
+		return EPhysicalSurface::SurfaceType_Default;
+	}
+
+	FCachedComponent& CachedComponent = GetCachedComponent(PrimitiveComponent);
+
+	if (!CachedComponent.Slots.IsValidIndex(MaterialIndex))
+	{
+		CachedComponent.Slots.SetNum(MaterialIndex + 1);
+	}
+
+	// Slot materials were already checked for changes this frame, only resolve slots that haven't been yet
+	FCachedSurfaceSlot& CachedSlot = CachedComponent.Slots[MaterialIndex];
+
+	if (!CachedSlot.bResolved)
+	{
+		const UMaterialInterface* MaterialInterface = PrimitiveComponent->GetMaterial(MaterialIndex);
+		CachedSlot.Material = FObjectKey(MaterialInterface);
+		CachedSlot.SurfaceType = ResolveSurfaceType(MaterialInterface);
+		CachedSlot.bResolved = true;
+	}
+
+	return CachedSlot.SurfaceType;
+}
+
+void FUproarSurfaceTypeCache::Invalidate(const UPrimitiveComponent* PrimitiveComponent)
+{
+	CachedComponents.Remove(FObjectKey(PrimitiveComponent));
+}
+
+void FUproarSurfaceTypeCache::Reset()
+{
+	CachedComponents.Reset();
+}
+
+FUproarSurfaceTypeCache::FCachedComponent& FUproarSurfaceTypeCache::GetCachedComponent(const UPrimitiveComponent* PrimitiveComponent)
+{
+	FCachedComponent& CachedComponent = CachedComponents.FindOrAdd(FObjectKey(PrimitiveComponent));
+
+	// Contacts arrive in bursts, so material swaps are only looked for on the first lookup of a frame.
+	// Every slot is tracked, resolved or not, so a slot first looked up later in the frame still sees its current material.
+	if (CachedComponent.ValidatedFrame != GFrameCounter)
+	{
+		const bool bFirstValidation = CachedComponent.ValidatedFrame == MAX_uint64;
+		CachedComponent.ValidatedFrame = GFrameCounter;
+
+		if (CachedComponent.Slots.Num() < PrimitiveComponent->GetNumMaterials())
+		{
+			CachedComponent.Slots.SetNum(PrimitiveComponent->GetNumMaterials());
+		}
+
+		for (int32 MaterialIndex = 0; MaterialIndex < CachedComponent.Slots.Num(); ++MaterialIndex)
+		{
+			FCachedSurfaceSlot& CachedSlot = CachedComponent.Slots[MaterialIndex];
+			const FObjectKey Material(PrimitiveComponent->GetMaterial(MaterialIndex));
+
+			if (bFirstValidation || CachedSlot.Material != Material)
+			{
+				CachedSlot.Material = Material;
+				CachedSlot.bResolved = false;
+			}
+		}
+	}
+
+	return CachedComponent;
+}
+
+EPhysicalSurface FUproarSurfaceTypeCache::ResolveSurfaceType(const UMaterialInterface* MaterialInterface)
+{
+	if (MaterialInterface)
+	{
+		// If Physical Material is valid, get listed SurfaceType
+		if (const UPhysicalMaterial* PhysicalMaterial = MaterialInterface->GetPhysicalMaterial())
+		{
+			return PhysicalMaterial->SurfaceType;
+		}
+	}
+
+	return EPhysicalSurface::SurfaceType_Default;
+}
@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "UproarEventCapture.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Math/RandomStream.h"
+#include "Uproar.h"
+
+namespace UproarEventCapture
+{
+	// File header identifying Uproar captures
+	static constexpr uint32 Magic = 0x55505252; // 'UPRR'
+	static constexpr int32 Version = 1;
+}
+
+FArchive& operator<<(FArchive& Ar, FUproarCapturedEvent& CapturedEvent)
+{
+	FUproarPhysicsListenerEventData& EventData = CapturedEvent.EventData;
+
+	uint8 SurfaceType = EventData.SurfaceType;
+	uint8 PhysicsEventType = (uint8)EventData.PhysicsEventType;
+	uint8 Magnitude = (uint8)EventData.Magnitude;
+	uint8 Speed = (uint8)EventData.Speed;
+
+	Ar << EventData.Location;
+	Ar << SurfaceType;
+	Ar << PhysicsEventType;
+	Ar << Magnitude;
+	Ar << Speed;
+	Ar << EventData.VolumeMod;
+	Ar << CapturedEvent.Timestamp;
+
+	if (Ar.IsLoading())
+	{
+		EventData.SurfaceType = (EPhysicalSurface)FMath::Min<uint8>(SurfaceType, EPhysicalSurface::SurfaceType_Max - 1);
+		EventData.PhysicsEventType = (EUproarPhysicsEventType)FMath::Min<uint8>(PhysicsEventType, (uint8)EUproarPhysicsEventType::EType_MAX - 1);
+		EventData.Magnitude = (EUproarMagnitude)FMath::Min<uint8>(Magnitude, (uint8)EUproarMagnitude::EType_MAX - 1);
+		EventData.Speed = (EUproarSpeed)FMath::Min<uint8>(Speed, (uint8)EUproarSpeed::EType_MAX - 1);
+	}
+
+	return Ar;
+}
+
+bool FUproarEventCapture::SaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = UproarEventCapture::Magic;
+	int32 Version = UproarEventCapture::Version;
+	float CaptureDuration = Duration;
+
+	Writer << Magic;
+	Writer << Version;
+	Writer << CaptureDuration;
+	Writer << const_cast<TArray<FUproarCapturedEvent>&>(Events);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FUproarEventCapture::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+
+	Reader << Magic;
+	Reader << Version;
+
+	if (Magic != UproarEventCapture::Magic || Version != UproarEventCapture::Version)
+	{
+		UE_LOG(LogUproar, Warning, TEXT("%s is not a valid Uproar capture."), *FilePath);
+		return false;
+	}
+
+	Reader << Duration;
+	Reader << Events;
+
+	return !Reader.IsError();
+}
+
+FUproarEventCapture FUproarEventCapture::GenerateSynthetic(float EventsPerSecond, float DurationSeconds, const FVector& Center, float Radius, int32 Seed)
+{
+	FUproarEventCapture Capture;
+	Capture.Duration = FMath::Max(DurationSeconds, 0.0f);
+
+	const int32 NumEvents = FMath::FloorToInt(FMath::Max(EventsPerSecond, 0.0f) * Capture.Duration);
+	const float EventInterval = NumEvents > 0 ? Capture.Duration / NumEvents : 0.0f;
+
+	FRandomStream RandomStream(Seed);
+
+	Capture.Events.Reserve(NumEvents);
+
+	for (int32 i = 0; i < NumEvents; ++i)
+	{
+		FUproarCapturedEvent& CapturedEvent = Capture.Events.AddDefaulted_GetRef();
+		FUproarPhysicsListenerEventData& EventData = CapturedEvent.EventData;
+
+		EventData.Location = Center + FVector(RandomStream.FRandRange(-Radius, Radius), RandomStream.FRandRange(-Radius, Radius), RandomStream.FRandRange(-Radius, Radius));
+		EventData.SurfaceType = (EPhysicalSurface)RandomStream.RandRange(0, EPhysicalSurface::SurfaceType_Max - 1);
+		EventData.PhysicsEventType = (EUproarPhysicsEventType)RandomStream.RandRange(0, (int32)EUproarPhysicsEventType::EType_MAX - 1);
+		EventData.Magnitude = (EUproarMagnitude)RandomStream.RandRange(0, (int32)EUproarMagnitude::EType_MAX - 1);
+		EventData.Speed = (EUproarSpeed)RandomStream.RandRange(0, (int32)EUproarSpeed::EType_MAX - 1);
+		EventData.VolumeMod = RandomStream.FRandRange(0.1f, 1.0f);
+
+		CapturedEvent.Timestamp = i * EventInterval;
+	}
+
+	return Capture;
+}
+
+void FUproarReplayReport::Log() const
+{
+	const double AverageTickMs = NumTicks > 0 ? TotalTickMs / NumTicks : 0.0;
+
+	UE_LOG(LogUproar, Display, TEXT("Uproar Replay: %d events over %d ticks, Accepted: %d, Culled: %d"), NumEvents, NumTicks, NumAcceptedEvents, NumCulledEvents);
+	UE_LOG(LogUproar, Display, TEXT("Uproar Replay: Tick Cost Avg: %.4f ms, Max: %.4f ms, Total: %.4f ms"), AverageTickMs, MaxTickMs, TotalTickMs);
+	UE_LOG(LogUproar, Display, TEXT("Uproar Replay: Occupied Cells Avg: %.1f, Peak: %d"), AverageOccupiedCells, PeakOccupiedCells);
+}
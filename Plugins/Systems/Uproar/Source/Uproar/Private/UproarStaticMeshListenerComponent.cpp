@@ -12,21 +12,25 @@
 UUproarStaticMeshListenerComponent::UUproarStaticMeshListenerComponent()
 	: ParentActor(nullptr)
 	, ParentsStaticMeshComponent(nullptr)
-	, bInitialized(false)
 {
-	// Initialize component tick so that it occurs after Physics for the most immediate physics state
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.SetTickFunctionEnable(true);
-	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+	// Hit events are pushed to this component, it never needs to tick
+	PrimaryComponentTick.bCanEverTick = false;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
-void UUproarStaticMeshListenerComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UUproarStaticMeshListenerComponent::BeginPlay()
 {
-	// Initialization requires registering with a child component that may not be created yet, so we try until we succeed
-	if (!bInitialized)
-	{
-		InitializeComponent();
-	}
+	Super::BeginPlay();
+
+	// Sibling components are all created by the time the owner begins play
+	InitializeComponent();
+}
+
+void UUproarStaticMeshListenerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterPhysicsEvents();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UUproarStaticMeshListenerComponent::OnHitEvent(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, FVector NormalImpulse, const FHitResult& Hit)
@@ -42,21 +46,9 @@ void UUproarStaticMeshListenerComponent::OnHitEvent(UPrimitiveComponent* HitComp
 		// The Max makes sure my GetMass does not return 0.
 		float DeltaVelocityLength = NormalImpulse.Size() / FMath::Max(HitComponent->GetMass(), SMALL_NUMBER);
 
-		// Initialize our Physical Surface Type
-		EPhysicalSurface PhysicalSurfaceType = EPhysicalSurface::SurfaceType_Default;
-
-		// Cast to Static Mesh
-		if (UStaticMeshComponent* StaticMeshComponent = static_cast<UStaticMeshComponent*>(HitComponent))
-		{
-			// Retrieve Physical Surface type off Geometry
-			UPhysicalMaterial* GCCPhysMat = HitComponent->GetMaterial(0)->GetPhysicalMaterial();
-
-			// If Physical Material is valid, get listed SurfaceType
-			if (GCCPhysMat)
-			{
-				PhysicalSurfaceType = GCCPhysMat->SurfaceType;
-			}
-		}
+		// Retrieve the cached Physical Surface type of our own first material slot. The hit's physical material and face index
+		// describe the other body, so they can't tell us what we are made of.
+		EPhysicalSurface PhysicalSurfaceType = SurfaceTypeCache.GetSurfaceType(HitComponent);
 
 		// Make sure Settings are still valid
 		if (UproarStaticMeshHitEventSettings)
@@ -132,8 +124,17 @@ void UUproarStaticMeshListenerComponent::RegisterPhysicsEvents()
 			ParentsStaticMeshComponent->OnComponentHit.Add(HitEventDelegate);
 		}
 
-		// Listener is initialized when its successfully bound to the object
-		bInitialized = HitEventDelegate.IsBoundToObject(this);
 	}
 }
 
+void UUproarStaticMeshListenerComponent::UnregisterPhysicsEvents()
+{
+	if (ParentsStaticMeshComponent)
+	{
+		ParentsStaticMeshComponent->OnComponentHit.Remove(HitEventDelegate);
+		SurfaceTypeCache.Invalidate(ParentsStaticMeshComponent);
+	}
+
+	HitEventDelegate.Unbind();
+}
+
@@ -8,8 +8,127 @@
 #include "Engine/DataTable.h"
 #include "Kismet/GameplayStatics.h"
 #include "AudioDevice.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsSolver.h"
+#include "EventManager.h"
+#include "EventsData.h"
+#include "SolverEventFilters.h"
+#include "UproarChaosListenerComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 #include "Uproar.h"
 
+DECLARE_CYCLE_STAT(TEXT("Uproar Subsystem Tick"), STAT_UproarSubsystemTick, STATGROUP_Uproar);
+DECLARE_CYCLE_STAT(TEXT("Drain Submitted Events"), STAT_UproarDrainSubmittedEvents, STATGROUP_Uproar);
+DECLARE_CYCLE_STAT(TEXT("Update Active Events"), STAT_UproarUpdateActiveEvents, STATGROUP_Uproar);
+DECLARE_CYCLE_STAT(TEXT("Update Active Event Hash"), STAT_UproarUpdateActiveEventHash, STATGROUP_Uproar);
+DECLARE_CYCLE_STAT(TEXT("Generate Active Events"), STAT_UproarGenerateActiveEvents, STATGROUP_Uproar);
+DECLARE_CYCLE_STAT(TEXT("Clear Pending Events"), STAT_UproarClearPendingEvents, STATGROUP_Uproar);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Events"), STAT_UproarPendingEvents, STATGROUP_Uproar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Accepted Events"), STAT_UproarAcceptedEvents, STATGROUP_Uproar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Events"), STAT_UproarCulledEvents, STATGROUP_Uproar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Events"), STAT_UproarActiveEvents, STATGROUP_Uproar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Occupied Hash Cells"), STAT_UproarOccupiedHashCells, STATGROUP_Uproar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dropped Events"), STAT_UproarDroppedEvents, STATGROUP_Uproar);
+
+CSV_DEFINE_CATEGORY(Uproar, true);
+
+// Outcome of a pending event, as reported on the Uproar trace channel
+enum class EUproarEventDecision : uint8
+{
+	Culled,
+	Accepted,
+	NoSoundDefinition,
+};
+
+UE_TRACE_EVENT_BEGIN(Uproar, EventDecision)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(float, LocationX)
+	UE_TRACE_EVENT_FIELD(float, LocationY)
+	UE_TRACE_EVENT_FIELD(float, LocationZ)
+	UE_TRACE_EVENT_FIELD(int32, SoundDefinitionKey)
+	UE_TRACE_EVENT_FIELD(int32, SpatialHashID)
+	UE_TRACE_EVENT_FIELD(uint8, Decision)
+UE_TRACE_EVENT_END()
+
+static void TraceEventDecision(const FUproarActivePhysicsEvent& Event, int32 SpatialHashID, EUproarEventDecision Decision)
+{
+	UE_TRACE_LOG(Uproar, EventDecision, UproarChannel)
+		<< EventDecision.Cycle(FPlatformTime::Cycles64())
+		<< EventDecision.LocationX((float)Event.EventLocation.X)
+		<< EventDecision.LocationY((float)Event.EventLocation.Y)
+		<< EventDecision.LocationZ((float)Event.EventLocation.Z)
+		<< EventDecision.SoundDefinitionKey(Event.PhysicsEventType)
+		<< EventDecision.SpatialHashID(SpatialHashID)
+		<< EventDecision.Decision((uint8)Decision);
+}
+
+namespace UproarConsoleCommands
+{
+	static FString GetCaptureFilePath(const TArray<FString>& Args)
+	{
+		return Args.Num() > 0 ? Args[0] : FPaths::ProfilingDir() / TEXT("Uproar") / TEXT("UproarCapture.uproarcap");
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs StartCapture(
+		TEXT("Uproar.Capture.Start"),
+		TEXT("Start recording Uproar physics events."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UUproarSubsystem* UproarSubsystem = World ? World->GetSubsystem<UUproarSubsystem>() : nullptr)
+			{
+				UproarSubsystem->StartCapture();
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs StopCapture(
+		TEXT("Uproar.Capture.Stop"),
+		TEXT("Stop recording Uproar physics events and save them. Usage: Uproar.Capture.Stop [FilePath]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UUproarSubsystem* UproarSubsystem = World ? World->GetSubsystem<UUproarSubsystem>() : nullptr)
+			{
+				UproarSubsystem->StopCapture(GetCaptureFilePath(Args));
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs Replay(
+		TEXT("Uproar.Replay"),
+		TEXT("Replay a capture through the Uproar Subsystem without playing sounds and log its cost. Usage: Uproar.Replay [FilePath] [TickRate]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UUproarSubsystem* UproarSubsystem = World ? World->GetSubsystem<UUproarSubsystem>() : nullptr)
+			{
+				FUproarEventCapture Capture;
+
+				if (Capture.LoadFromFile(GetCaptureFilePath(Args)))
+				{
+					const float TickRate = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 60.0f;
+					UproarSubsystem->ReplayCapture(Capture, TickRate).Log();
+				}
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs ReplaySynthetic(
+		TEXT("Uproar.Replay.Synthetic"),
+		TEXT("Replay generated events through the Uproar Subsystem without playing sounds and log its cost. Usage: Uproar.Replay.Synthetic [EventsPerSecond] [Seconds] [Radius] [Seed]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UUproarSubsystem* UproarSubsystem = World ? World->GetSubsystem<UUproarSubsystem>() : nullptr)
+			{
+				const float EventsPerSecond = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 50000.0f;
+				const float Seconds = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 10.0f;
+				const float Radius = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 5000.0f;
+				const int32 Seed = Args.Num() > 3 ? FCString::Atoi(*Args[3]) : 0;
+
+				const FUproarEventCapture Capture = FUproarEventCapture::GenerateSynthetic(EventsPerSecond, Seconds, FVector::ZeroVector, Radius, Seed);
+				UproarSubsystem->ReplayCapture(Capture).Log();
+			}
+		}));
+}
+
 
 
 void UUproarSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -45,6 +164,8 @@ void UUproarSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 		MaxLifetime = ProjectSettings->UproarSoundEventLifespanSeconds;
 
+		MaxQueuedEvents = FMath::Max(ProjectSettings->UproarMaxQueuedEvents, 1);
+
 		FSoftObjectPath SoundDefinitionPath = ProjectSettings->UproarSoundDefinition;
 
 
@@ -80,6 +201,9 @@ void UUproarSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 void UUproarSubsystem::Deinitialize()
 {
 	bShouldTick = false;
+
+	UnregisterChaosEvents();
+	ChaosListeners.Empty();
 }
 
 bool UUproarSubsystem::ShouldCreateSubsystem(UObject* Outer) const
@@ -115,11 +239,34 @@ void UUproarSubsystem::Tick(float DeltaTime)
 	// Just in case
 	if (bShouldTick)
 	{
+		CSV_SCOPED_TIMING_STAT(Uproar, Tick);
+
+		const int32 AcceptedEventsBefore = NumAcceptedEvents;
+		const int32 CulledEventsBefore = NumCulledEvents;
+
+		DrainSubmittedEvents();
+
 		UpdateActiveEvents(DeltaTime);
 		UpdateActiveEventHash();
 
+		const int32 NumPendingEvents = PendingEvents.Num();
+
 		GenerateActiveEventsFromPendingEvents();
 		ClearPendingEvents();
+
+		const int32 TickAcceptedEvents = NumAcceptedEvents - AcceptedEventsBefore;
+		const int32 TickCulledEvents = NumCulledEvents - CulledEventsBefore;
+
+		SET_DWORD_STAT(STAT_UproarPendingEvents, NumPendingEvents);
+		SET_DWORD_STAT(STAT_UproarAcceptedEvents, TickAcceptedEvents);
+		SET_DWORD_STAT(STAT_UproarCulledEvents, TickCulledEvents);
+		SET_DWORD_STAT(STAT_UproarActiveEvents, ActiveEvents.Num());
+		SET_DWORD_STAT(STAT_UproarOccupiedHashCells, ActiveEventHash.Num());
+
+		CSV_CUSTOM_STAT(Uproar, PendingEvents, NumPendingEvents, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Uproar, AcceptedEvents, TickAcceptedEvents, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Uproar, CulledEvents, TickCulledEvents, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Uproar, ActiveEvents, ActiveEvents.Num(), ECsvCustomStatOp::Set);
 	}
 }
 
@@ -140,23 +287,441 @@ bool UUproarSubsystem::IsTickableWhenPaused() const
 
 TStatId UUproarSubsystem::GetStatId() const
 {
-	return TStatId();
+	return GET_STATID(STAT_UproarSubsystemTick);
+}
+
+namespace UproarEventStaging
+{
+	// Innermost staging scope open on this thread
+	static thread_local FUproarPhysicsEventStagingScope* ActiveStagingScope = nullptr;
+}
+
+FUproarPhysicsEventStagingScope::FUproarPhysicsEventStagingScope(UUproarSubsystem* InUproarSubsystem)
+	: UproarSubsystem(InUproarSubsystem)
+	, OuterScope(UproarEventStaging::ActiveStagingScope)
+{
+	UproarEventStaging::ActiveStagingScope = this;
+}
+
+FUproarPhysicsEventStagingScope::~FUproarPhysicsEventStagingScope()
+{
+	check(UproarEventStaging::ActiveStagingScope == this);
+	UproarEventStaging::ActiveStagingScope = OuterScope;
+
+	if (UproarSubsystem && StagedEvents.Num() > 0)
+	{
+		UproarSubsystem->SubmitEventBatch(MoveTemp(StagedEvents));
+	}
+}
+
+FUproarPhysicsEventStagingScope* FUproarPhysicsEventStagingScope::Find(const UUproarSubsystem* InUproarSubsystem)
+{
+	for (FUproarPhysicsEventStagingScope* Scope = UproarEventStaging::ActiveStagingScope; Scope; Scope = Scope->OuterScope)
+	{
+		if (Scope->UproarSubsystem == InUproarSubsystem)
+		{
+			return Scope;
+		}
+	}
+
+	return nullptr;
 }
 
 void UUproarSubsystem::PhysicsEvent(const FUproarPhysicsListenerEventData& PhysicsListenerEventData)
 {
-	int32 PhysicsListenerEventHashKey = UproarFunctionLibrary::GenerateUproarSoundDefinitionKey(PhysicsListenerEventData.SurfaceType, PhysicsListenerEventData.PhysicsEventType, PhysicsListenerEventData.Magnitude, PhysicsListenerEventData.Speed);
+	if (FUproarPhysicsEventStagingScope* StagingScope = FUproarPhysicsEventStagingScope::Find(this))
+	{
+		StagingScope->StagedEvents.Add(PhysicsListenerEventData);
+		return;
+	}
+
+	TArray<FUproarPhysicsListenerEventData> EventBatch;
+	EventBatch.Add(PhysicsListenerEventData);
+	SubmitEventBatch(MoveTemp(EventBatch));
+}
+
+void UUproarSubsystem::PhysicsEvents(TConstArrayView<FUproarPhysicsListenerEventData> PhysicsListenerEventData)
+{
+	if (FUproarPhysicsEventStagingScope* StagingScope = FUproarPhysicsEventStagingScope::Find(this))
+	{
+		StagingScope->StagedEvents.Append(PhysicsListenerEventData.GetData(), PhysicsListenerEventData.Num());
+		return;
+	}
+
+	SubmitEventBatch(TArray<FUproarPhysicsListenerEventData>(PhysicsListenerEventData.GetData(), PhysicsListenerEventData.Num()));
+}
+
+void UUproarSubsystem::SubmitEventBatch(TArray<FUproarPhysicsListenerEventData>&& EventBatch)
+{
+	const int32 NumEvents = EventBatch.Num();
+
+	if (NumEvents == 0)
+	{
+		return;
+	}
+
+	// Reserve room for the whole batch, nothing drains the queue while the Subsystem doesn't tick (e.g. while paused)
+	if (NumQueuedEvents.fetch_add(NumEvents, std::memory_order_relaxed) + NumEvents > MaxQueuedEvents)
+	{
+		NumQueuedEvents.fetch_sub(NumEvents, std::memory_order_relaxed);
+		NumDroppedEvents.fetch_add(NumEvents, std::memory_order_relaxed);
+		return;
+	}
+
+	SubmittedEventBatches.Enqueue(MoveTemp(EventBatch));
+}
+
+void UUproarSubsystem::DrainSubmittedEvents()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UproarDrainSubmittedEvents);
+
+	TArray<FUproarPhysicsListenerEventData> SubmittedBatch;
+
+	// Events are stamped with the world time of the tick that drains them
+	const float CaptureTimestamp = bCapturing ? (float)FMath::Max(GetCaptureTime() - CaptureStartTime, 0.0) : 0.0f;
+
+	while (SubmittedEventBatches.Dequeue(SubmittedBatch))
+	{
+		NumQueuedEvents.fetch_sub(SubmittedBatch.Num(), std::memory_order_relaxed);
+
+		for (const FUproarPhysicsListenerEventData& PhysicsListenerEventData : SubmittedBatch)
+		{
+			int32 PhysicsListenerEventHashKey = UproarFunctionLibrary::GenerateUproarSoundDefinitionKey(PhysicsListenerEventData.SurfaceType, PhysicsListenerEventData.PhysicsEventType, PhysicsListenerEventData.Magnitude, PhysicsListenerEventData.Speed);
+
+			FUproarActivePhysicsEvent& CandidateEvent = PendingEvents.AddDefaulted_GetRef();
+
+			CandidateEvent.VolumeMod = PhysicsListenerEventData.VolumeMod;
+			CandidateEvent.EventLocation = PhysicsListenerEventData.Location;
+			CandidateEvent.MaxLifetime = MaxLifetime;
+			CandidateEvent.PhysicsEventType = PhysicsListenerEventHashKey;
+			CandidateEvent.Lifetime = 0.0f;
+
+			if (bCapturing)
+			{
+				FUproarCapturedEvent& CapturedEvent = ActiveCapture.Events.AddDefaulted_GetRef();
+				CapturedEvent.EventData = PhysicsListenerEventData;
+				CapturedEvent.Timestamp = CaptureTimestamp;
+			}
+		}
+	}
+
+	const int32 DroppedEvents = NumDroppedEvents.exchange(0, std::memory_order_relaxed);
+
+	if (DroppedEvents > 0)
+	{
+		UE_LOG(LogUproar, Warning, TEXT("Uproar dropped %d physics events, no more than %d events can wait for the next tick."), DroppedEvents, MaxQueuedEvents);
+	}
+
+	SET_DWORD_STAT(STAT_UproarDroppedEvents, DroppedEvents);
+}
+
+void UUproarSubsystem::StartCapture()
+{
+	ActiveCapture = FUproarEventCapture();
+	CaptureStartTime = GetCaptureTime();
+	bCapturing = true;
+}
+
+bool UUproarSubsystem::StopCapture(const FString& FilePath)
+{
+	if (!bCapturing)
+	{
+		return false;
+	}
+
+	// Record everything submitted up to now
+	DrainSubmittedEvents();
+
+	bCapturing = false;
+	ActiveCapture.Duration = (float)(GetCaptureTime() - CaptureStartTime);
+
+	const bool bSaved = ActiveCapture.SaveToFile(FilePath);
+
+	UE_LOG(LogUproar, Display, TEXT("Uproar capture of %d events over %.2f seconds %s %s"), ActiveCapture.Events.Num(), ActiveCapture.Duration, bSaved ? TEXT("saved to") : TEXT("failed to save to"), *FilePath);
+
+	ActiveCapture = FUproarEventCapture();
+
+	return bSaved;
+}
+
+double UUproarSubsystem::GetCaptureTime() const
+{
+	return SubsystemWorld ? SubsystemWorld->GetTimeSeconds() : 0.0;
+}
+
+FUproarReplayReport UUproarSubsystem::ReplayCapture(const FUproarEventCapture& Capture, float TickRate)
+{
+	FUproarReplayReport Report;
+
+	const float TickDeltaTime = 1.0f / FMath::Max(TickRate, 1.0f);
+	const int32 NumTicks = FMath::Max(FMath::CeilToInt(Capture.Duration / TickDeltaTime), 1);
+
+	// Don't record the replay into a capture in progress
+	const bool bWasCapturing = bCapturing;
+	bCapturing = false;
+	bStubPlayback = true;
+
+	// Anything submitted before the replay belongs to live play, keep it out of the report
+	DrainSubmittedEvents();
+
+	ActiveEvents.Reset();
+	PendingEvents.Reset();
+	ActiveEventHash.Reset();
+
+	NumAcceptedEvents = 0;
+	NumCulledEvents = 0;
+
+	int32 EventIndex = 0;
+	double TotalOccupiedCells = 0.0;
+
+	for (int32 TickIndex = 0; TickIndex < NumTicks; ++TickIndex)
+	{
+		const float TickEndTime = (TickIndex + 1) * TickDeltaTime;
+
+		// Submit every event that happened during this tick
+		{
+			FUproarPhysicsEventStagingScope StagingScope(this);
+
+			while (Capture.Events.IsValidIndex(EventIndex) && (Capture.Events[EventIndex].Timestamp < TickEndTime || TickIndex == NumTicks - 1))
+			{
+				PhysicsEvent(Capture.Events[EventIndex].EventData);
+				++EventIndex;
+			}
+		}
+
+		const double TickStartSeconds = FPlatformTime::Seconds();
+
+		DrainSubmittedEvents();
+
+		UpdateActiveEvents(TickDeltaTime);
+		UpdateActiveEventHash();
+
+		GenerateActiveEventsFromPendingEvents();
+		ClearPendingEvents();
+
+		const double TickMs = (FPlatformTime::Seconds() - TickStartSeconds) * 1000.0;
+
+		Report.TotalTickMs += TickMs;
+		Report.MaxTickMs = FMath::Max(Report.MaxTickMs, TickMs);
+		Report.PeakOccupiedCells = FMath::Max(Report.PeakOccupiedCells, ActiveEventHash.Num());
+		TotalOccupiedCells += ActiveEventHash.Num();
+	}
+
+	Report.NumTicks = NumTicks;
+	Report.NumEvents = EventIndex;
+	Report.NumAcceptedEvents = NumAcceptedEvents;
+	Report.NumCulledEvents = NumCulledEvents;
+	Report.AverageOccupiedCells = TotalOccupiedCells / NumTicks;
+
+	// Leave no replayed events behind for live play
+	ActiveEvents.Reset();
+	PendingEvents.Reset();
+	ActiveEventHash.Reset();
+
+	bStubPlayback = false;
+	bCapturing = bWasCapturing;
+
+	return Report;
+}
+
+void UUproarSubsystem::RegisterChaosListener(UPrimitiveComponent* PrimitiveComponent, UUproarChaosListenerComponent* ChaosListener)
+{
+	if (PrimitiveComponent && ChaosListener)
+	{
+		ChaosListeners.FindOrAdd(FObjectKey(PrimitiveComponent)).AddUnique(ChaosListener);
+
+		// Subscribe lazily so worlds without Chaos listeners never pay for event dispatch
+		if (!bChaosEventsRegistered)
+		{
+			RegisterChaosEvents();
+		}
+	}
+}
+
+void UUproarSubsystem::UnregisterChaosListener(UPrimitiveComponent* PrimitiveComponent, UUproarChaosListenerComponent* ChaosListener)
+{
+	const FObjectKey PrimitiveComponentKey(PrimitiveComponent);
+
+	if (FUproarChaosListenerArray* Listeners = ChaosListeners.Find(PrimitiveComponentKey))
+	{
+		// Other listeners of the same component keep receiving its events, stale ones are dropped along the way
+		Listeners->RemoveAll([ChaosListener](const TWeakObjectPtr<UUproarChaosListenerComponent>& Listener) { return !Listener.IsValid() || Listener.Get() == ChaosListener; });
+
+		if (Listeners->Num() == 0)
+		{
+			ChaosListeners.Remove(PrimitiveComponentKey);
+		}
+	}
+
+	// Stop paying for solver event data nobody listens to
+	if (ChaosListeners.Num() == 0 && bChaosEventsRegistered)
+	{
+		UnregisterChaosEvents();
+	}
+}
+
+const FUproarChaosListenerArray* UUproarSubsystem::FindChaosListeners(const UPrimitiveComponent* PrimitiveComponent) const
+{
+	return ChaosListeners.Find(FObjectKey(PrimitiveComponent));
+}
+
+void UUproarSubsystem::RegisterChaosEvents()
+{
+	if (SubsystemWorld)
+	{
+		if (FPhysScene* PhysicsScene = SubsystemWorld->GetPhysicsScene())
+		{
+			if (Chaos::FPhysicsSolver* Solver = PhysicsScene->GetSolver())
+			{
+				// Make sure the solver generates the event data we listen to, remembering what it did before so it can be restored
+				Chaos::FSolverEventFilters* EventFilters = Solver->GetEventFilters();
+				bSolverGeneratedCollisionData = EventFilters->IsCollisionEventEnabled();
+				bSolverGeneratedBreakingData = EventFilters->IsBreakingEventEnabled();
 
-	FUproarActivePhysicsEvent CandidateEvent;
-	
-	CandidateEvent.VolumeMod = PhysicsListenerEventData.VolumeMod;
-	CandidateEvent.EventLocation = PhysicsListenerEventData.Location;
-	CandidateEvent.MaxLifetime = MaxLifetime;
-	CandidateEvent.PhysicsEventType = PhysicsListenerEventHashKey;
-	CandidateEvent.Lifetime = 0.0f;
+				Solver->SetGenerateCollisionData(true);
+				Solver->SetGenerateBreakingData(true);
 
-	PendingEvents.Add(CandidateEvent);
+				Chaos::FEventManager* EventManager = Solver->GetEventManager();
+				EventManager->RegisterHandler<Chaos::FCollisionEventData>(Chaos::EEventType::Collision, this, &UUproarSubsystem::HandleCollisionEvents);
+				EventManager->RegisterHandler<Chaos::FBreakingEventData>(Chaos::EEventType::Breaking, this, &UUproarSubsystem::HandleBreakingEvents);
 
+				bChaosEventsRegistered = true;
+			}
+		}
+	}
+}
+
+void UUproarSubsystem::UnregisterChaosEvents()
+{
+	if (bChaosEventsRegistered && SubsystemWorld)
+	{
+		if (FPhysScene* PhysicsScene = SubsystemWorld->GetPhysicsScene())
+		{
+			if (Chaos::FPhysicsSolver* Solver = PhysicsScene->GetSolver())
+			{
+				Chaos::FEventManager* EventManager = Solver->GetEventManager();
+				EventManager->UnregisterHandler(Chaos::EEventType::Collision, this);
+				EventManager->UnregisterHandler(Chaos::EEventType::Breaking, this);
+
+				Solver->SetGenerateCollisionData(bSolverGeneratedCollisionData);
+				Solver->SetGenerateBreakingData(bSolverGeneratedBreakingData);
+			}
+		}
+	}
+
+	bChaosEventsRegistered = false;
+}
+
+void UUproarSubsystem::HandleCollisionEvents(const Chaos::FCollisionEventData& CollisionEventData)
+{
+	FPhysScene* PhysicsScene = SubsystemWorld ? SubsystemWorld->GetPhysicsScene() : nullptr;
+
+	if (PhysicsScene == nullptr || ChaosListeners.Num() == 0)
+	{
+		return;
+	}
+
+	DispatchCollisionEvents(CollisionEventData.CollisionData.AllCollisionsArray, [PhysicsScene](IPhysicsProxyBase* Proxy)
+	{
+		return Proxy ? PhysicsScene->GetOwningComponent<UPrimitiveComponent>(Proxy) : nullptr;
+	});
+}
+
+void UUproarSubsystem::DispatchCollisionEvents(TConstArrayView<Chaos::FCollidingData> Collisions, TFunctionRef<UPrimitiveComponent*(IPhysicsProxyBase*)> GetOwningComponent)
+{
+	// Listeners submit their events as one batch per solver callback
+	FUproarPhysicsEventStagingScope StagingScope(this);
+
+	for (const Chaos::FCollidingData& CollidingData : Collisions)
+	{
+		UPrimitiveComponent* Component1 = GetOwningComponent(CollidingData.Proxy1);
+		UPrimitiveComponent* Component2 = GetOwningComponent(CollidingData.Proxy2);
+
+		// Either side of the contact may be a listened to component, dispatch from its point of view
+		if (const FUproarChaosListenerArray* Listeners = Component1 ? FindChaosListeners(Component1) : nullptr)
+		{
+			FChaosPhysicsCollisionInfo CollisionInfo;
+			CollisionInfo.Component = Component1;
+			CollisionInfo.OtherComponent = Component2;
+			CollisionInfo.Location = CollidingData.Location;
+			CollisionInfo.Normal = CollidingData.Normal;
+			CollisionInfo.AccumulatedImpulse = CollidingData.AccumulatedImpulse;
+			CollisionInfo.Velocity = CollidingData.Velocity1;
+			CollisionInfo.OtherVelocity = CollidingData.Velocity2;
+			CollisionInfo.AngularVelocity = CollidingData.AngularVelocity1;
+			CollisionInfo.OtherAngularVelocity = CollidingData.AngularVelocity2;
+			CollisionInfo.Mass = CollidingData.Mass1;
+			CollisionInfo.OtherMass = CollidingData.Mass2;
+
+			for (const TWeakObjectPtr<UUproarChaosListenerComponent>& Listener : *Listeners)
+			{
+				if (UUproarChaosListenerComponent* ChaosListener = Listener.Get())
+				{
+					ChaosListener->OnCollisionEvent(CollisionInfo);
+				}
+			}
+		}
+
+		if (const FUproarChaosListenerArray* Listeners = Component2 ? FindChaosListeners(Component2) : nullptr)
+		{
+			FChaosPhysicsCollisionInfo CollisionInfo;
+			CollisionInfo.Component = Component2;
+			CollisionInfo.OtherComponent = Component1;
+			CollisionInfo.Location = CollidingData.Location;
+			CollisionInfo.Normal = -CollidingData.Normal;
+			CollisionInfo.AccumulatedImpulse = -CollidingData.AccumulatedImpulse;
+			CollisionInfo.Velocity = CollidingData.Velocity2;
+			CollisionInfo.OtherVelocity = CollidingData.Velocity1;
+			CollisionInfo.AngularVelocity = CollidingData.AngularVelocity2;
+			CollisionInfo.OtherAngularVelocity = CollidingData.AngularVelocity1;
+			CollisionInfo.Mass = CollidingData.Mass2;
+			CollisionInfo.OtherMass = CollidingData.Mass1;
+
+			for (const TWeakObjectPtr<UUproarChaosListenerComponent>& Listener : *Listeners)
+			{
+				if (UUproarChaosListenerComponent* ChaosListener = Listener.Get())
+				{
+					ChaosListener->OnCollisionEvent(CollisionInfo);
+				}
+			}
+		}
+	}
+}
+
+void UUproarSubsystem::HandleBreakingEvents(const Chaos::FBreakingEventData& BreakingEventData)
+{
+	FPhysScene* PhysicsScene = SubsystemWorld ? SubsystemWorld->GetPhysicsScene() : nullptr;
+
+	if (PhysicsScene == nullptr || ChaosListeners.Num() == 0)
+	{
+		return;
+	}
+
+	// Listeners submit their events as one batch per solver callback
+	FUproarPhysicsEventStagingScope StagingScope(this);
+
+	for (const Chaos::FBreakingData& BreakingData : BreakingEventData.BreakingData)
+	{
+		UPrimitiveComponent* Component = BreakingData.Proxy ? PhysicsScene->GetOwningComponent<UPrimitiveComponent>(BreakingData.Proxy) : nullptr;
+
+		if (const FUproarChaosListenerArray* Listeners = Component ? FindChaosListeners(Component) : nullptr)
+		{
+			FChaosBreakEvent BreakEvent;
+			BreakEvent.Component = Component;
+			BreakEvent.Location = BreakingData.Location;
+			BreakEvent.Velocity = BreakingData.Velocity;
+			BreakEvent.AngularVelocity = BreakingData.AngularVelocity;
+			BreakEvent.Mass = BreakingData.Mass;
+
+			for (const TWeakObjectPtr<UUproarChaosListenerComponent>& Listener : *Listeners)
+			{
+				if (UUproarChaosListenerComponent* ChaosListener = Listener.Get())
+				{
+					ChaosListener->OnBreakEvent(BreakEvent);
+				}
+			}
+		}
+	}
 }
 
 int32 UUproarSubsystem::GetSpatialHashID(FVector InLocation)
@@ -180,7 +745,8 @@ FVector UUproarSubsystem::GetSpatialHashCellCenter(FVector InLocation)
 
 FVector UUproarSubsystem::GetClosestListenerRelativeToLocation(FVector InLocation)
 {
-	FVector ListenerRelativeLocation;
+	// Without listeners, hash events where they are
+	FVector ListenerRelativeLocation = InLocation;
 
 	if (ensureMsgf(AudioDevice, TEXT("AudioDevice is invalid.")))
 	{
@@ -213,6 +779,8 @@ FVector UUproarSubsystem::GetClosestListenerRelativeToLocation(FVector InLocatio
 
 void UUproarSubsystem::UpdateActiveEvents(float InDeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_UproarUpdateActiveEvents);
+
 	TArray<FUproarActivePhysicsEvent> EventsToKeep;
 
 	for (auto It = ActiveEvents.CreateIterator(); It; ++It)
@@ -231,6 +799,8 @@ void UUproarSubsystem::UpdateActiveEvents(float InDeltaTime)
 
 void UUproarSubsystem::UpdateActiveEventHash()
 {
+	SCOPE_CYCLE_COUNTER(STAT_UproarUpdateActiveEventHash);
+
 	ActiveEventHash.Empty();
 
 	for (auto It = ActiveEvents.CreateIterator(); It; ++It)
@@ -244,6 +814,8 @@ void UUproarSubsystem::UpdateActiveEventHash()
 
 void UUproarSubsystem::GenerateActiveEventsFromPendingEvents()
 {
+	SCOPE_CYCLE_COUNTER(STAT_UproarGenerateActiveEvents);
+
 	// Cycle through pending events and generate sounds for all the valid ones
 	for (auto It = PendingEvents.CreateIterator(); It; ++It)
 	{
@@ -252,7 +824,23 @@ void UUproarSubsystem::GenerateActiveEventsFromPendingEvents()
 		int32 ActiveEventHashKey = GetSpatialHashID(ListenerRelativeLocation);
 
 		// Search to see if this Spatial Hash is already used, if not, then we can add this pending event
-		if (!ActiveEventHash.Find(ActiveEventHashKey))
+		if (ActiveEventHash.Find(ActiveEventHashKey))
+		{
+			++NumCulledEvents;
+
+			TraceEventDecision(*It, ActiveEventHashKey, EUproarEventDecision::Culled);
+		}
+		else if (bStubPlayback)
+		{
+			// Replays only exercise the spatial hash, nothing is played
+			ActiveEventHash.Add(ActiveEventHashKey, *It);
+			ActiveEvents.Add(*It);
+
+			++NumAcceptedEvents;
+
+			TraceEventDecision(*It, ActiveEventHashKey, EUproarEventDecision::Accepted);
+		}
+		else
 		{
 			// Look up Sound in our SoundDefinitionLibrary, Return Double Pointer
 			if (USoundBase** SoundPointer = SoundDefinitionLibrary.Find(It->PhysicsEventType))
@@ -265,6 +853,10 @@ void UUproarSubsystem::GenerateActiveEventsFromPendingEvents()
 					// Play sound at actual event location
 					UGameplayStatics::PlaySoundAtLocation(SubsystemWorld, Sound, It->EventLocation, It->VolumeMod);
 
+					++NumAcceptedEvents;
+
+					TraceEventDecision(*It, ActiveEventHashKey, EUproarEventDecision::Accepted);
+
 					// Add Event to Active Event Hash
 					ActiveEventHash.Add(ActiveEventHashKey, *It);
 
@@ -287,11 +879,18 @@ void UUproarSubsystem::GenerateActiveEventsFromPendingEvents()
 				}
 
 			}
+			else
+			{
+				TraceEventDecision(*It, ActiveEventHashKey, EUproarEventDecision::NoSoundDefinition);
+			}
 		}
 	}
 }
 
 void UUproarSubsystem::ClearPendingEvents()
 {
-	PendingEvents.Empty();
+	SCOPE_CYCLE_COUNTER(STAT_UproarClearPendingEvents);
+
+	// Keep the allocation, the next batch is drained into the same array
+	PendingEvents.Reset();
 }
@@ -0,0 +1,662 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "UproarSubsystem.h"
+#include "UproarChaosListenerComponent.h"
+#include "UproarChaosCollisionEventSettings.h"
+#include "GeometryCollection/GeometryCollectionComponent.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsSolver.h"
+#include "SolverEventFilters.h"
+#include "EventsData.h"
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "Uproar.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Gives Uproar automation tests access to Subsystem internals. */
+struct FUproarTests
+{
+	static int32 GetNumChaosListeners(const UUproarSubsystem* UproarSubsystem)
+	{
+		int32 NumChaosListeners = 0;
+		for (const TPair<FObjectKey, FUproarChaosListenerArray>& Listeners : UproarSubsystem->ChaosListeners)
+		{
+			NumChaosListeners += Listeners.Value.Num();
+		}
+		return NumChaosListeners;
+	}
+
+	static bool IsSubscribedToChaosEvents(const UUproarSubsystem* UproarSubsystem)
+	{
+		return UproarSubsystem->bChaosEventsRegistered;
+	}
+
+	static bool IsChaosListenerRegistered(const UUproarSubsystem* UproarSubsystem, const UPrimitiveComponent* PrimitiveComponent, UUproarChaosListenerComponent* ChaosListener)
+	{
+		const FUproarChaosListenerArray* Listeners = UproarSubsystem->FindChaosListeners(PrimitiveComponent);
+		return Listeners && Listeners->Contains(ChaosListener);
+	}
+
+	// Run contacts through the same dispatch as the solver collision handler, with the caller resolving proxies to components
+	static void DispatchCollisionEvents(UUproarSubsystem* UproarSubsystem, TConstArrayView<Chaos::FCollidingData> Collisions, TFunctionRef<UPrimitiveComponent*(IPhysicsProxyBase*)> GetOwningComponent)
+	{
+		UproarSubsystem->DispatchCollisionEvents(Collisions, GetOwningComponent);
+	}
+
+	static float GetEventLifetime(const UUproarSubsystem* UproarSubsystem)
+	{
+		return UproarSubsystem->MaxLifetime;
+	}
+
+	static int32 GetMaxQueuedEvents(const UUproarSubsystem* UproarSubsystem)
+	{
+		return UproarSubsystem->MaxQueuedEvents;
+	}
+
+	static void SetMaxQueuedEvents(UUproarSubsystem* UproarSubsystem, int32 MaxQueuedEvents)
+	{
+		UproarSubsystem->MaxQueuedEvents = MaxQueuedEvents;
+	}
+
+	static int32 GetNumQueuedEvents(const UUproarSubsystem* UproarSubsystem)
+	{
+		return UproarSubsystem->NumQueuedEvents.load();
+	}
+
+	static int32 GetNumDroppedEvents(const UUproarSubsystem* UproarSubsystem)
+	{
+		return UproarSubsystem->NumDroppedEvents.load();
+	}
+
+	// Pop a single queue entry without processing it
+	static bool DequeueEventBatch(UUproarSubsystem* UproarSubsystem, TArray<FUproarPhysicsListenerEventData>& OutEventBatch)
+	{
+		if (UproarSubsystem->SubmittedEventBatches.Dequeue(OutEventBatch))
+		{
+			UproarSubsystem->NumQueuedEvents -= OutEventBatch.Num();
+			return true;
+		}
+
+		return false;
+	}
+
+	static void DrainSubmittedEvents(UUproarSubsystem* UproarSubsystem)
+	{
+		UproarSubsystem->DrainSubmittedEvents();
+	}
+
+	static TArray<FUproarActivePhysicsEvent>& GetPendingEvents(UUproarSubsystem* UproarSubsystem)
+	{
+		return UproarSubsystem->PendingEvents;
+	}
+};
+
+namespace UproarTests
+{
+	// A game world that has begun play, destroyed when it goes out of scope
+	struct FScopedTestWorld
+	{
+		UWorld* World = nullptr;
+
+		FScopedTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+		}
+
+		~FScopedTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+	};
+
+	static AActor* SpawnTestActor(UWorld* World)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		return World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+	}
+
+	static UGeometryCollectionComponent* AddGeometryCollection(AActor* Actor)
+	{
+		UGeometryCollectionComponent* GeometryCollectionComponent = NewObject<UGeometryCollectionComponent>(Actor);
+		Actor->SetRootComponent(GeometryCollectionComponent);
+		GeometryCollectionComponent->RegisterComponent();
+		return GeometryCollectionComponent;
+	}
+
+	static UUproarChaosListenerComponent* AddChaosListener(AActor* Actor)
+	{
+		// Registering on an actor that has begun play begins play on the component right away
+		UUproarChaosListenerComponent* ChaosListener = NewObject<UUproarChaosListenerComponent>(Actor);
+		ChaosListener->UproarChaosCollisionEventSettings = NewObject<UUproarChaosCollisionEventSettings>(ChaosListener);
+		ChaosListener->RegisterComponent();
+		return ChaosListener;
+	}
+
+	// A contact the default collision settings classify as a medium, mid speed collision
+	static Chaos::FCollidingData MakeContact(IPhysicsProxyBase* Proxy1, IPhysicsProxyBase* Proxy2)
+	{
+		Chaos::FCollidingData CollidingData;
+		CollidingData.Proxy1 = Proxy1;
+		CollidingData.Proxy2 = Proxy2;
+		CollidingData.Velocity1 = FVector(50.0f, 0.0f, 0.0f);
+		CollidingData.Velocity2 = FVector(-50.0f, 0.0f, 0.0f);
+		CollidingData.Mass1 = 50.0f;
+		CollidingData.Mass2 = 50.0f;
+		return CollidingData;
+	}
+
+	// Synthetic contacts stand in for proxies with the index of their component, they are only ever resolved, never dereferenced
+	static IPhysicsProxyBase* MakeTestProxy(int32 ComponentIndex)
+	{
+		return reinterpret_cast<IPhysicsProxyBase*>(static_cast<UPTRINT>(ComponentIndex) + 1);
+	}
+
+	static int32 GetTestProxyComponentIndex(IPhysicsProxyBase* Proxy)
+	{
+		return Proxy ? static_cast<int32>(reinterpret_cast<UPTRINT>(Proxy) - 1) : INDEX_NONE;
+	}
+
+	// Dequeue every submitted batch, returning how many events they held
+	static int32 DequeueAllEvents(UUproarSubsystem* UproarSubsystem, int32& OutNumBatches)
+	{
+		int32 NumEvents = 0;
+		TArray<FUproarPhysicsListenerEventData> EventBatch;
+
+		while (FUproarTests::DequeueEventBatch(UproarSubsystem, EventBatch))
+		{
+			NumEvents += EventBatch.Num();
+			++OutNumBatches;
+		}
+
+		return NumEvents;
+	}
+
+	static const Chaos::FSolverEventFilters* GetSolverEventFilters(UWorld* World)
+	{
+		FPhysScene* PhysicsScene = World->GetPhysicsScene();
+		Chaos::FPhysicsSolver* Solver = PhysicsScene ? PhysicsScene->GetSolver() : nullptr;
+		return Solver ? Solver->GetEventFilters() : nullptr;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUproarChaosListenerStressTest, "Uproar.ChaosListeners.Stress", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUproarChaosListenerStressTest::RunTest(const FString& Parameters)
+{
+	const int32 NumActors = 10000;
+	const int32 NumFrames = 100;
+	const int32 NumContactsPerFrame = 2000;
+
+	UproarTests::FScopedTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+
+	UUproarSubsystem* UproarSubsystem = World->GetSubsystem<UUproarSubsystem>();
+
+	if (UproarSubsystem == nullptr)
+	{
+		AddWarning(TEXT("The Uproar Subsystem is only created in worlds with an audio device, skipping."));
+		return true;
+	}
+
+	const Chaos::FSolverEventFilters* EventFilters = UproarTests::GetSolverEventFilters(World);
+	const bool bCollisionDataBefore = EventFilters && EventFilters->IsCollisionEventEnabled();
+	const bool bBreakingDataBefore = EventFilters && EventFilters->IsBreakingEventEnabled();
+
+	// A Geometry Collection created after its listener began play is picked up on a later tick
+	{
+		AActor* Actor = UproarTests::SpawnTestActor(World);
+		UUproarChaosListenerComponent* ChaosListener = UproarTests::AddChaosListener(Actor);
+
+		TestEqual(TEXT("Listener without a Geometry Collection registers nothing"), FUproarTests::GetNumChaosListeners(UproarSubsystem), 0);
+		TestTrue(TEXT("Listener without a Geometry Collection ticks until one shows up"), ChaosListener->IsComponentTickEnabled());
+
+		UGeometryCollectionComponent* GeometryCollectionComponent = UproarTests::AddGeometryCollection(Actor);
+		World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+
+		TestTrue(TEXT("Late Geometry Collection is registered"), FUproarTests::IsChaosListenerRegistered(UproarSubsystem, GeometryCollectionComponent, ChaosListener));
+		TestFalse(TEXT("Listener stops ticking once registered"), ChaosListener->IsComponentTickEnabled());
+
+		Actor->Destroy();
+		TestEqual(TEXT("Destroyed listener unregisters"), FUproarTests::GetNumChaosListeners(UproarSubsystem), 0);
+	}
+
+	// Two listeners on the same Geometry Collection both receive its events, and unregistering one keeps the other
+	{
+		AActor* Actor = UproarTests::SpawnTestActor(World);
+		UGeometryCollectionComponent* GeometryCollectionComponent = UproarTests::AddGeometryCollection(Actor);
+		UUproarChaosListenerComponent* FirstListener = UproarTests::AddChaosListener(Actor);
+		UUproarChaosListenerComponent* SecondListener = UproarTests::AddChaosListener(Actor);
+
+		TestEqual(TEXT("Both listeners of a Geometry Collection are registered"), FUproarTests::GetNumChaosListeners(UproarSubsystem), 2);
+
+		const Chaos::FCollidingData Contact = UproarTests::MakeContact(UproarTests::MakeTestProxy(0), nullptr);
+		auto GetOwningComponent = [GeometryCollectionComponent](IPhysicsProxyBase* Proxy) -> UPrimitiveComponent* { return Proxy ? GeometryCollectionComponent : nullptr; };
+
+		int32 NumBatches = 0;
+		FUproarTests::DispatchCollisionEvents(UproarSubsystem, MakeArrayView(&Contact, 1), GetOwningComponent);
+		TestEqual(TEXT("Every listener of the contact's component submits an event"), UproarTests::DequeueAllEvents(UproarSubsystem, NumBatches), 2);
+
+		FirstListener->DestroyComponent();
+		TestFalse(TEXT("Destroyed listener unregisters"), FUproarTests::IsChaosListenerRegistered(UproarSubsystem, GeometryCollectionComponent, FirstListener));
+		TestTrue(TEXT("Remaining listener stays registered"), FUproarTests::IsChaosListenerRegistered(UproarSubsystem, GeometryCollectionComponent, SecondListener));
+
+		FUproarTests::DispatchCollisionEvents(UproarSubsystem, MakeArrayView(&Contact, 1), GetOwningComponent);
+		TestEqual(TEXT("Remaining listener keeps receiving events"), UproarTests::DequeueAllEvents(UproarSubsystem, NumBatches), 1);
+
+		Actor->Destroy();
+		TestEqual(TEXT("Destroyed actor unregisters its listeners"), FUproarTests::GetNumChaosListeners(UproarSubsystem), 0);
+	}
+
+	// Stress: every actor listens to its own Geometry Collection
+	TArray<AActor*> Actors;
+	TArray<UPrimitiveComponent*> ContactComponents;
+	Actors.Reserve(NumActors);
+	ContactComponents.Reserve(NumActors * 2);
+
+	const double RegisterStartTime = FPlatformTime::Seconds();
+
+	for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+	{
+		AActor* Actor = UproarTests::SpawnTestActor(World);
+		ContactComponents.Add(UproarTests::AddGeometryCollection(Actor));
+		UproarTests::AddChaosListener(Actor);
+		Actors.Add(Actor);
+	}
+
+	const double RegisterSeconds = FPlatformTime::Seconds() - RegisterStartTime;
+
+	TestEqual(TEXT("Every Geometry Collection is registered"), FUproarTests::GetNumChaosListeners(UproarSubsystem), NumActors);
+	TestTrue(TEXT("Subsystem subscribes to the solver event streams"), FUproarTests::IsSubscribedToChaosEvents(UproarSubsystem));
+
+	int32 NumTickingListeners = 0;
+	for (AActor* Actor : Actors)
+	{
+		if (UUproarChaosListenerComponent* ChaosListener = Actor->FindComponentByClass<UUproarChaosListenerComponent>())
+		{
+			NumTickingListeners += ChaosListener->IsComponentTickEnabled() ? 1 : 0;
+		}
+	}
+
+	TestEqual(TEXT("Registered listeners do not tick"), NumTickingListeners, 0);
+
+	// As many contacts again come from components nobody listens to
+	for (int32 ComponentIndex = 0; ComponentIndex < NumActors; ++ComponentIndex)
+	{
+		ContactComponents.Add(NewObject<UGeometryCollectionComponent>(GetTransientPackage()));
+	}
+
+	// Route synthetic contacts through the Subsystem's collision dispatch, as the solver event handler does, and
+	// check that every contact with a listened to side reaches the event queue as one batch per solver callback
+	FRandomStream RandomStream(1234);
+	int32 NumQueuedEvents = 0;
+	int32 NumQueuedBatches = 0;
+	int32 NumExpectedEvents = 0;
+	double DispatchSeconds = 0.0;
+
+	auto GetOwningComponent = [&ContactComponents](IPhysicsProxyBase* Proxy) -> UPrimitiveComponent*
+	{
+		const int32 ComponentIndex = UproarTests::GetTestProxyComponentIndex(Proxy);
+		return ContactComponents.IsValidIndex(ComponentIndex) ? ContactComponents[ComponentIndex] : nullptr;
+	};
+
+	TArray<Chaos::FCollidingData> Contacts;
+	Contacts.Reserve(NumContactsPerFrame);
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Contacts.Reset();
+
+		for (int32 ContactIndex = 0; ContactIndex < NumContactsPerFrame; ++ContactIndex)
+		{
+			const int32 ComponentIndex1 = RandomStream.RandHelper(ContactComponents.Num());
+			const int32 ComponentIndex2 = RandomStream.RandHelper(ContactComponents.Num());
+			NumExpectedEvents += (ComponentIndex1 < NumActors ? 1 : 0) + (ComponentIndex2 < NumActors ? 1 : 0);
+			Contacts.Add(UproarTests::MakeContact(UproarTests::MakeTestProxy(ComponentIndex1), UproarTests::MakeTestProxy(ComponentIndex2)));
+		}
+
+		const double DispatchStartTime = FPlatformTime::Seconds();
+		FUproarTests::DispatchCollisionEvents(UproarSubsystem, Contacts, GetOwningComponent);
+		DispatchSeconds += FPlatformTime::Seconds() - DispatchStartTime;
+
+		NumQueuedEvents += UproarTests::DequeueAllEvents(UproarSubsystem, NumQueuedBatches);
+	}
+
+	TestEqual(TEXT("Only contacts of listened to components are dispatched"), NumQueuedEvents, NumExpectedEvents);
+	TestEqual(TEXT("Each dispatch submits a single batch"), NumQueuedBatches, NumFrames);
+
+	UE_LOG(LogUproar, Display, TEXT("Uproar Chaos listener stress, %d actors: registration %.3f ms, %d contacts per frame dispatched in %.4f ms per frame"),
+		NumActors, RegisterSeconds * 1000.0, NumContactsPerFrame, DispatchSeconds * 1000.0 / NumFrames);
+
+	for (AActor* Actor : Actors)
+	{
+		Actor->Destroy();
+	}
+
+	TestEqual(TEXT("Every listener unregisters"), FUproarTests::GetNumChaosListeners(UproarSubsystem), 0);
+	TestFalse(TEXT("Subsystem unsubscribes once no listeners are left"), FUproarTests::IsSubscribedToChaosEvents(UproarSubsystem));
+
+	if (EventFilters)
+	{
+		TestEqual(TEXT("Solver collision data generation is restored"), EventFilters->IsCollisionEventEnabled(), bCollisionDataBefore);
+		TestEqual(TEXT("Solver breaking data generation is restored"), EventFilters->IsBreakingEventEnabled(), bBreakingDataBefore);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUproarReplayTest, "Uproar.Replay", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUproarReplayTest::RunTest(const FString& Parameters)
+{
+	UproarTests::FScopedTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+
+	UUproarSubsystem* UproarSubsystem = World->GetSubsystem<UUproarSubsystem>();
+
+	if (UproarSubsystem == nullptr)
+	{
+		AddWarning(TEXT("The Uproar Subsystem is only created in worlds with an audio device, skipping."));
+		return true;
+	}
+
+	// Recorded events are stamped with world time, whatever the frame rate
+	{
+		const float WorldDeltaTime = 0.25f;
+		const FString CapturePath = FPaths::AutomationTransientDir() / TEXT("UproarReplayTest.uproarcap");
+
+		FUproarPhysicsListenerEventData EventData;
+
+		UproarSubsystem->StartCapture();
+
+		UproarSubsystem->PhysicsEvent(EventData);
+		UproarSubsystem->Tick(WorldDeltaTime);
+
+		World->Tick(LEVELTICK_All, WorldDeltaTime);
+
+		EventData.Location = FVector(5000.0f, 0.0f, 0.0f);
+		UproarSubsystem->PhysicsEvent(EventData);
+		UproarSubsystem->Tick(WorldDeltaTime);
+
+		TestTrue(TEXT("Capture is saved"), UproarSubsystem->StopCapture(CapturePath));
+
+		FUproarEventCapture Capture;
+		TestTrue(TEXT("Capture is loaded"), Capture.LoadFromFile(CapturePath));
+		TestEqual(TEXT("Capture holds every submitted event"), Capture.Events.Num(), 2);
+		TestEqual(TEXT("Capture lasts the world time it recorded"), Capture.Duration, WorldDeltaTime, KINDA_SMALL_NUMBER);
+
+		if (Capture.Events.Num() == 2)
+		{
+			TestEqual(TEXT("First event is stamped at the start of the capture"), Capture.Events[0].Timestamp, 0.0f);
+			TestEqual(TEXT("Second event is stamped with the world time it was drained at"), Capture.Events[1].Timestamp, WorldDeltaTime, KINDA_SMALL_NUMBER);
+			TestTrue(TEXT("Event data survives the round trip"), Capture.Events[1].EventData.Location.Equals(EventData.Location));
+		}
+	}
+
+	// Known outcome: three events share a cell, one lands in another cell, and the first cell is hit again once its event expired
+	{
+		const float TickRate = 60.0f;
+		const float EventLifetime = FUproarTests::GetEventLifetime(UproarSubsystem);
+
+		FUproarEventCapture Capture;
+		Capture.Duration = EventLifetime + 1.0f;
+
+		const float Timestamps[] = { 0.0f, 0.0f, 0.0f, 0.0f, EventLifetime + 0.5f };
+		const FVector Locations[] = { FVector::ZeroVector, FVector::ZeroVector, FVector::ZeroVector, FVector(5000.0f, 0.0f, 0.0f), FVector::ZeroVector };
+
+		for (int32 EventIndex = 0; EventIndex < UE_ARRAY_COUNT(Timestamps); ++EventIndex)
+		{
+			FUproarCapturedEvent& CapturedEvent = Capture.Events.AddDefaulted_GetRef();
+			CapturedEvent.EventData.Location = Locations[EventIndex];
+			CapturedEvent.Timestamp = Timestamps[EventIndex];
+		}
+
+		const FUproarReplayReport Report = UproarSubsystem->ReplayCapture(Capture, TickRate);
+
+		TestEqual(TEXT("Replay ticks at the requested rate"), Report.NumTicks, FMath::CeilToInt(Capture.Duration * TickRate));
+		TestEqual(TEXT("Replay submits every event"), Report.NumEvents, Capture.Events.Num());
+		TestEqual(TEXT("Events in free cells are accepted"), Report.NumAcceptedEvents, 3);
+		TestEqual(TEXT("Events in occupied cells are culled"), Report.NumCulledEvents, 2);
+		TestEqual(TEXT("Peak occupancy counts both cells"), Report.PeakOccupiedCells, 2);
+	}
+
+	// Stress level synthetic capture
+	{
+		const FUproarEventCapture Capture = FUproarEventCapture::GenerateSynthetic(50000.0f, 1.0f, FVector::ZeroVector, 5000.0f, 1234);
+
+		const FUproarReplayReport Report = UproarSubsystem->ReplayCapture(Capture);
+		const FUproarReplayReport RepeatReport = UproarSubsystem->ReplayCapture(Capture);
+
+		Report.Log();
+
+		TestEqual(TEXT("Synthetic replay submits every event"), Report.NumEvents, Capture.Events.Num());
+		TestEqual(TEXT("Every synthetic event is accepted or culled"), Report.NumAcceptedEvents + Report.NumCulledEvents, Report.NumEvents);
+		TestEqual(TEXT("Replays are deterministic, accepted"), RepeatReport.NumAcceptedEvents, Report.NumAcceptedEvents);
+		TestEqual(TEXT("Replays are deterministic, culled"), RepeatReport.NumCulledEvents, Report.NumCulledEvents);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUproarEventIngestionContentionTest, "Uproar.EventIngestion.Contention", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUproarEventIngestionContentionTest::RunTest(const FString& Parameters)
+{
+	const int32 NumProducers = 16;
+	const int32 NumEventsPerProducer = 20000;
+	const int32 BatchSize = 64;
+
+	UproarTests::FScopedTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+
+	UUproarSubsystem* UproarSubsystem = World->GetSubsystem<UUproarSubsystem>();
+
+	if (UproarSubsystem == nullptr)
+	{
+		AddWarning(TEXT("The Uproar Subsystem is only created in worlds with an audio device, skipping."));
+		return true;
+	}
+
+	const int32 MaxQueuedEventsBefore = FUproarTests::GetMaxQueuedEvents(UproarSubsystem);
+	TArray<FUproarActivePhysicsEvent>& PendingEvents = FUproarTests::GetPendingEvents(UproarSubsystem);
+
+	// Whatever a single submission or staging scope holds reaches the queue as one entry
+	{
+		FUproarPhysicsListenerEventData Events[3];
+		TArray<FUproarPhysicsListenerEventData> EventBatch;
+
+		UproarSubsystem->PhysicsEvent(Events[0]);
+		TestTrue(TEXT("Single event is queued"), FUproarTests::DequeueEventBatch(UproarSubsystem, EventBatch));
+		TestEqual(TEXT("Single event is queued on its own"), EventBatch.Num(), 1);
+
+		UproarSubsystem->PhysicsEvents(MakeArrayView(Events));
+		TestTrue(TEXT("Batch is queued"), FUproarTests::DequeueEventBatch(UproarSubsystem, EventBatch));
+		TestEqual(TEXT("Batch is queued as one entry"), EventBatch.Num(), (int32)UE_ARRAY_COUNT(Events));
+
+		{
+			FUproarPhysicsEventStagingScope StagingScope(UproarSubsystem);
+
+			UproarSubsystem->PhysicsEvent(Events[0]);
+			UproarSubsystem->PhysicsEvents(MakeArrayView(Events));
+
+			TestFalse(TEXT("Staged events wait for the end of their scope"), FUproarTests::DequeueEventBatch(UproarSubsystem, EventBatch));
+		}
+
+		TestTrue(TEXT("Staged events are queued"), FUproarTests::DequeueEventBatch(UproarSubsystem, EventBatch));
+		TestEqual(TEXT("Staged events are queued as one entry"), EventBatch.Num(), (int32)UE_ARRAY_COUNT(Events) + 1);
+		TestFalse(TEXT("Nothing else is queued"), FUproarTests::DequeueEventBatch(UproarSubsystem, EventBatch));
+		TestEqual(TEXT("Queued event count matches the queue"), FUproarTests::GetNumQueuedEvents(UproarSubsystem), 0);
+	}
+
+	// The queue stays bounded while nothing drains it, e.g. while paused
+	{
+		const int32 MaxQueuedEvents = 100;
+		const int32 NumExtraEvents = 50;
+
+		FUproarTests::SetMaxQueuedEvents(UproarSubsystem, MaxQueuedEvents);
+
+		FUproarPhysicsListenerEventData EventData;
+
+		for (int32 EventIndex = 0; EventIndex < MaxQueuedEvents + NumExtraEvents; ++EventIndex)
+		{
+			UproarSubsystem->PhysicsEvent(EventData);
+		}
+
+		TestEqual(TEXT("Queue holds no more than the cap"), FUproarTests::GetNumQueuedEvents(UproarSubsystem), MaxQueuedEvents);
+		TestEqual(TEXT("Events over the cap are dropped"), FUproarTests::GetNumDroppedEvents(UproarSubsystem), NumExtraEvents);
+
+		AddExpectedError(TEXT("Uproar dropped"), EAutomationExpectedErrorFlags::Contains, 1);
+
+		PendingEvents.Reset();
+		FUproarTests::DrainSubmittedEvents(UproarSubsystem);
+
+		TestEqual(TEXT("Queued events are drained"), PendingEvents.Num(), MaxQueuedEvents);
+		TestEqual(TEXT("Draining empties the queue"), FUproarTests::GetNumQueuedEvents(UproarSubsystem), 0);
+		TestEqual(TEXT("Draining reports the dropped events once"), FUproarTests::GetNumDroppedEvents(UproarSubsystem), 0);
+
+		PendingEvents.Reset();
+	}
+
+	// Producer threads race each other and the draining game thread, mixing single events, batches and staging scopes
+	{
+		FUproarTests::SetMaxQueuedEvents(UproarSubsystem, NumProducers * NumEventsPerProducer);
+
+		std::atomic<int32> NumFinishedProducers { 0 };
+		TArray<TFuture<void>> Producers;
+
+		const double StartSeconds = FPlatformTime::Seconds();
+
+		for (int32 ProducerIndex = 0; ProducerIndex < NumProducers; ++ProducerIndex)
+		{
+			Producers.Add(Async(EAsyncExecution::Thread, [UproarSubsystem, ProducerIndex, NumEventsPerProducer, BatchSize, &NumFinishedProducers]()
+			{
+				// Each event carries its producer and sequence number so the drained order can be checked
+				TArray<FUproarPhysicsListenerEventData> EventBatch;
+				int32 SequenceIndex = 0;
+
+				auto MakeEvent = [ProducerIndex, &SequenceIndex]()
+				{
+					FUproarPhysicsListenerEventData EventData;
+					EventData.Location = FVector(ProducerIndex, SequenceIndex++, 0.0f);
+					return EventData;
+				};
+
+				for (int32 Round = 0; SequenceIndex < NumEventsPerProducer; ++Round)
+				{
+					const int32 NumEvents = FMath::Min(BatchSize, NumEventsPerProducer - SequenceIndex);
+
+					switch (Round % 3)
+					{
+					case 0:
+						UproarSubsystem->PhysicsEvent(MakeEvent());
+						break;
+
+					case 1:
+						EventBatch.Reset();
+						for (int32 EventIndex = 0; EventIndex < NumEvents; ++EventIndex)
+						{
+							EventBatch.Add(MakeEvent());
+						}
+						UproarSubsystem->PhysicsEvents(EventBatch);
+						break;
+
+					default:
+						{
+							FUproarPhysicsEventStagingScope StagingScope(UproarSubsystem);
+							for (int32 EventIndex = 0; EventIndex < NumEvents; ++EventIndex)
+							{
+								UproarSubsystem->PhysicsEvent(MakeEvent());
+							}
+						}
+						break;
+					}
+				}
+
+				++NumFinishedProducers;
+			}));
+		}
+
+		TArray<int32> NextSequenceIndices;
+		NextSequenceIndices.Init(0, NumProducers);
+
+		int32 NumReceivedEvents = 0;
+		int32 NumOutOfOrderEvents = 0;
+		int32 NumDrains = 0;
+
+		auto DrainAndCheck = [&]()
+		{
+			FUproarTests::DrainSubmittedEvents(UproarSubsystem);
+
+			for (const FUproarActivePhysicsEvent& Event : PendingEvents)
+			{
+				const int32 ProducerIndex = (int32)Event.EventLocation.X;
+				const int32 SequenceIndex = (int32)Event.EventLocation.Y;
+
+				if (NextSequenceIndices.IsValidIndex(ProducerIndex) == false || NextSequenceIndices[ProducerIndex] != SequenceIndex)
+				{
+					++NumOutOfOrderEvents;
+				}
+
+				if (NextSequenceIndices.IsValidIndex(ProducerIndex))
+				{
+					NextSequenceIndices[ProducerIndex] = SequenceIndex + 1;
+				}
+			}
+
+			NumReceivedEvents += PendingEvents.Num();
+			PendingEvents.Reset();
+			++NumDrains;
+		};
+
+		while (NumFinishedProducers.load() < NumProducers)
+		{
+			DrainAndCheck();
+		}
+
+		for (TFuture<void>& Producer : Producers)
+		{
+			Producer.Wait();
+		}
+
+		DrainAndCheck();
+
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+		TestEqual(TEXT("Every submitted event is drained"), NumReceivedEvents, NumProducers * NumEventsPerProducer);
+		TestEqual(TEXT("Events of each producer are drained in submission order"), NumOutOfOrderEvents, 0);
+		TestEqual(TEXT("Nothing is dropped under the cap"), FUproarTests::GetNumDroppedEvents(UproarSubsystem), 0);
+		TestEqual(TEXT("Queue is empty once drained"), FUproarTests::GetNumQueuedEvents(UproarSubsystem), 0);
+
+		for (int32 ProducerIndex = 0; ProducerIndex < NumProducers; ++ProducerIndex)
+		{
+			TestEqual(FString::Printf(TEXT("Every event of producer %d is drained"), ProducerIndex), NextSequenceIndices[ProducerIndex], NumEventsPerProducer);
+		}
+
+		UE_LOG(LogUproar, Display, TEXT("%d producers submitted %d events in %.2f ms (%.2f M events/s), drained in %d passes"),
+			NumProducers, NumReceivedEvents, ElapsedMs, NumReceivedEvents / FMath::Max(ElapsedMs * 1000.0, 1.0), NumDrains);
+	}
+
+	FUproarTests::SetMaxQueuedEvents(UproarSubsystem, MaxQueuedEventsBefore);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
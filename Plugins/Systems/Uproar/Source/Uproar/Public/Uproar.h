@@ -4,9 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogUproar, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("Uproar"), STATGROUP_Uproar, STATCAT_Advanced);
+
+// Trace channel for per-event Uproar decisions, enable with -trace=uproar
+UE_TRACE_CHANNEL_EXTERN(UproarChannel, UPROAR_API);
+
 class FUproarModule : public IModuleInterface
 {
 public:
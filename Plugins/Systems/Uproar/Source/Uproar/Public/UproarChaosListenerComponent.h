@@ -6,6 +6,7 @@
 #include "GeometryCollection/GeometryCollectionComponent.h"
 #include "Chaos/ChaosEventListenerComponent.h"
 #include "Chaos/ChaosGameplayEventDispatcher.h"
+#include "UproarDataTypes.h"
 #include "UproarChaosListenerComponent.generated.h"
 
 class AGeometryCollectionActor;
@@ -25,6 +26,8 @@ public:
 	UUproarChaosListenerComponent();
 
 	//~ Begin UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	//~ End UActorComponent interface
 
@@ -48,10 +51,6 @@ public:
 	UFUNCTION()
 	void OnCollisionEvent(const FChaosPhysicsCollisionInfo& ChaosPhysicsCollisionInfo);
 
-	// Chaos Physics delegates
-	FScriptDelegate BreakEventDelegate;
-	FScriptDelegate PhysicsCollisionDelegate;
-
 	FOnChaosBreakEvent OnChaosBreakEvent;
 	FOnChaosPhysicsCollision OnChaosPhysicsCollision;
 
@@ -66,16 +65,19 @@ protected:
 	UPROPERTY()
 	TArray<UGeometryCollectionComponent*> ParentsGeometryCollectionComponents;
 
+	// Cached surface types of the listened to components, re-resolved when their materials change
+	FUproarSurfaceTypeCache SurfaceTypeCache;
+
 private:
 
 	// Set up initial state for component
 	void InitializeComponent();
 
-	// Register with Subsystem
+	// Register with Subsystem, which dispatches the Geometry Collection's Chaos events to this component
 	void RegisterChaosEvents(UGeometryCollectionComponent* GeometryCollectionComponent);
 
-	// Flag to determine if this component has been initialized and registered
-	bool bInitialized;
+	// Unregister all Geometry Collections from the Subsystem
+	void UnregisterChaosEvents();
 
 
 };
@@ -6,9 +6,12 @@
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Engine/DataTable.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "UObject/ObjectKey.h"
 #include "UproarDatatypes.generated.h"
 
 class USoundBase;
+class UMaterialInterface;
+class UPrimitiveComponent;
 
 /** This enum is for classifying the mass or size of physics events. */
 UENUM(BlueprintType)
@@ -128,4 +131,55 @@ public:
 	/**  */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SoundEvent)
 	USoundBase* Sound = nullptr;
-};
\ No newline at end of file
+};
+
+/** 
+* Caches resolved physical surface types per primitive component, by material slot. The materials of a
+* component's cached slots are checked for changes at most once per frame, so repeated contacts on the same geometry skip the
+* material/physical material lookup entirely.
+*/
+struct UPROAR_API FUproarSurfaceTypeCache
+{
+public:
+
+	/** Returns the surface type of the given material slot on a primitive component. */
+	EPhysicalSurface GetSurfaceType(const UPrimitiveComponent* PrimitiveComponent, int32 MaterialIndex = 0);
+
+	/** Drops all cached slots for a primitive component, e.g. after its materials have been swapped. */
+	void Invalidate(const UPrimitiveComponent* PrimitiveComponent);
+
+	/** Drops all cached data. */
+	void Reset();
+
+private:
+
+	struct FCachedSurfaceSlot
+	{
+		// Material the surface type was resolved from, used to detect material changes
+		FObjectKey Material;
+
+		// Resolved surface type
+		EPhysicalSurface SurfaceType = EPhysicalSurface::SurfaceType_Default;
+
+		// Whether SurfaceType has been resolved from Material
+		bool bResolved = false;
+	};
+
+	struct FCachedComponent
+	{
+		// Cached surface types, indexed by material slot
+		TArray<FCachedSurfaceSlot> Slots;
+
+		// Frame the slot materials were last checked for changes
+		uint64 ValidatedFrame = MAX_uint64;
+	};
+
+	// Find or add the cache of a component, dropping results of slots whose material changed if they weren't checked yet this frame
+	FCachedComponent& GetCachedComponent(const UPrimitiveComponent* PrimitiveComponent);
+
+	// Resolve the surface type of a material
+	static EPhysicalSurface ResolveSurfaceType(const UMaterialInterface* MaterialInterface);
+
+	// Cached surface types, keyed by primitive component
+	TMap<FObjectKey, FCachedComponent> CachedComponents;
+};
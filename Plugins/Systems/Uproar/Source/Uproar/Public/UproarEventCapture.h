@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UproarDataTypes.h"
+
+/** A single recorded call into the Uproar Subsystem's PhysicsEvent. */
+struct UPROAR_API FUproarCapturedEvent
+{
+	// Listener event data as it was sent to the Subsystem
+	FUproarPhysicsListenerEventData EventData;
+
+	// World seconds since the capture started
+	float Timestamp = 0.0f;
+
+	friend FArchive& operator<<(FArchive& Ar, FUproarCapturedEvent& CapturedEvent);
+};
+
+/** 
+* A recorded (or synthesized) stream of Uproar physics events. Captures can be saved to disk and replayed
+* through the Subsystem to profile event quantization without running physics.
+*/
+struct UPROAR_API FUproarEventCapture
+{
+	// Recorded events, sorted by timestamp
+	TArray<FUproarCapturedEvent> Events;
+
+	// Duration of the capture in world seconds
+	float Duration = 0.0f;
+
+	/** Write the capture to disk. */
+	bool SaveToFile(const FString& FilePath) const;
+
+	/** Read a capture from disk, returns false if the file is missing or not an Uproar capture. */
+	bool LoadFromFile(const FString& FilePath);
+
+	/** 
+	* Generate a synthetic capture for stress testing.
+	* @param EventsPerSecond Rate of generated events
+	* @param DurationSeconds Length of the generated capture
+	* @param Center Center of the volume events are scattered in
+	* @param Radius Half extent of the volume events are scattered in
+	* @param Seed Random seed, the same seed always produces the same capture
+	*/
+	static FUproarEventCapture GenerateSynthetic(float EventsPerSecond, float DurationSeconds, const FVector& Center, float Radius, int32 Seed = 0);
+};
+
+/** Statistics gathered while replaying a capture through the Uproar Subsystem. */
+struct UPROAR_API FUproarReplayReport
+{
+	int32 NumTicks = 0;
+	int32 NumEvents = 0;
+	int32 NumAcceptedEvents = 0;
+	int32 NumCulledEvents = 0;
+
+	double TotalTickMs = 0.0;
+	double MaxTickMs = 0.0;
+
+	// Occupied spatial hash cells
+	int32 PeakOccupiedCells = 0;
+	double AverageOccupiedCells = 0.0;
+
+	/** Write the report to the Uproar log. */
+	void Log() const;
+};
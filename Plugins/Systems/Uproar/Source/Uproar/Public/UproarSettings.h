@@ -43,6 +43,11 @@ public:
 	UPROPERTY(config, EditAnywhere)
 	bool bDrawDebugCells = false;
 
+	// The maximum number of submitted events waiting for the next Subsystem tick, e.g. while the game is paused
+	// Events submitted beyond it are dropped
+	UPROPERTY(config, EditAnywhere, meta = (ClampMin = "1", UIMin = "1"))
+	int32 UproarMaxQueuedEvents = 65536;
+
 public:
 
 	// Beginning of UDeveloperSettings Interface
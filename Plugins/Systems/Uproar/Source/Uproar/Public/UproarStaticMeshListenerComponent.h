@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "UproarDataTypes.h"
 #include "UproarStaticMeshListenerComponent.generated.h"
 
 class UUproarStaticMeshHitEventSettings;
@@ -21,7 +22,8 @@ public:
 	UUproarStaticMeshListenerComponent();
 
 	//~ Begin UActorComponent interface
-	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	//~ End UActorComponent interface
 
 	// When true, the component will draw debug points scaled to incoming events
@@ -51,6 +53,9 @@ protected:
 	UPROPERTY()
 	UStaticMeshComponent* ParentsStaticMeshComponent;
 
+	// Cached surface types of the listened to components, re-resolved when their materials change
+	FUproarSurfaceTypeCache SurfaceTypeCache;
+
 private:
 	// Set up initial state for component
 	void InitializeComponent();
@@ -58,7 +63,7 @@ private:
 	// Register Hit Event with sibling Static Mesh Component
 	void RegisterPhysicsEvents();
 
-	// Flag to determine if this component has been initialized and registered
-	bool bInitialized;
+	// Remove Hit Event from sibling Static Mesh Component
+	void UnregisterPhysicsEvents();
 
 };
\ No newline at end of file
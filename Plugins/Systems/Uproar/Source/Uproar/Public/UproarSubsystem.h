@@ -8,11 +8,26 @@
 #include "Chaos/ChaosGameplayEventDispatcher.h"
 #include "UObject/WeakObjectPtr.h"
 #include "UproarDataTypes.h"
+#include "UproarEventCapture.h"
+#include "Containers/MpscQueue.h"
 #include "Tickable.h"
+#include <atomic>
 #include "UproarSubsystem.generated.h"
 
 class USoundBase;
 class FAudioDevice;
+class UUproarChaosListenerComponent;
+class IPhysicsProxyBase;
+
+namespace Chaos
+{
+	struct FCollisionEventData;
+	struct FBreakingEventData;
+	struct FCollidingData;
+}
+
+/** Chaos listeners of one primitive component, almost always a single one. */
+using FUproarChaosListenerArray = TArray<TWeakObjectPtr<UUproarChaosListenerComponent>, TInlineAllocator<1>>;
 
 /** This Struct allows designers to associate MixStates with SoundControlBusMixes. */
 USTRUCT()
@@ -67,11 +82,89 @@ public:
 	TStatId GetStatId() const override;
 	// End FTickableGameObject
 
+	/** 
+	* Submit a physics event. Safe to call from any thread, including physics thread and async physics callbacks;
+	* submitted events are drained in one batch on the next Subsystem tick. Inside an FUproarPhysicsEventStagingScope
+	* the event is staged and submitted with the rest of the scope.
+	*/
 	UFUNCTION()
 	void PhysicsEvent(const FUproarPhysicsListenerEventData& PhysicsListenerEventData);
 
+	/** Submit a batch of physics events gathered by the caller as a single queue entry. Safe to call from any thread. */
+	void PhysicsEvents(TConstArrayView<FUproarPhysicsListenerEventData> PhysicsListenerEventData);
+
+	/** 
+	* Route the Chaos collision and break events of a primitive component to a Chaos listener. The Subsystem subscribes
+	* to the solver event streams once and dispatches only the events of registered components. A component may have
+	* several listeners, each receives its events.
+	*/
+	void RegisterChaosListener(UPrimitiveComponent* PrimitiveComponent, UUproarChaosListenerComponent* ChaosListener);
+
+	/** Stop routing Chaos events of a primitive component to a listener. Unsubscribes from the solver event streams once no listeners are left. */
+	void UnregisterChaosListener(UPrimitiveComponent* PrimitiveComponent, UUproarChaosListenerComponent* ChaosListener);
+
+	/** Start recording every PhysicsEvent call, any capture in progress is discarded. */
+	void StartCapture();
+
+	/** 
+	* Stop recording and write the capture to disk.
+	* @return Whether a capture was in progress and was written successfully
+	*/
+	bool StopCapture(const FString& FilePath);
+
+	/** Whether PhysicsEvent calls are currently being recorded. */
+	bool IsCapturing() const { return bCapturing; }
+
+	/**
+	* Feed a capture through the event pipeline at a fixed tick rate with sound playback stubbed out. Every event is
+	* treated as having a sound definition so that spatial hash culling is exercised regardless of the loaded library.
+	* Active and pending events are cleared before and after the replay.
+	* @param Capture The recorded or synthetic events to replay
+	* @param TickRate Simulated ticks per second
+	* @return Per-tick cost, accepted/culled counts and spatial hash occupancy of the replay
+	*/
+	FUproarReplayReport ReplayCapture(const FUproarEventCapture& Capture, float TickRate = 60.0f);
+
 private:
 
+	// Capture recording state, timestamps are in world time so captures replay the same at any frame rate
+	bool bCapturing = false;
+	double CaptureStartTime = 0.0;
+	double GetCaptureTime() const;
+	FUproarEventCapture ActiveCapture;
+
+	// When true, accepted events do not play sounds and do not require a sound definition
+	bool bStubPlayback = false;
+
+	// Running totals of pending events accepted into or culled by the spatial hash
+	int32 NumAcceptedEvents = 0;
+	int32 NumCulledEvents = 0;
+
+	// Registered Chaos listeners, keyed by the primitive component they listen to
+	TMap<FObjectKey, FUproarChaosListenerArray> ChaosListeners;
+
+	// Flag indicating the Subsystem is subscribed to the solver event streams
+	bool bChaosEventsRegistered = false;
+
+	// Whether the solver generated collision and breaking data before we subscribed, restored when we unsubscribe
+	bool bSolverGeneratedCollisionData = false;
+	bool bSolverGeneratedBreakingData = false;
+
+	// Subscribe to and unsubscribe from the solver event streams
+	void RegisterChaosEvents();
+	void UnregisterChaosEvents();
+
+	// Find the Chaos listeners registered for a primitive component
+	const FUproarChaosListenerArray* FindChaosListeners(const UPrimitiveComponent* PrimitiveComponent) const;
+
+	// Solver event stream handlers
+	void HandleCollisionEvents(const Chaos::FCollisionEventData& CollisionEventData);
+	void HandleBreakingEvents(const Chaos::FBreakingEventData& BreakingEventData);
+
+	// Dispatch contacts to the listeners of either side, resolving the components that own the contact proxies
+	void DispatchCollisionEvents(TConstArrayView<Chaos::FCollidingData> Collisions, TFunctionRef<UPrimitiveComponent*(IPhysicsProxyBase*)> GetOwningComponent);
+
+
 	// Sound Definition Library is a look up table for Physics Sound Events
 	UPROPERTY()
 	TMap<int32, USoundBase*> SoundDefinitionLibrary;
@@ -101,6 +194,19 @@ private:
 	// Cached Audio Device Pointer
 	FAudioDevice* AudioDevice;
 
+	// Lock-free multi-producer single-consumer queue of submitted event batches, one entry per submission or staging scope
+	TMpscQueue<TArray<FUproarPhysicsListenerEventData>> SubmittedEventBatches;
+
+	// Events waiting in the queue and events dropped since the last drain because the queue was full
+	std::atomic<int32> NumQueuedEvents { 0 };
+	std::atomic<int32> NumDroppedEvents { 0 };
+
+	// Cap on queued events so the queue stays bounded while the Subsystem doesn't tick
+	int32 MaxQueuedEvents = 65536;
+
+	// Queue a batch of events unless that would exceed MaxQueuedEvents
+	void SubmitEventBatch(TArray<FUproarPhysicsListenerEventData>&& EventBatch);
+
 	TArray<FUproarActivePhysicsEvent> ActiveEvents;
 	TArray<FUproarActivePhysicsEvent> PendingEvents;
 
@@ -108,6 +214,34 @@ private:
 
 	void UpdateActiveEvents(float InDeltaTime);
 	void UpdateActiveEventHash();
+	void DrainSubmittedEvents();
 	void GenerateActiveEventsFromPendingEvents();
 	void ClearPendingEvents();
+
+	friend struct FUproarTests;
+	friend class FUproarPhysicsEventStagingScope;
+};
+
+/**
+* Stages every physics event the current thread submits to a Subsystem while in scope, and submits them as a single
+* queue entry when the scope ends. Open one around code that submits many events in a row, such as a physics callback
+* walking its contacts. Scopes nest; events go to the innermost scope opened for the same Subsystem.
+*/
+class UPROAR_API FUproarPhysicsEventStagingScope
+{
+public:
+	explicit FUproarPhysicsEventStagingScope(UUproarSubsystem* InUproarSubsystem);
+	~FUproarPhysicsEventStagingScope();
+
+	UE_NONCOPYABLE(FUproarPhysicsEventStagingScope);
+
+private:
+	UUproarSubsystem* UproarSubsystem;
+	FUproarPhysicsEventStagingScope* OuterScope;
+	TArray<FUproarPhysicsListenerEventData> StagedEvents;
+
+	// Innermost scope open on the calling thread for a Subsystem, if any
+	static FUproarPhysicsEventStagingScope* Find(const UUproarSubsystem* InUproarSubsystem);
+
+	friend class UUproarSubsystem;
 };
@@ -37,6 +37,7 @@ public class Uproar : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"Chaos",
 				"Engine",
 				"GeometryCollectionEngine",
 				"PhysicsCore",
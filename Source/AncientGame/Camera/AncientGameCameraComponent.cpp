@@ -2,27 +2,27 @@
 
 #include "AncientGameCameraComponent.h"
 #include "AncientGameCameraMode.h"
+#include "AncientGameCameraEvaluationSubsystem.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerController.h"
+#include "Camera/AncientGameCameraTrace.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Camera Mode Pool Hits"), STAT_AncientGameCameraPoolHits, STATGROUP_AncientGameCamera);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Camera Mode Pool Misses"), STAT_AncientGameCameraPoolMisses, STATGROUP_AncientGameCamera);
 
 /* FAncientGameCameraModeHandle
  *****************************************************************************/
 
-namespace AncientGameCameraModeHandle_Impl
-{
-	static int32 LastHandleId = 0;
-	static int32 GetNextQueuedHandleIdForUse() { return ++LastHandleId; }
-}
-
 bool FAncientGameCameraModeHandle::IsValid() const
 {
-	return Owner.IsValid() && HandleId != 0;
+	return Owner.IsValid() && Generation != 0;
 }
 
 void FAncientGameCameraModeHandle::Reset()
 {
 	Owner.Reset();
-	HandleId = 0;
+	SlotIndex = INDEX_NONE;
+	Generation = 0;
 }
 
 
@@ -41,12 +41,32 @@ void UAncientGameCameraComponent::InitializeComponent()
 	PushCameraMode(DefaultCameraMode);
 }
 
+void UAncientGameCameraComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (UAncientGameCameraEvaluationSubsystem* EvaluationSubsystem = UWorld::GetSubsystem<UAncientGameCameraEvaluationSubsystem>(GetWorld()))
+	{
+		EvaluationSubsystem->RegisterCameraComponent(this);
+	}
+}
+
+void UAncientGameCameraComponent::OnUnregister()
+{
+	if (UAncientGameCameraEvaluationSubsystem* EvaluationSubsystem = UWorld::GetSubsystem<UAncientGameCameraEvaluationSubsystem>(GetWorld()))
+	{
+		EvaluationSubsystem->UnregisterCameraComponent(this);
+	}
+
+	Super::OnUnregister();
+}
+
 void UAncientGameCameraComponent::GetCameraView(float DeltaTime, FMinimalViewInfo& DesiredView)
 {
 	AActor* TargetActor = GetOwner();
 
 	FAncientGameCameraModeView CameraModeView;
-	if (!BlendingStack.EvaluateStack(DeltaTime, TargetActor, CameraModeView))
+	if (!EvaluateCameraModeView(DeltaTime, CameraModeView))
 	{
 		Super::GetCameraView(DeltaTime, DesiredView);
 		return;
@@ -96,19 +116,31 @@ FAncientGameCameraModeHandle UAncientGameCameraComponent::PushCameraMode(TSubcla
 FAncientGameCameraModeHandle UAncientGameCameraComponent::PushCameraModeUsingInstance(UAncientGameCameraMode* CameraModeInstance, int32 Priority)
 {
 	FAncientGameCameraModeHandle ModeHandle;
+
+	const int32 SlotIndex = AllocateCameraModeSlot();
+	if (!ensureMsgf(SlotIndex != INDEX_NONE, TEXT("Can't push %s, %s already has %d camera modes pushed"), *GetNameSafe(CameraModeInstance), *GetPathName(), MaxCameraModes))
+	{
+		return ModeHandle;
+	}
+
+	FCameraModeStackEntry& Entry = CameraModeSlots[SlotIndex];
+	Entry.Priority = Priority;
+	Entry.CameraMode = CameraModeInstance;
+
 	ModeHandle.Owner = this;
-	ModeHandle.HandleId = AncientGameCameraModeHandle_Impl::GetNextQueuedHandleIdForUse();
+	ModeHandle.SlotIndex = SlotIndex;
+	ModeHandle.Generation = Entry.Generation;
 
 	int32 StackIndex = 0;
 	for (; StackIndex < CameraModePriorityStack.Num(); ++StackIndex)
 	{
-		if (CameraModePriorityStack[StackIndex].Priority > Priority)
+		if (CameraModeSlots[CameraModePriorityStack[StackIndex]].Priority > Priority)
 		{
 			break;
 		}
 	}
 
-	CameraModePriorityStack.Insert({ ModeHandle.HandleId, Priority, CameraModeInstance }, StackIndex);
+	CameraModePriorityStack.Insert(SlotIndex, StackIndex);
 	UpdateBlendingStack();
 
 	return ModeHandle;
@@ -119,12 +151,12 @@ bool UAncientGameCameraComponent::PullCameraMode(FAncientGameCameraModeHandle& M
 	bool bSuccess = false;
 	if (ModeHandle.IsValid() && ModeHandle.Owner == this)
 	{
-		const int32 HandleId = ModeHandle.HandleId;
-		const int32 FoundIndex = CameraModePriorityStack.IndexOfByPredicate([HandleId](const FCameraModeStackEntry& CameraModeEntry)
-			{
-				return (CameraModeEntry.HandleId == HandleId);
-			});
-		bSuccess = PullCameraModeAtIndex(FoundIndex);
+		// The generation tells a live push from one whose slot has since been reused
+		const int32 SlotIndex = ModeHandle.SlotIndex;
+		if ((SlotIndex >= 0) && (SlotIndex < MaxCameraModes) && CameraModeSlots[SlotIndex].bAllocated && (CameraModeSlots[SlotIndex].Generation == ModeHandle.Generation))
+		{
+			bSuccess = PullCameraModeAtSlot(SlotIndex);
+		}
 		ModeHandle.Reset();
 	}
 	return bSuccess;
@@ -132,11 +164,11 @@ bool UAncientGameCameraComponent::PullCameraMode(FAncientGameCameraModeHandle& M
 
 bool UAncientGameCameraComponent::PullCameraModeInstance(UAncientGameCameraMode* CameraMode)
 {
-	const int32 FoundIndex = CameraModePriorityStack.IndexOfByPredicate([CameraMode](const FCameraModeStackEntry& CameraModeEntry)
+	const int32* FoundSlot = CameraModePriorityStack.FindByPredicate([this, CameraMode](int32 SlotIndex)
 		{
-			return (CameraModeEntry.CameraMode == CameraMode);
+			return (CameraModeSlots[SlotIndex].CameraMode == CameraMode);
 		});
-	return PullCameraModeAtIndex(FoundIndex);
+	return FoundSlot ? PullCameraModeAtSlot(*FoundSlot) : false;
 }
 
 UAncientGameCameraMode* UAncientGameCameraComponent::GetActiveCameraMode() const
@@ -144,7 +176,7 @@ UAncientGameCameraMode* UAncientGameCameraComponent::GetActiveCameraMode() const
 	UAncientGameCameraMode* ActiveCamera = nullptr;
 	if (ensureAlways(CameraModePriorityStack.Num() > 0))
 	{
-		ActiveCamera = CameraModePriorityStack.Top().CameraMode;
+		ActiveCamera = CameraModeSlots[CameraModePriorityStack.Top()].CameraMode;
 	}
 	return ActiveCamera;
 }
@@ -213,6 +245,29 @@ UAncientGameCameraMode* UAncientGameCameraComponent::GetActiveCameraModeForActor
 	return ActiveCamera;
 }
 
+bool UAncientGameCameraComponent::EvaluateCameraModeView(float DeltaTime, FAncientGameCameraModeView& OutCameraModeView)
+{
+	LastViewRequestFrame = GFrameCounter;
+
+	if (bEvaluateInParallel)
+	{
+		// The first camera asking for a view this frame evaluates all of them.
+		if (UAncientGameCameraEvaluationSubsystem* EvaluationSubsystem = UWorld::GetSubsystem<UAncientGameCameraEvaluationSubsystem>(GetWorld()))
+		{
+			EvaluationSubsystem->EvaluateFrame(DeltaTime);
+		}
+
+		if (EvaluatedViewFrame == GFrameCounter)
+		{
+			OutCameraModeView = EvaluatedView;
+			return bEvaluatedViewValid;
+		}
+	}
+
+	// Not gathered this frame, like on the first frame a camera is used.
+	return BlendingStack.EvaluateStack(DeltaTime, GetOwner(), OutCameraModeView);
+}
+
 void UAncientGameCameraComponent::UpdateBlendingStack()
 {
 	if (!ensureAlways(CameraModePriorityStack.Num() > 0))
@@ -221,7 +276,7 @@ void UAncientGameCameraComponent::UpdateBlendingStack()
 	}
 
 	AActor* TargetActor = GetOwner();
-	BlendingStack.PushCameraMode(CameraModePriorityStack.Top().CameraMode, TargetActor);
+	BlendingStack.PushCameraMode(CameraModeSlots[CameraModePriorityStack.Top()].CameraMode, TargetActor);
 }
 
 UAncientGameCameraMode* UAncientGameCameraComponent::GetPooledCameraModeInstance(TSubclassOf<UAncientGameCameraMode> CameraModeClass)
@@ -229,28 +284,49 @@ UAncientGameCameraMode* UAncientGameCameraComponent::GetPooledCameraModeInstance
 	check(CameraModeClass);
 
 	// First see if we already created one.
-	for (UAncientGameCameraMode* CameraMode : CameraModeInstancePool)
+	if (UAncientGameCameraMode* CameraMode = CameraModeInstancePool.FindRef(CameraModeClass))
 	{
-		if ((CameraMode != nullptr) && (CameraMode->GetClass() == CameraModeClass))
-		{
-			return CameraMode;
-		}
+		INC_DWORD_STAT(STAT_AncientGameCameraPoolHits);
+		AncientGameCameraTrace::TracePoolLookup(CameraModeClass, true);
+		return CameraMode;
 	}
 
+	INC_DWORD_STAT(STAT_AncientGameCameraPoolMisses);
+	AncientGameCameraTrace::TracePoolLookup(CameraModeClass, false);
+
 	// Not found, so we need to create it.
 	UAncientGameCameraMode* NewCameraMode = NewObject<UAncientGameCameraMode>(this, CameraModeClass, NAME_None, RF_NoFlags);
 	check(NewCameraMode);
 
-	CameraModeInstancePool.Add(NewCameraMode);
+	CameraModeInstancePool.Add(CameraModeClass, NewCameraMode);
 
 	return NewCameraMode;
 }
 
-bool UAncientGameCameraComponent::PullCameraModeAtIndex(int32 Index)
+int32 UAncientGameCameraComponent::AllocateCameraModeSlot()
 {
-	if (CameraModePriorityStack.IsValidIndex(Index))
+	for (int32 SlotIndex = 0; SlotIndex < MaxCameraModes; ++SlotIndex)
 	{
-		CameraModePriorityStack.RemoveAt(Index);
+		FCameraModeStackEntry& Entry = CameraModeSlots[SlotIndex];
+		if (!Entry.bAllocated)
+		{
+			// Bump the generation so handles to the previous push stay stale, zero is reserved for invalid handles.
+			Entry.Generation = (Entry.Generation == MAX_int32) ? 1 : (Entry.Generation + 1);
+			Entry.bAllocated = true;
+			return SlotIndex;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool UAncientGameCameraComponent::PullCameraModeAtSlot(int32 SlotIndex)
+{
+	if (CameraModePriorityStack.Remove(SlotIndex) > 0)
+	{
+		FCameraModeStackEntry& Entry = CameraModeSlots[SlotIndex];
+		Entry.bAllocated = false;
+		Entry.CameraMode = nullptr;
+
 		UpdateBlendingStack();
 
 		return true;
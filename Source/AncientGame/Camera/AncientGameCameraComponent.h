@@ -23,8 +23,13 @@ private:
 	UPROPERTY()
 	TWeakObjectPtr<UAncientGameCameraComponent> Owner;
 
+	// Slot of the owner's priority stack the mode was pushed into
 	UPROPERTY()
-	int32 HandleId = 0;
+	int32 SlotIndex = INDEX_NONE;
+
+	// Generation of the slot when the mode was pushed, stale once the slot is reused
+	UPROPERTY()
+	int32 Generation = 0;
 };
 
 USTRUCT()
@@ -32,8 +37,9 @@ struct FCameraModeStackEntry
 {
 	GENERATED_BODY()
 
-	int32 HandleId = 0;
+	int32 Generation = 0;
 	int32 Priority = 0;
+	bool bAllocated = false;
 
 	UPROPERTY()
 	UAncientGameCameraMode* CameraMode = nullptr;
@@ -48,10 +54,15 @@ class ANCIENTGAME_API UAncientGameCameraComponent : public UCameraComponent
 	TSubclassOf<UAncientGameCameraMode> DefaultCameraMode;
 
 public:
+	// Camera modes that can be pushed at once
+	static constexpr int32 MaxCameraModes = 16;
+
 	UAncientGameCameraComponent();
 
 	//~ Begin UActorComponent interface
 	virtual void InitializeComponent() override;
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 	//~ End UActorComponent interface
 
 	//~ Begin UCameraComponent interface
@@ -92,21 +103,45 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AncientGame|Camera")
 	static UAncientGameCameraMode* GetActiveCameraModeForActor(const AActor* Actor);
 
+	// If true, the view is evaluated together with the world's other cameras by UAncientGameCameraEvaluationSubsystem, updating camera modes that opt in in parallel.
+	// Every camera that requested a view last frame is evaluated on the first request of the frame, using that request's DeltaTime,
+	// so only cameras ticking with the world's frame time should enable this.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AncientGame|Camera")
+	bool bEvaluateInParallel = false;
+
 protected:
+	// Evaluates the blending stack, or picks up the view the evaluation subsystem produced this frame.
+	bool EvaluateCameraModeView(float DeltaTime, FAncientGameCameraModeView& OutCameraModeView);
+
 	void UpdateBlendingStack();
 	UAncientGameCameraMode* GetPooledCameraModeInstance(TSubclassOf<UAncientGameCameraMode> CameraModeClass);
 
-	bool PullCameraModeAtIndex(int32 Index);
+	int32 AllocateCameraModeSlot();
+	bool PullCameraModeAtSlot(int32 SlotIndex);
 
-	// Stack of active camera modes, sorted in priority order.
+	// Fixed slots holding the pushed camera modes, handles resolve to them directly.
 	UPROPERTY()
-	TArray<FCameraModeStackEntry> CameraModePriorityStack;
+	FCameraModeStackEntry CameraModeSlots[MaxCameraModes];
+
+	// Slots of the active camera modes, sorted in priority order.
+	TArray<int32, TInlineAllocator<MaxCameraModes>> CameraModePriorityStack;
 
 	// Pool of unique camera modes for reuse (to cut down on re-allocating the same mode over and over).
 	UPROPERTY()
-	TArray<UAncientGameCameraMode*> CameraModeInstancePool;
+	TMap<TSubclassOf<UAncientGameCameraMode>, UAncientGameCameraMode*> CameraModeInstancePool;
 
 	// Stack used to blend the camera modes.
 	UPROPERTY()
 	FAncientGameCameraModeStack BlendingStack;
+
+	// View produced by the evaluation subsystem, valid for EvaluatedViewFrame only.
+	FAncientGameCameraModeView EvaluatedView;
+	uint64 EvaluatedViewFrame = MAX_uint64;
+	bool bEvaluatedViewValid = false;
+
+	// Last frame a view was requested, the evaluation subsystem expects the same cameras next frame.
+	uint64 LastViewRequestFrame = 0;
+
+	friend class UAncientGameCameraEvaluationSubsystem;
+	friend struct FAncientGameCameraModeTests;
 };
@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Camera/AncientGameCameraEvaluationSubsystem.h"
+#include "Camera/AncientGameCameraComponent.h"
+#include "Camera/AncientGameCameraModeStack.h"
+#include "Camera/SpringArmCameraMode.h"
+#include "AncientGame.h"
+#include "Async/ParallelFor.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Camera/AncientGameCameraTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Parallel Camera Evaluation"), STAT_AncientGameCameraParallelEvaluation, STATGROUP_AncientGameCamera);
+
+/* UAncientGameCameraEvaluationSubsystem
+ *****************************************************************************/
+
+void UAncientGameCameraEvaluationSubsystem::RegisterCameraComponent(UAncientGameCameraComponent* CameraComponent)
+{
+	if (CameraComponent)
+	{
+		CameraComponents.AddUnique(CameraComponent);
+	}
+}
+
+void UAncientGameCameraEvaluationSubsystem::UnregisterCameraComponent(UAncientGameCameraComponent* CameraComponent)
+{
+	CameraComponents.RemoveSingleSwap(CameraComponent, false);
+}
+
+void UAncientGameCameraEvaluationSubsystem::EvaluateFrame(float DeltaTime)
+{
+	if (LastEvaluatedFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	LastEvaluatedFrame = GFrameCounter;
+
+	CameraComponents.RemoveAllSwap([](const TWeakObjectPtr<UAncientGameCameraComponent>& CameraComponent) { return !CameraComponent.IsValid(); }, false);
+
+	// Cameras that asked for a view last frame are expected to ask again this frame.
+	FrameCameras.Reset();
+	for (const TWeakObjectPtr<UAncientGameCameraComponent>& CameraComponent : CameraComponents)
+	{
+		UAncientGameCameraComponent* Camera = CameraComponent.Get();
+		if (Camera && Camera->bEvaluateInParallel && Camera->IsActive() && (Camera->LastViewRequestFrame + 1 >= GFrameCounter))
+		{
+			FrameCameras.Add(Camera);
+		}
+	}
+
+	if (FrameCameras.Num() > 0)
+	{
+		EvaluateCameras(FrameCameras, DeltaTime);
+	}
+}
+
+void UAncientGameCameraEvaluationSubsystem::EvaluateCameras(TArrayView<UAncientGameCameraComponent* const> Cameras, float DeltaTime)
+{
+	check(IsInGameThread());
+	SCOPE_CYCLE_COUNTER(STAT_AncientGameCameraParallelEvaluation);
+
+	// Game thread: blending, deactivation callbacks and the views that go through Blueprint.
+	for (UAncientGameCameraComponent* Camera : Cameras)
+	{
+		Camera->bEvaluatedViewValid = Camera->BlendingStack.BeginParallelEvaluation(DeltaTime, Camera->GetOwner());
+	}
+
+	// Native views and their interpolators.
+	ParallelFor(Cameras.Num(), [Cameras, DeltaTime](int32 CameraIndex)
+	{
+		UAncientGameCameraComponent* Camera = Cameras[CameraIndex];
+		Camera->BlendingStack.UpdateViewsInParallel(DeltaTime, Camera->GetOwner());
+	});
+
+	// Game thread: collision traces left over by the parallel views.
+	for (UAncientGameCameraComponent* Camera : Cameras)
+	{
+		Camera->BlendingStack.FinishParallelEvaluation(Camera->GetOwner());
+	}
+
+	// Blend every stack into its final view.
+	ParallelFor(Cameras.Num(), [Cameras](int32 CameraIndex)
+	{
+		UAncientGameCameraComponent* Camera = Cameras[CameraIndex];
+		if (Camera->bEvaluatedViewValid)
+		{
+			Camera->BlendingStack.BlendStack(Camera->EvaluatedView);
+		}
+		Camera->EvaluatedViewFrame = GFrameCounter;
+	});
+}
+
+
+/* FAncientGameCameraModeTests
+ *****************************************************************************/
+
+bool FAncientGameCameraModeTests::RunParallelEvaluationBenchmark(UWorld* World, int32 NumCameras, int32 NumFrames)
+{
+	UAncientGameCameraEvaluationSubsystem* EvaluationSubsystem = UWorld::GetSubsystem<UAncientGameCameraEvaluationSubsystem>(World);
+	if (!EvaluationSubsystem)
+	{
+		UE_LOG(LogAncientGame, Warning, TEXT("Camera evaluation benchmark needs a world with a camera evaluation subsystem"));
+		return false;
+	}
+
+	NumCameras = FMath::Max(NumCameras, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+
+	const float DeltaTime = 1.f / 60.f;
+	double PassTimes[2] = { 0.0, 0.0 };
+	TArray<FAncientGameCameraModeView> PassViews[2];
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// pass 0 evaluates every camera on its own, as GetCameraView does; pass 1 evaluates them as one batch through the subsystem
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		// fresh cameras for each pass so both start blending from the same state
+		TArray<AActor*> TargetActors;
+		TArray<UAncientGameCameraComponent*> Cameras;
+
+		for (int32 CameraIndex = 0; CameraIndex < NumCameras; ++CameraIndex)
+		{
+			AActor* TargetActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+
+			USceneComponent* Root = NewObject<USceneComponent>(TargetActor);
+			TargetActor->SetRootComponent(Root);
+			Root->RegisterComponent();
+
+			UAncientGameCameraComponent* Camera = NewObject<UAncientGameCameraComponent>(TargetActor);
+			Camera->SetupAttachment(Root);
+			Camera->RegisterComponent();
+			Camera->PushCameraMode(USpringArmCameraMode::StaticClass());
+
+			TargetActors.Add(TargetActor);
+			Cameras.Add(Camera);
+		}
+
+		FAncientGameCameraModeView View;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			// keep the targets moving so the springs have work to do
+			for (int32 CameraIndex = 0; CameraIndex < NumCameras; ++CameraIndex)
+			{
+				const float Time = Frame * DeltaTime + CameraIndex;
+				TargetActors[CameraIndex]->SetActorLocationAndRotation(FVector(CameraIndex * 2000.f, 200.f * FMath::Sin(Time), 0.f), FRotator(0.f, 45.f * FMath::Sin(Time * 0.5f), 0.f));
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			if (Pass == 0)
+			{
+				for (UAncientGameCameraComponent* Camera : Cameras)
+				{
+					Camera->BlendingStack.EvaluateStack(DeltaTime, Camera->GetOwner(), View);
+				}
+			}
+			else
+			{
+				EvaluationSubsystem->EvaluateCameras(Cameras, DeltaTime);
+			}
+			PassTimes[Pass] += FPlatformTime::Seconds() - StartTime;
+		}
+
+		for (UAncientGameCameraComponent* Camera : Cameras)
+		{
+			if (Pass == 0)
+			{
+				Camera->BlendingStack.BlendStack(View);
+				PassViews[Pass].Add(View);
+			}
+			else
+			{
+				PassViews[Pass].Add(Camera->EvaluatedView);
+			}
+		}
+
+		for (AActor* TargetActor : TargetActors)
+		{
+			TargetActor->Destroy();
+		}
+	}
+
+	UE_LOG(LogAncientGame, Log, TEXT("Camera evaluation benchmark, %d cameras over %d frames: serial %.3f ms, parallel %.3f ms (%.2fx)"),
+		NumCameras, NumFrames, PassTimes[0] * 1000.0, PassTimes[1] * 1000.0, PassTimes[1] > 0.0 ? PassTimes[0] / PassTimes[1] : 0.0);
+
+	// both passes run the same math in the same order per camera, so the views have to match
+	bool bPassed = true;
+	for (int32 CameraIndex = 0; CameraIndex < NumCameras; ++CameraIndex)
+	{
+		bPassed &= PassViews[0][CameraIndex].Location.Equals(PassViews[1][CameraIndex].Location, 0.01f);
+		bPassed &= PassViews[0][CameraIndex].Rotation.Equals(PassViews[1][CameraIndex].Rotation, 0.01f);
+	}
+
+	UE_LOG(LogAncientGame, Log, TEXT("%s"), bPassed ? TEXT("... TEST PASSED!") : TEXT("... TEST FAILED!"));
+	return bPassed;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CameraEvaluationBenchmarkCommand(
+	TEXT("AncientGame.Camera.ParallelEvaluationBenchmark"),
+	TEXT("Compare serial and parallel evaluation of spring arm cameras, doubling the camera count from 1 up to NumCameras. Usage: AncientGame.Camera.ParallelEvaluationBenchmark [NumCameras] [NumFrames]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumCameras = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 16;
+		const int32 NumFrames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 600;
+
+		for (int32 Count = 1; Count < NumCameras; Count *= 2)
+		{
+			FAncientGameCameraModeTests::RunParallelEvaluationBenchmark(World, Count, NumFrames);
+		}
+		FAncientGameCameraModeTests::RunParallelEvaluationBenchmark(World, NumCameras, NumFrames);
+	}));
@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AncientGameCameraEvaluationSubsystem.generated.h"
+
+class UAncientGameCameraComponent;
+
+/**
+ * UAncientGameCameraEvaluationSubsystem
+ *
+ *	Evaluates the views of every camera component of a world that needs one this frame in one batch,
+ *	for spectator, killcam and picture-in-picture setups running several cameras at once.
+ *	Blending, Blueprint events and collision traces run on the game thread, native view updates and stack blends run in parallel tasks.
+ */
+UCLASS()
+class ANCIENTGAME_API UAncientGameCameraEvaluationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterCameraComponent(UAncientGameCameraComponent* CameraComponent);
+	void UnregisterCameraComponent(UAncientGameCameraComponent* CameraComponent);
+
+	// Evaluates the cameras that requested a view last frame, once per frame. DeltaTime of the first request is used for all of them.
+	void EvaluateFrame(float DeltaTime);
+
+	// Evaluates the given cameras right away, leaving their views to be picked up this frame.
+	void EvaluateCameras(TArrayView<UAncientGameCameraComponent* const> Cameras, float DeltaTime);
+
+	int32 GetNumCameraComponents() const { return CameraComponents.Num(); }
+
+private:
+	TArray<TWeakObjectPtr<UAncientGameCameraComponent>> CameraComponents;
+
+	// Cameras gathered for the current frame, kept to avoid reallocating every frame
+	TArray<UAncientGameCameraComponent*> FrameCameras;
+
+	uint64 LastEvaluatedFrame = MAX_uint64;
+};
@@ -4,6 +4,9 @@
 #include "GameFramework/Pawn.h"
 #include "GameFramework/Character.h"
 #include "Components/CapsuleComponent.h"
+#include "Camera/AncientGameCameraTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Mode Pivot"), STAT_AncientGameCameraModePivot, STATGROUP_AncientGameCamera);
 
 /* FAncientGameCameraModeView
  *****************************************************************************/
@@ -70,10 +73,37 @@ void UAncientGameCameraMode::OnDeactivation()
 
 void UAncientGameCameraMode::UpdateCameraMode(float DeltaTime, AActor* TargetActor)
 {
-	View = UpdateView(DeltaTime, TargetActor);
+	View = CallUpdateView(DeltaTime, TargetActor);
 	UpdateBlending(DeltaTime);
 }
 
+bool UAncientGameCameraMode::CanUpdateViewInParallel() const
+{
+	return false;
+}
+
+bool UAncientGameCameraMode::IsViewScripted() const
+{
+	return bUpdateViewInScript || bGetPivotLocationInScript || bGetPivotRotationInScript;
+}
+
+FAncientGameCameraModeView UAncientGameCameraMode::CallUpdateView(float DeltaTime, AActor* TargetActor)
+{
+	return bUpdateViewInScript ? UpdateView(DeltaTime, TargetActor) : UpdateView_Implementation(DeltaTime, TargetActor);
+}
+
+FVector UAncientGameCameraMode::CallGetPivotLocation(AActor* TargetActor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_AncientGameCameraModePivot);
+	return bGetPivotLocationInScript ? GetPivotLocation(TargetActor) : GetPivotLocation_Implementation(TargetActor);
+}
+
+FRotator UAncientGameCameraMode::CallGetPivotRotation(AActor* TargetActor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_AncientGameCameraModePivot);
+	return bGetPivotRotationInScript ? GetPivotRotation(TargetActor) : GetPivotRotation_Implementation(TargetActor);
+}
+
 void UAncientGameCameraMode::SetBlendWeight(float Weight)
 {
 	BlendWeight = FMath::Clamp(Weight, 0.0f, 1.0f);
@@ -112,8 +142,8 @@ void UAncientGameCameraMode::SetBlendWeight(float Weight)
 FAncientGameCameraModeView UAncientGameCameraMode::UpdateView_Implementation(float DeltaTime, AActor* TargetActor)
 {
 	FAncientGameCameraModeView NewView;
-	NewView.Location = NewView.PivotLocation = GetPivotLocation(TargetActor);
-	NewView.Rotation = GetPivotRotation(TargetActor);
+	NewView.Location = NewView.PivotLocation = CallGetPivotLocation(TargetActor);
+	NewView.Rotation = CallGetPivotRotation(TargetActor);
 	NewView.Rotation.Pitch = FMath::ClampAngle(NewView.Rotation.Pitch, ViewPitchMin, ViewPitchMax);
 	NewView.FieldOfView = FieldOfView;
 
@@ -138,18 +168,13 @@ FVector UAncientGameCameraMode::GetPivotLocation_Implementation(AActor* TargetAc
 		// Height adjustments for characters to account for crouching.
 		if (const ACharacter* TargetCharacter = Cast<ACharacter>(TargetPawn))
 		{
-			const ACharacter* TargetCharacterCDO = TargetCharacter->GetClass()->GetDefaultObject<ACharacter>();
-			check(TargetCharacterCDO);
+			CachePivotDefaults(TargetCharacter);
 
 			const UCapsuleComponent* CapsuleComp = TargetCharacter->GetCapsuleComponent();
 			check(CapsuleComp);
 
-			const UCapsuleComponent* CapsuleCompCDO = TargetCharacterCDO->GetCapsuleComponent();
-			check(CapsuleCompCDO);
-
-			const float DefaultHalfHeight = CapsuleCompCDO->GetUnscaledCapsuleHalfHeight();
 			const float ActualHalfHeight = CapsuleComp->GetUnscaledCapsuleHalfHeight();
-			const float HeightAdjustment = (DefaultHalfHeight - ActualHalfHeight) + TargetCharacterCDO->BaseEyeHeight;
+			const float HeightAdjustment = (PivotDefaultHalfHeight - ActualHalfHeight) + PivotBaseEyeHeight;
 
 			ViewLocation = TargetCharacter->GetActorLocation() + (FVector::UpVector * HeightAdjustment);
 		}
@@ -228,6 +253,9 @@ void UAncientGameCameraMode::UpdateBlending(float DeltaTime)
 
 void UAncientGameCameraMode::ActivateInternal(AActor* TargetActor)
 {
+	CacheScriptOverrides();
+	PivotDefaultsClass.Reset();
+
 	OnActivation(TargetActor);
 	bIsActivated = true;
 }
@@ -237,3 +265,30 @@ void UAncientGameCameraMode::DeactivateInternal()
 	OnDeactivation();
 	bIsActivated = false;
 }
+
+void UAncientGameCameraMode::CacheScriptOverrides()
+{
+	const UClass* ModeClass = GetClass();
+	bUpdateViewInScript = ModeClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UAncientGameCameraMode, UpdateView));
+	bGetPivotLocationInScript = ModeClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UAncientGameCameraMode, GetPivotLocation));
+	bGetPivotRotationInScript = ModeClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UAncientGameCameraMode, GetPivotRotation));
+}
+
+void UAncientGameCameraMode::CachePivotDefaults(const ACharacter* TargetCharacter) const
+{
+	const UClass* TargetClass = TargetCharacter->GetClass();
+	if (PivotDefaultsClass.Get() == TargetClass)
+	{
+		return;
+	}
+
+	const ACharacter* TargetCharacterCDO = TargetClass->GetDefaultObject<ACharacter>();
+	check(TargetCharacterCDO);
+
+	const UCapsuleComponent* CapsuleCompCDO = TargetCharacterCDO->GetCapsuleComponent();
+	check(CapsuleCompCDO);
+
+	PivotDefaultsClass = TargetClass;
+	PivotDefaultHalfHeight = CapsuleCompCDO->GetUnscaledCapsuleHalfHeight();
+	PivotBaseEyeHeight = TargetCharacterCDO->BaseEyeHeight;
+}
@@ -5,6 +5,8 @@
 #include "Camera/AncientGameCameraModeView.h"
 #include "AncientGameCameraMode.generated.h"
 
+class ACharacter;
+
 /**
  * EAncientGameCameraModeBlendFunction
  *
@@ -73,6 +75,10 @@ public:
 
 	void UpdateCameraMode(float DeltaTime, AActor* TargetActor);
 
+	// Whether the view can be updated on a worker thread during parallel camera evaluation.
+	// Modes opt in once their UpdateView is known to be thread safe, the base mode reads actors and components on the game thread.
+	virtual bool CanUpdateViewInParallel() const;
+
 	const FAncientGameCameraModeView& GetCameraModeView() const { return View; }
 
 	UFUNCTION(BlueprintPure, Category = "AncientGame|Camera")
@@ -97,9 +103,20 @@ protected:
 
 	UFUNCTION(BlueprintNativeEvent, BlueprintPure, Category = "AncientGame|Camera", meta = (BlueprintProtected))
 	FRotator GetPivotRotation(AActor* TargetActor) const;
+
+	// Call the events directly when no Blueprint overrides them, skipping ProcessEvent.
+	FAncientGameCameraModeView CallUpdateView(float DeltaTime, AActor* TargetActor);
+	FVector CallGetPivotLocation(AActor* TargetActor) const;
+	FRotator CallGetPivotRotation(AActor* TargetActor) const;
+
+	// Whether any of the view events is overridden in Blueprint, those are always updated on the game thread.
+	bool IsViewScripted() const;
 	
 	void UpdateBlending(float DeltaTime);
 
+	// Game thread work of a view that was updated in parallel, like collision traces. Only called after UpdateView ran with bDeferGameThreadWork set.
+	virtual void FinishUpdateView(AActor* TargetActor) {}
+
 protected:
 	// View output produced by the camera mode.
 	FAncientGameCameraModeView View;
@@ -110,10 +127,34 @@ protected:
 	// Blend weight calculated using the blend alpha and function.
 	float BlendWeight = 1.f;
 
+	// Set while UpdateView runs on a worker thread, anything that needs the game thread has to wait for FinishUpdateView.
+	bool bDeferGameThreadWork = false;
+
 private:
 	void ActivateInternal(AActor* TargetActor);
 	void DeactivateInternal();
 	bool bIsActivated = false;
 
+	// Checks which events a Blueprint overrides, done on activation.
+	void CacheScriptOverrides();
+
+	// Caches the target character class' default capsule half height and eye height.
+	void CachePivotDefaults(const ACharacter* TargetCharacter) const;
+
+	// Whether the events are overridden in Blueprint and have to go through ProcessEvent.
+	// Assume they are until the mode has been activated.
+	bool bUpdateViewInScript = true;
+	bool bGetPivotLocationInScript = true;
+	bool bGetPivotRotationInScript = true;
+
+	// Claimed by a stack for the parallel phase of this frame's evaluation.
+	bool bPendingParallelUpdate = false;
+
+	// Class defaults of the target character, refreshed on activation or when the target changes class.
+	mutable TWeakObjectPtr<const UClass> PivotDefaultsClass;
+	mutable float PivotDefaultHalfHeight = 0.f;
+	mutable float PivotBaseEyeHeight = 0.f;
+
 	friend struct FAncientGameCameraModeStack;
+	friend struct FAncientGameCameraModeTests;
 };
@@ -5,6 +5,55 @@
 #include "GameFramework/Pawn.h"
 #include "GameFramework/Character.h"
 #include "Components/CapsuleComponent.h"
+#include "AncientGame.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/Package.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/AncientGameCameraTrace.h"
+#include "Camera/AncientGameCameraComponent.h"
+#include "Misc/AutomationTest.h"
+
+DECLARE_CYCLE_STAT(TEXT("Evaluate Camera Mode Stack"), STAT_AncientGameCameraEvaluateStack, STATGROUP_AncientGameCamera);
+DECLARE_CYCLE_STAT(TEXT("Update Camera Mode View"), STAT_AncientGameCameraUpdateModeView, STATGROUP_AncientGameCamera);
+DECLARE_CYCLE_STAT(TEXT("Blend Camera Mode Stack"), STAT_AncientGameCameraBlendStack, STATGROUP_AncientGameCamera);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stacked Camera Modes"), STAT_AncientGameCameraStackedModes, STATGROUP_AncientGameCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Mode Updates"), STAT_AncientGameCameraModeUpdates, STATGROUP_AncientGameCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Blueprint Camera Mode Updates"), STAT_AncientGameCameraBlueprintModeUpdates, STATGROUP_AncientGameCamera);
+
+namespace AncientGameCameraModeStack_Impl
+{
+	// Counts a mode's view update and times it for the camera trace channel.
+	struct FScopedModeUpdate
+	{
+		FScopedModeUpdate(const UAncientGameCameraMode* InCameraMode, int32 InStackIndex, bool bInScript)
+			: CameraMode(InCameraMode)
+			, StackIndex(InStackIndex)
+			, bScript(bInScript)
+			, StartCycle(AncientGameCameraTrace::IsEnabled() ? FPlatformTime::Cycles64() : 0)
+		{
+			INC_DWORD_STAT(STAT_AncientGameCameraModeUpdates);
+			if (bScript)
+			{
+				INC_DWORD_STAT(STAT_AncientGameCameraBlueprintModeUpdates);
+			}
+		}
+
+		~FScopedModeUpdate()
+		{
+			if (StartCycle != 0)
+			{
+				AncientGameCameraTrace::TraceModeUpdate(CameraMode, StartCycle, FPlatformTime::Cycles64(), StackIndex, bScript);
+			}
+		}
+
+		const UAncientGameCameraMode* CameraMode;
+		int32 StackIndex;
+		bool bScript;
+		uint64 StartCycle;
+	};
+}
 
 /* FAncientGameCameraModeStack
  *****************************************************************************/
@@ -16,9 +65,7 @@ void FAncientGameCameraModeStack::PushCameraMode(UAncientGameCameraMode* CameraM
 		return;
 	}
 
-	int32 StackSize = CameraModeStack.Num();
-
-	if ((StackSize > 0) && (CameraModeStack[0] == CameraModeInstance))
+	if ((StackSize > 0) && (GetStackEntry(0) == CameraModeInstance))
 	{
 		// Already top of stack.
 		return;
@@ -31,7 +78,7 @@ void FAncientGameCameraModeStack::PushCameraMode(UAncientGameCameraMode* CameraM
 
 	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
 	{
-		if (CameraModeStack[StackIndex] == CameraModeInstance)
+		if (GetStackEntry(StackIndex) == CameraModeInstance)
 		{
 			ExistingStackIndex = StackIndex;
 			ExistingStackContribution *= CameraModeInstance->GetBlendWeight();
@@ -39,18 +86,56 @@ void FAncientGameCameraModeStack::PushCameraMode(UAncientGameCameraMode* CameraM
 		}
 		else
 		{
-			ExistingStackContribution *= (1.0f - CameraModeStack[StackIndex]->GetBlendWeight());
+			ExistingStackContribution *= (1.0f - GetStackEntry(StackIndex)->GetBlendWeight());
 		}
 	}
 
-	if (ExistingStackIndex != INDEX_NONE)
+	// Close the gap by shifting the modes above it down, freeing the top slot.
+	auto CloseStackGap = [this](int32 GapIndex)
 	{
-		CameraModeStack.RemoveAt(ExistingStackIndex);
+		for (int32 StackIndex = GapIndex; StackIndex > 0; --StackIndex)
+		{
+			GetStackEntry(StackIndex) = GetStackEntry(StackIndex - 1);
+		}
+
+		GetStackEntry(0) = nullptr;
+		StackHead = (StackHead + 1) % MaxStackSize;
 		StackSize--;
+	};
+
+	if (ExistingStackIndex != INDEX_NONE)
+	{
+		CloseStackGap(ExistingStackIndex);
 	}
 	else
 	{
 		ExistingStackContribution = 0.0f;
+
+		// No room left. The bottom mode is the base everything else blends over, so dropping it would pop the view.
+		// The mode above it that contributes least to the blended view makes way instead.
+		if (StackSize == MaxStackSize)
+		{
+			int32 DropStackIndex = 0;
+			float DropStackContribution = MAX_flt;
+			float StackContribution = 1.0f;
+
+			for (int32 StackIndex = 0; StackIndex < (StackSize - 1); ++StackIndex)
+			{
+				const float ModeBlendWeight = GetStackEntry(StackIndex)->GetBlendWeight();
+
+				if ((StackContribution * ModeBlendWeight) < DropStackContribution)
+				{
+					DropStackIndex = StackIndex;
+					DropStackContribution = (StackContribution * ModeBlendWeight);
+				}
+
+				StackContribution *= (1.0f - ModeBlendWeight);
+			}
+
+			UAncientGameCameraMode* DroppedCameraMode = GetStackEntry(DropStackIndex);
+			CloseStackGap(DropStackIndex);
+			DroppedCameraMode->DeactivateInternal();
+		}
 	}
 
 	// Decide what initial weight to start with.
@@ -60,10 +145,12 @@ void FAncientGameCameraModeStack::PushCameraMode(UAncientGameCameraMode* CameraM
 	CameraModeInstance->SetBlendWeight(BlendWeight);
 
 	// Add new entry to top of stack.
-	CameraModeStack.Insert(CameraModeInstance, 0);
+	StackHead = (StackHead + MaxStackSize - 1) % MaxStackSize;
+	StackSize++;
+	GetStackEntry(0) = CameraModeInstance;
 
 	// Make sure stack bottom is always weighted 100%.
-	CameraModeStack.Last()->SetBlendWeight(1.0f);
+	GetStackEntry(StackSize - 1)->SetBlendWeight(1.0f);
 
 	// Let the camera mode know if it's being added to the stack.
 	if (ExistingStackIndex == INDEX_NONE)
@@ -74,31 +161,38 @@ void FAncientGameCameraModeStack::PushCameraMode(UAncientGameCameraMode* CameraM
 
 bool FAncientGameCameraModeStack::EvaluateStack(float DeltaTime, AActor* TargetActor, FAncientGameCameraModeView& OutCameraModeView)
 {
-	if (!UpdateStack(DeltaTime, TargetActor))
+	SCOPE_CYCLE_COUNTER(STAT_AncientGameCameraEvaluateStack);
+	const uint64 StartCycle = AncientGameCameraTrace::IsEnabled() ? FPlatformTime::Cycles64() : 0;
+
+	const bool bHasValidCameraMode = UpdateStack(DeltaTime, TargetActor);
+	if (bHasValidCameraMode)
 	{
-		return false;
+		BlendStack(OutCameraModeView);
 	}
 
-	BlendStack(OutCameraModeView);
-	return true;
+	INC_DWORD_STAT_BY(STAT_AncientGameCameraStackedModes, StackSize);
+	if (StartCycle != 0)
+	{
+		AncientGameCameraTrace::TraceStackEvaluate(StartCycle, FPlatformTime::Cycles64(), StackSize);
+	}
+
+	return bHasValidCameraMode;
 }
 
 bool FAncientGameCameraModeStack::UpdateStack(float DeltaTime, AActor* TargetActor)
 {
-	const int32 StackSize = CameraModeStack.Num();
 	if (StackSize <= 0)
 	{
 		return false;
 	}
 
-	int32 RemoveCount = 0;
 	int32 RemoveIndex = INDEX_NONE;
 
 	bool bHasValidCameraMode = false;
 
 	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
 	{
-		UAncientGameCameraMode* CameraMode = CameraModeStack[StackIndex];
+		UAncientGameCameraMode* CameraMode = GetStackEntry(StackIndex);
 		check(CameraMode);
 
 		// The camera mode could request the current view on activation, which would trigger updating the camera mode before it is activated
@@ -106,53 +200,350 @@ bool FAncientGameCameraModeStack::UpdateStack(float DeltaTime, AActor* TargetAct
 		if (CameraMode->bIsActivated)
 		{
 			bHasValidCameraMode = true;
-			CameraMode->UpdateCameraMode(DeltaTime, TargetActor);
+
+			{
+				SCOPE_CYCLE_COUNTER(STAT_AncientGameCameraUpdateModeView);
+				AncientGameCameraModeStack_Impl::FScopedModeUpdate ScopedModeUpdate(CameraMode, StackIndex, CameraMode->bUpdateViewInScript);
+				CameraMode->UpdateCameraMode(DeltaTime, TargetActor);
+			}
 
 			if (CameraMode->GetBlendWeight() >= 1.0f)
 			{
 				// Everything below this mode is now irrelevant and can be removed.
 				RemoveIndex = (StackIndex + 1);
-				RemoveCount = (StackSize - RemoveIndex);
 				break;
 			}
 		}
 	}
 
-	if (RemoveCount > 0)
+	if (RemoveIndex != INDEX_NONE)
 	{
-		// Let the camera modes know they being removed from the stack.
-		for (int32 StackIndex = RemoveIndex; StackIndex < StackSize; ++StackIndex)
+		RemoveFromStackIndex(RemoveIndex);
+	}
+	return bHasValidCameraMode;
+}
+
+bool FAncientGameCameraModeStack::BeginParallelEvaluation(float DeltaTime, AActor* TargetActor)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AncientGameCameraEvaluateStack);
+	const uint64 StartCycle = AncientGameCameraTrace::IsEnabled() ? FPlatformTime::Cycles64() : 0;
+
+	ParallelUpdateMask = 0;
+
+	if (StackSize <= 0)
+	{
+		return false;
+	}
+
+	int32 RemoveIndex = INDEX_NONE;
+
+	bool bHasValidCameraMode = false;
+
+	// Blending doesn't depend on the views, so the modes that blended out are known before any view is updated.
+	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
+	{
+		UAncientGameCameraMode* CameraMode = GetStackEntry(StackIndex);
+		check(CameraMode);
+
+		if (CameraMode->bIsActivated)
+		{
+			bHasValidCameraMode = true;
+			CameraMode->UpdateBlending(DeltaTime);
+
+			if (CameraMode->GetBlendWeight() >= 1.0f)
+			{
+				RemoveIndex = (StackIndex + 1);
+				break;
+			}
+		}
+	}
+
+	if (RemoveIndex != INDEX_NONE)
+	{
+		RemoveFromStackIndex(RemoveIndex);
+	}
+
+	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
+	{
+		UAncientGameCameraMode* CameraMode = GetStackEntry(StackIndex);
+
+		if (!CameraMode->bIsActivated)
 		{
-			UAncientGameCameraMode* CameraMode = CameraModeStack[StackIndex];
-			check(CameraMode);
+			continue;
+		}
 
-			CameraMode->DeactivateInternal();
+		// A mode instance shared with a stack that already claimed it is updated here, so no two tasks touch it.
+		if (CameraMode->CanUpdateViewInParallel() && !CameraMode->bPendingParallelUpdate)
+		{
+			CameraMode->bPendingParallelUpdate = true;
+			ParallelUpdateMask |= (1u << StackIndex);
+		}
+		else
+		{
+			SCOPE_CYCLE_COUNTER(STAT_AncientGameCameraUpdateModeView);
+			AncientGameCameraModeStack_Impl::FScopedModeUpdate ScopedModeUpdate(CameraMode, StackIndex, CameraMode->bUpdateViewInScript);
+			CameraMode->View = CameraMode->CallUpdateView(DeltaTime, TargetActor);
 		}
+	}
 
-		CameraModeStack.RemoveAt(RemoveIndex, RemoveCount);
+	INC_DWORD_STAT_BY(STAT_AncientGameCameraStackedModes, StackSize);
+	if (StartCycle != 0)
+	{
+		AncientGameCameraTrace::TraceStackEvaluate(StartCycle, FPlatformTime::Cycles64(), StackSize);
 	}
+
 	return bHasValidCameraMode;
 }
 
+void FAncientGameCameraModeStack::UpdateViewsInParallel(float DeltaTime, AActor* TargetActor)
+{
+	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
+	{
+		if (ParallelUpdateMask & (1u << StackIndex))
+		{
+			UAncientGameCameraMode* CameraMode = GetStackEntry(StackIndex);
+
+			SCOPE_CYCLE_COUNTER(STAT_AncientGameCameraUpdateModeView);
+			AncientGameCameraModeStack_Impl::FScopedModeUpdate ScopedModeUpdate(CameraMode, StackIndex, false);
+
+			CameraMode->bDeferGameThreadWork = true;
+			CameraMode->View = CameraMode->UpdateView_Implementation(DeltaTime, TargetActor);
+		}
+	}
+}
+
+void FAncientGameCameraModeStack::FinishParallelEvaluation(AActor* TargetActor)
+{
+	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
+	{
+		if (ParallelUpdateMask & (1u << StackIndex))
+		{
+			UAncientGameCameraMode* CameraMode = GetStackEntry(StackIndex);
+
+			if (CameraMode->bDeferGameThreadWork)
+			{
+				CameraMode->FinishUpdateView(TargetActor);
+			}
+
+			CameraMode->bDeferGameThreadWork = false;
+			CameraMode->bPendingParallelUpdate = false;
+		}
+	}
+
+	ParallelUpdateMask = 0;
+}
+
+void FAncientGameCameraModeStack::RemoveFromStackIndex(int32 StackIndex)
+{
+	// Let the camera modes know they being removed from the stack.
+	for (int32 RemoveIndex = StackIndex; RemoveIndex < StackSize; ++RemoveIndex)
+	{
+		UAncientGameCameraMode*& CameraMode = GetStackEntry(RemoveIndex);
+		check(CameraMode);
+
+		CameraMode->DeactivateInternal();
+		CameraMode = nullptr;
+	}
+
+	StackSize = FMath::Min(StackSize, StackIndex);
+}
+
 void FAncientGameCameraModeStack::BlendStack(FAncientGameCameraModeView& OutCameraModeView) const
 {
-	const int32 StackSize = CameraModeStack.Num();
+	SCOPE_CYCLE_COUNTER(STAT_AncientGameCameraBlendStack);
+
 	if (StackSize <= 0)
 	{
 		return;
 	}
 
 	// Start at the bottom and blend up the stack
-	const UAncientGameCameraMode* CameraMode = CameraModeStack[StackSize - 1];
+	const UAncientGameCameraMode* CameraMode = GetStackEntry(StackSize - 1);
 	check(CameraMode);
 
 	OutCameraModeView = CameraMode->GetCameraModeView();
 
 	for (int32 StackIndex = (StackSize - 2); StackIndex >= 0; --StackIndex)
 	{
-		CameraMode = CameraModeStack[StackIndex];
+		CameraMode = GetStackEntry(StackIndex);
 		check(CameraMode);
 
 		OutCameraModeView.Blend(CameraMode->GetCameraModeView(), CameraMode->GetBlendWeight());
 	}
-}
\ No newline at end of file
+}
+
+
+/* FAncientGameCameraModeTests
+ *****************************************************************************/
+
+bool FAncientGameCameraModeTests::RunNativeFastPathBenchmark(AActor* TargetActor, int32 StackDepth, int32 NumFrames)
+{
+	StackDepth = FMath::Clamp(StackDepth, 1, FAncientGameCameraModeStack::MaxStackSize);
+	NumFrames = FMath::Max(NumFrames, 1);
+
+	const float DeltaTime = 1.f / 60.f;
+	double PassTimes[2] = { 0.0, 0.0 };
+	FAncientGameCameraModeView PassViews[2];
+
+	// pass 0 forces every event through ProcessEvent, as before the fast path; pass 1 uses the cached native calls
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		FAncientGameCameraModeStack Stack;
+
+		for (int32 ModeIndex = 0; ModeIndex < StackDepth; ++ModeIndex)
+		{
+			UAncientGameCameraMode* CameraMode = NewObject<UAncientGameCameraMode>(GetTransientPackage());
+
+			// long blends keep every mode in the stack contributing for the whole run
+			CameraMode->BlendTime = 1000.f;
+			Stack.PushCameraMode(CameraMode, TargetActor);
+
+			if (Pass == 0)
+			{
+				CameraMode->bUpdateViewInScript = true;
+				CameraMode->bGetPivotLocationInScript = true;
+				CameraMode->bGetPivotRotationInScript = true;
+			}
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Stack.EvaluateStack(DeltaTime, TargetActor, PassViews[Pass]);
+		}
+		PassTimes[Pass] = FPlatformTime::Seconds() - StartTime;
+	}
+
+	UE_LOG(LogAncientGame, Log, TEXT("Camera mode stack benchmark, %d modes over %d frames: ProcessEvent %.3f ms, native %.3f ms (%.2fx)"),
+		StackDepth, NumFrames, PassTimes[0] * 1000.0, PassTimes[1] * 1000.0, PassTimes[1] > 0.0 ? PassTimes[0] / PassTimes[1] : 0.0);
+
+	// both paths run the same native implementations, so they have to agree
+	const bool bPassed = PassViews[0].Location.Equals(PassViews[1].Location) && PassViews[0].Rotation.Equals(PassViews[1].Rotation);
+	UE_LOG(LogAncientGame, Log, TEXT("%s"), bPassed ? TEXT("... TEST PASSED!") : TEXT("... TEST FAILED!"));
+	return bPassed;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CameraModeStackBenchmarkCommand(
+	TEXT("AncientGame.Camera.ModeStackBenchmark"),
+	TEXT("Compare camera mode stack evaluation through ProcessEvent and the native fast path, targeting the first player's pawn. Usage: AncientGame.Camera.ModeStackBenchmark [StackDepth] [NumFrames]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 StackDepth = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 16;
+		const int32 NumFrames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1000;
+
+		APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		AActor* TargetActor = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+		FAncientGameCameraModeTests::RunNativeFastPathBenchmark(TargetActor, StackDepth, NumFrames);
+	}));
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+bool FAncientGameCameraModeTests::RunTraceTest()
+{
+	bool bPassed = true;
+
+#if UE_TRACE_ENABLED
+	auto Check = [&bPassed](bool bCondition, const TCHAR* Description)
+	{
+		if (!bCondition)
+		{
+			UE_LOG(LogAncientGame, Warning, TEXT("Camera trace test: FAILED %s"), Description);
+			bPassed = false;
+		}
+	};
+
+	auto CountRecords = [](const TArray<FAncientGameCameraTraceRecord>& Records, FAncientGameCameraTraceRecord::EType Type)
+	{
+		return Records.FilterByPredicate([Type](const FAncientGameCameraTraceRecord& Record) { return Record.Type == Type; }).Num();
+	};
+
+	// the recorder gets a copy of what is sent on the channel, so it checks what a trace session receives
+	const bool bWasChannelEnabled = UE_TRACE_CHANNELEXPR_IS_ENABLED(AncientGameCameraChannel);
+
+	TArray<FAncientGameCameraTraceRecord> Records;
+	AncientGameCameraTrace::SetRecorder(&Records);
+
+	// nothing is sent while the channel is off
+	{
+		UE::Trace::ToggleChannel(TEXT("AncientGameCamera"), false);
+		Check(!AncientGameCameraTrace::IsEnabled(), TEXT("disabling the AncientGameCamera channel disables the trace"));
+
+		UAncientGameCameraComponent* CameraComponent = NewObject<UAncientGameCameraComponent>(GetTransientPackage());
+		CameraComponent->PushCameraMode(UAncientGameCameraMode::StaticClass());
+		Check(Records.Num() == 0, TEXT("a disabled channel sends no events"));
+	}
+
+	UE::Trace::ToggleChannel(TEXT("AncientGameCamera"), true);
+	Check(AncientGameCameraTrace::IsEnabled(), TEXT("enabling the AncientGameCamera channel enables the trace"));
+
+	// pool lookups, the first push of a class creates the instance and the second one reuses it
+	{
+		UAncientGameCameraComponent* CameraComponent = NewObject<UAncientGameCameraComponent>(GetTransientPackage());
+		CameraComponent->PushCameraMode(UAncientGameCameraMode::StaticClass());
+		CameraComponent->PushCameraMode(UAncientGameCameraMode::StaticClass());
+
+		const TArray<FAncientGameCameraTraceRecord> PoolLookups = Records.FilterByPredicate([](const FAncientGameCameraTraceRecord& Record) { return Record.Type == FAncientGameCameraTraceRecord::EType::PoolLookup; });
+		Check(PoolLookups.Num() == 2, TEXT("every push traces a pool lookup"));
+		Check(PoolLookups.Num() == 2 && !PoolLookups[0].bFlag && PoolLookups[1].bFlag, TEXT("pool lookups report misses then hits"));
+		Check(PoolLookups.Num() == 2 && PoolLookups[0].ModeClass == UAncientGameCameraMode::StaticClass()->GetFName(), TEXT("pool lookups report the mode class"));
+	}
+
+	// a stack of modes that are all blending
+	{
+		const int32 StackDepth = 3;
+		FAncientGameCameraModeStack Stack;
+		TArray<UAncientGameCameraMode*> CameraModes;
+
+		for (int32 ModeIndex = 0; ModeIndex < StackDepth; ++ModeIndex)
+		{
+			UAncientGameCameraMode* CameraMode = NewObject<UAncientGameCameraMode>(GetTransientPackage());
+			CameraMode->BlendTime = 1000.f;
+			Stack.PushCameraMode(CameraMode, nullptr);
+			CameraModes.Insert(CameraMode, 0);
+		}
+
+		Records.Reset();
+
+		FAncientGameCameraModeView View;
+		Stack.EvaluateStack(1.f / 60.f, nullptr, View);
+
+		Check(CountRecords(Records, FAncientGameCameraTraceRecord::EType::ModeUpdate) == StackDepth, TEXT("every blending mode traces its update"));
+		Check(CountRecords(Records, FAncientGameCameraTraceRecord::EType::StackEvaluate) == 1, TEXT("the evaluation traces the stack"));
+
+		int32 ModeUpdateIndex = 0;
+		for (const FAncientGameCameraTraceRecord& Record : Records)
+		{
+			if (Record.Type == FAncientGameCameraTraceRecord::EType::ModeUpdate)
+			{
+				Check(Record.StackIndex == ModeUpdateIndex, TEXT("mode updates are traced from the top of the stack down"));
+				Check(CameraModes.IsValidIndex(ModeUpdateIndex) && Record.BlendWeight == CameraModes[ModeUpdateIndex]->GetBlendWeight(), TEXT("mode updates report the blend weight"));
+				Check(!Record.bFlag, TEXT("native modes are not reported as Blueprint updates"));
+				++ModeUpdateIndex;
+			}
+			else if (Record.Type == FAncientGameCameraTraceRecord::EType::StackEvaluate)
+			{
+				Check(Record.StackIndex == StackDepth, TEXT("the stack evaluation reports the stack depth"));
+			}
+		}
+	}
+
+	AncientGameCameraTrace::SetRecorder(nullptr);
+	UE::Trace::ToggleChannel(TEXT("AncientGameCamera"), bWasChannelEnabled);
+#else
+	UE_LOG(LogAncientGame, Log, TEXT("Camera trace test skipped, trace is compiled out"));
+#endif
+
+	UE_LOG(LogAncientGame, Log, TEXT("Camera trace test %s"), bPassed ? TEXT("... TEST PASSED!") : TEXT("... TEST FAILED!"));
+	return bPassed;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAncientGameCameraTraceTest, "AncientGame.Camera.ModeStack.Trace", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAncientGameCameraTraceTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Camera mode stack evaluation produces its trace events"), FAncientGameCameraModeTests::RunTraceTest());
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
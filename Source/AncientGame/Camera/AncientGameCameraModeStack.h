@@ -8,11 +8,13 @@
 
 class UAncientGameCameraMode;
 class AActor;
+class UWorld;
 
 /**
  * FAncientGameCameraModeStack
  *
  *	Stack used for blending camera modes.
+ *	Modes live in a fixed-capacity ring, so pushing and popping never allocates. Index 0 is the top of the stack.
  */
 USTRUCT()
 struct FAncientGameCameraModeStack
@@ -20,15 +22,64 @@ struct FAncientGameCameraModeStack
 	GENERATED_BODY()
 
 public:
+	// Modes blending at once; pushing onto a full stack drops the mode above the bottom one that contributes least to the blend.
+	static constexpr int32 MaxStackSize = 16;
+
 	void PushCameraMode(UAncientGameCameraMode* CameraModeInstance, AActor* TargetActor);
 
 	bool EvaluateStack(float DeltaTime, AActor* TargetActor, FAncientGameCameraModeView& OutCameraModeView);
 
+	int32 Num() const { return StackSize; }
+
+	/**
+	 * Phased evaluation used by UAncientGameCameraEvaluationSubsystem, equivalent to EvaluateStack.
+	 * BeginParallelEvaluation and FinishParallelEvaluation run on the game thread, UpdateViewsInParallel and BlendStack can run on any thread.
+	 */
+
+	// Updates blending, removes the modes that blended out and updates the views that can't be updated in parallel.
+	bool BeginParallelEvaluation(float DeltaTime, AActor* TargetActor);
+
+	// Updates the views left for the parallel phase.
+	void UpdateViewsInParallel(float DeltaTime, AActor* TargetActor);
+
+	// Runs the game thread work of the views updated in parallel.
+	void FinishParallelEvaluation(AActor* TargetActor);
+
+	void BlendStack(FAncientGameCameraModeView& OutCameraModeView) const;
+
 protected:
 	bool UpdateStack(float DeltaTime, AActor* TargetActor);
-	void BlendStack(FAncientGameCameraModeView& OutCameraModeView) const;
+
+	UAncientGameCameraMode*& GetStackEntry(int32 StackIndex) { return CameraModeStack[(StackHead + StackIndex) % MaxStackSize]; }
+	UAncientGameCameraMode* GetStackEntry(int32 StackIndex) const { return CameraModeStack[(StackHead + StackIndex) % MaxStackSize]; }
+
+	// Deactivates and drops every mode from StackIndex down to the bottom.
+	void RemoveFromStackIndex(int32 StackIndex);
 
 protected:
 	UPROPERTY()
-	TArray<UAncientGameCameraMode*> CameraModeStack;
+	UAncientGameCameraMode* CameraModeStack[MaxStackSize] = {};
+
+	// Ring position of the top of the stack
+	int32 StackHead = 0;
+	int32 StackSize = 0;
+
+	// Stack indices of the modes claimed for the parallel phase
+	uint32 ParallelUpdateMask = 0;
+	static_assert(MaxStackSize <= 32, "ParallelUpdateMask needs a bit per stack entry");
+};
+
+struct FAncientGameCameraModeTests
+{
+public:
+	/** Evaluates a stack of StackDepth blending camera modes, through ProcessEvent and through the native fast path, and logs both timings. */
+	static bool RunNativeFastPathBenchmark(AActor* TargetActor, int32 StackDepth, int32 NumFrames);
+
+	/** Evaluates NumCameras spring arm cameras serially and through UAncientGameCameraEvaluationSubsystem, and logs both timings. */
+	static bool RunParallelEvaluationBenchmark(UWorld* World, int32 NumCameras, int32 NumFrames);
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/** Evaluates camera mode stacks with the trace channel enabled and checks the mode updates, stack depths and pool lookups sent on it. */
+	static bool RunTraceTest();
+#endif
 };
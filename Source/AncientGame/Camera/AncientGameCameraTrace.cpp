@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Camera/AncientGameCameraTrace.h"
+#include "Camera/AncientGameCameraMode.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+UE_TRACE_CHANNEL_DEFINE(AncientGameCameraChannel);
+
+UE_TRACE_EVENT_BEGIN(AncientGameCamera, ModeUpdate)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(float, BlendWeight)
+	UE_TRACE_EVENT_FIELD(int32, StackIndex)
+	UE_TRACE_EVENT_FIELD(uint8, InScript)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, ModeClass)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AncientGameCamera, StackEvaluate)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(int32, StackDepth)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AncientGameCamera, PoolLookup)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint8, Hit)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, ModeClass)
+UE_TRACE_EVENT_END()
+
+#if WITH_DEV_AUTOMATION_TESTS
+namespace AncientGameCameraTrace
+{
+	// Modes can be updated from parallel camera evaluation tasks
+	static FCriticalSection RecorderCriticalSection;
+	static TArray<FAncientGameCameraTraceRecord>* ActiveRecorder = nullptr;
+	static std::atomic<bool> bHasRecorder(false);
+
+	static void Record(const FAncientGameCameraTraceRecord& TraceRecord)
+	{
+		FScopeLock Lock(&RecorderCriticalSection);
+		if (ActiveRecorder)
+		{
+			ActiveRecorder->Add(TraceRecord);
+		}
+	}
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+bool AncientGameCameraTrace::IsEnabled()
+{
+	return UE_TRACE_CHANNELEXPR_IS_ENABLED(AncientGameCameraChannel);
+}
+
+void AncientGameCameraTrace::TraceModeUpdate(const UAncientGameCameraMode* CameraMode, uint64 StartCycle, uint64 EndCycle, int32 StackIndex, bool bInScript)
+{
+	const FName ModeClass = CameraMode->GetClass()->GetFName();
+
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(AncientGameCameraChannel))
+	{
+		const FString ModeClassString = ModeClass.ToString();
+
+		UE_TRACE_LOG(AncientGameCamera, ModeUpdate, AncientGameCameraChannel)
+			<< ModeUpdate.StartCycle(StartCycle)
+			<< ModeUpdate.EndCycle(EndCycle)
+			<< ModeUpdate.BlendWeight(CameraMode->GetBlendWeight())
+			<< ModeUpdate.StackIndex(StackIndex)
+			<< ModeUpdate.InScript((uint8)bInScript)
+			<< ModeUpdate.ModeClass(*ModeClassString, ModeClassString.Len());
+
+#if WITH_DEV_AUTOMATION_TESTS
+		if (bHasRecorder.load(std::memory_order_relaxed))
+		{
+			FAncientGameCameraTraceRecord TraceRecord;
+			TraceRecord.Type = FAncientGameCameraTraceRecord::EType::ModeUpdate;
+			TraceRecord.ModeClass = ModeClass;
+			TraceRecord.Cycles = EndCycle - StartCycle;
+			TraceRecord.BlendWeight = CameraMode->GetBlendWeight();
+			TraceRecord.StackIndex = StackIndex;
+			TraceRecord.bFlag = bInScript;
+			Record(TraceRecord);
+		}
+#endif
+	}
+}
+
+void AncientGameCameraTrace::TraceStackEvaluate(uint64 StartCycle, uint64 EndCycle, int32 StackDepth)
+{
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(AncientGameCameraChannel))
+	{
+		UE_TRACE_LOG(AncientGameCamera, StackEvaluate, AncientGameCameraChannel)
+			<< StackEvaluate.StartCycle(StartCycle)
+			<< StackEvaluate.EndCycle(EndCycle)
+			<< StackEvaluate.StackDepth(StackDepth);
+
+#if WITH_DEV_AUTOMATION_TESTS
+		if (bHasRecorder.load(std::memory_order_relaxed))
+		{
+			FAncientGameCameraTraceRecord TraceRecord;
+			TraceRecord.Type = FAncientGameCameraTraceRecord::EType::StackEvaluate;
+			TraceRecord.Cycles = EndCycle - StartCycle;
+			TraceRecord.StackIndex = StackDepth;
+			Record(TraceRecord);
+		}
+#endif
+	}
+}
+
+void AncientGameCameraTrace::TracePoolLookup(const UClass* CameraModeClass, bool bHit)
+{
+	const FName ModeClass = CameraModeClass ? CameraModeClass->GetFName() : NAME_None;
+
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(AncientGameCameraChannel))
+	{
+		const FString ModeClassString = ModeClass.ToString();
+
+		UE_TRACE_LOG(AncientGameCamera, PoolLookup, AncientGameCameraChannel)
+			<< PoolLookup.Cycle(FPlatformTime::Cycles64())
+			<< PoolLookup.Hit((uint8)bHit)
+			<< PoolLookup.ModeClass(*ModeClassString, ModeClassString.Len());
+
+#if WITH_DEV_AUTOMATION_TESTS
+		if (bHasRecorder.load(std::memory_order_relaxed))
+		{
+			FAncientGameCameraTraceRecord TraceRecord;
+			TraceRecord.Type = FAncientGameCameraTraceRecord::EType::PoolLookup;
+			TraceRecord.ModeClass = ModeClass;
+			TraceRecord.bFlag = bHit;
+			Record(TraceRecord);
+		}
+#endif
+	}
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+void AncientGameCameraTrace::SetRecorder(TArray<FAncientGameCameraTraceRecord>* Recorder)
+{
+	FScopeLock Lock(&RecorderCriticalSection);
+	ActiveRecorder = Recorder;
+	bHasRecorder.store(Recorder != nullptr, std::memory_order_relaxed);
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+class UAncientGameCameraMode;
+
+DECLARE_STATS_GROUP(TEXT("AncientGame Camera"), STATGROUP_AncientGameCamera, STATCAT_Advanced);
+
+// Trace channel for per-mode camera stack costs, enable with -trace=ancientgamecamera
+UE_TRACE_CHANNEL_EXTERN(AncientGameCameraChannel, ANCIENTGAME_API);
+
+#if WITH_DEV_AUTOMATION_TESTS
+/**
+ * FAncientGameCameraTraceRecord
+ *
+ *	Copy of one event sent on the camera trace channel, handed to the recorder installed with AncientGameCameraTrace::SetRecorder.
+ */
+struct FAncientGameCameraTraceRecord
+{
+	enum class EType : uint8
+	{
+		// A camera mode updated its view
+		ModeUpdate,
+
+		// A camera mode stack was evaluated
+		StackEvaluate,
+
+		// A camera component looked up its camera mode pool
+		PoolLookup,
+	};
+
+	EType Type = EType::ModeUpdate;
+
+	// Class of the camera mode, for mode updates and pool lookups
+	FName ModeClass;
+
+	// Time spent, for mode updates and stack evaluations
+	uint64 Cycles = 0;
+
+	// Blend weight of the mode after its update
+	float BlendWeight = 0.f;
+
+	// Index of the mode in its stack for mode updates, stack depth for stack evaluations
+	int32 StackIndex = 0;
+
+	// Whether the mode update went through Blueprint, or the pool lookup found an instance
+	bool bFlag = false;
+};
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+namespace AncientGameCameraTrace
+{
+	// Whether the camera trace channel is enabled; callers skip timing work otherwise
+	ANCIENTGAME_API bool IsEnabled();
+
+	ANCIENTGAME_API void TraceModeUpdate(const UAncientGameCameraMode* CameraMode, uint64 StartCycle, uint64 EndCycle, int32 StackIndex, bool bInScript);
+	ANCIENTGAME_API void TraceStackEvaluate(uint64 StartCycle, uint64 EndCycle, int32 StackDepth);
+	ANCIENTGAME_API void TracePoolLookup(const UClass* CameraModeClass, bool bHit);
+
+#if WITH_DEV_AUTOMATION_TESTS
+	// Receives a copy of every event sent on the channel while set, so tests can check what the channel gets.
+	ANCIENTGAME_API void SetRecorder(TArray<FAncientGameCameraTraceRecord>* Recorder);
+#endif
+}
@@ -2,6 +2,502 @@
 
 
 #include "Interpolators.h"
+#include "AncientGame.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Algo/Count.h"
+#include "Misc/AutomationTest.h"
+
+namespace InterpolatorBatchHelpers
+{
+	/** Interpolators stepped per vector register. */
+	static constexpr int32 LaneWidth = 4;
+
+	/** Splits an eval into full MaxSubstepTime steps and a trailing partial step, mirroring the scalar substep loops. */
+	static void ComputeSubstepSchedule(float RemainingTime, float MaxSubstepTime, int32& OutNumFullSteps, float& OutPartialStepTime)
+	{
+		OutNumFullSteps = InterpolatorHelpers::CountFullSubsteps(RemainingTime, MaxSubstepTime, OutPartialStepTime);
+
+		// the scalar loops drop a leftover this small
+		if (OutPartialStepTime <= KINDA_SMALL_NUMBER)
+		{
+			OutPartialStepTime = 0.f;
+		}
+	}
+
+	/** Same alpha as FMath::VInterpTo, a non-positive speed jumps straight to the goal. */
+	static FVector::FReal ComputeIIRAlpha(float InterpSpeed, float StepTime)
+	{
+		return InterpSpeed <= 0.f ? 1.f : FMath::Clamp<FVector::FReal>(StepTime * InterpSpeed, 0.f, 1.f);
+	}
+}
+
+void FInterpolatorBatchLanes::SetNum(int32 NewNum)
+{
+	for (TArray<FVector::FReal>& Component : Components)
+	{
+		Component.SetNumZeroed(NewNum);
+	}
+}
+
+void FInterpolatorBatchLanes::Set(int32 Index, const FVector& Value)
+{
+	Components[0][Index] = Value.X;
+	Components[1][Index] = Value.Y;
+	Components[2][Index] = Value.Z;
+}
+
+FVector FInterpolatorBatchLanes::Get(int32 Index) const
+{
+	return FVector(Components[0][Index], Components[1][Index], Components[2][Index]);
+}
+
+void FCritDampSpringInterpolatorBatch::FCoefficients::SetNum(int32 NewNum)
+{
+	DisplacementScale.SetNumZeroed(NewNum);
+	VelocityToDisplacement.SetNumZeroed(NewNum);
+	DisplacementToVelocity.SetNumZeroed(NewNum);
+	VelocityScale.SetNumZeroed(NewNum);
+}
+
+void FCritDampSpringInterpolatorBatch::FCoefficients::Compute(int32 Index, float NaturalFrequency, float StepTime)
+{
+	// same float math as the scalar SingleStepEval, so both paths agree
+	const TCritDampSpringInterpolator<FVector>::FCDSpringScalars Scalars = TCritDampSpringInterpolator<FVector>::ComputeScalars(NaturalFrequency, StepTime);
+	DisplacementScale[Index] = Scalars.ExDTxW + Scalars.E;
+	VelocityToDisplacement[Index] = Scalars.ExDT;
+	DisplacementToVelocity[Index] = -Scalars.ExDTxW * NaturalFrequency;
+	VelocityScale[Index] = Scalars.E - Scalars.ExDTxW;
+}
+
+int32 FCritDampSpringInterpolatorBatch::Add(float NaturalFrequency)
+{
+	int32 Index = INDEX_NONE;
+
+	if (FreeIndices.Num())
+	{
+		Index = FreeIndices.Pop(false);
+	}
+	else
+	{
+		Index = NumSprings++;
+
+		// grow every lane array to the next full vector register
+		const int32 NumLanes = Align(NumSprings, InterpolatorBatchHelpers::LaneWidth);
+
+		if (NumLanes > NaturalFrequencies.Num())
+		{
+			Pos.SetNum(NumLanes);
+			Velocity.SetNum(NumLanes);
+			Goal.SetNum(NumLanes);
+			LastEquilibrium.SetNum(NumLanes);
+			PosAfterLastFullStep.SetNum(NumLanes);
+			VelAfterLastFullStep.SetNum(NumLanes);
+			FullStep.SetNum(NumLanes);
+			PartialStep.SetNum(NumLanes);
+			NaturalFrequencies.SetNumZeroed(NumLanes);
+			PendingResets.SetNumZeroed(NumLanes);
+			FullStepDirty.SetNumZeroed(NumLanes);
+		}
+	}
+
+	NaturalFrequencies[Index] = NaturalFrequency;
+	FullStepDirty[Index] = true;
+	PendingResets[Index] = true;
+
+	return Index;
+}
+
+void FCritDampSpringInterpolatorBatch::Remove(int32 Index)
+{
+	if (Index >= 0 && Index < NumSprings && FreeIndices.Contains(Index) == false)
+	{
+		// leave the lane at rest, it keeps being stepped until reused
+		Pos.Set(Index, FVector::ZeroVector);
+		Velocity.Set(Index, FVector::ZeroVector);
+		Goal.Set(Index, FVector::ZeroVector);
+		LastEquilibrium.Set(Index, FVector::ZeroVector);
+		PendingResets[Index] = false;
+
+		FreeIndices.Add(Index);
+	}
+}
+
+void FCritDampSpringInterpolatorBatch::SetGoal(int32 Index, const FVector& NewEquilibrium)
+{
+	Goal.Set(Index, NewEquilibrium);
+}
+
+void FCritDampSpringInterpolatorBatch::SetNaturalFrequency(int32 Index, float NewNaturalFrequency)
+{
+	if (NaturalFrequencies[Index] != NewNaturalFrequency)
+	{
+		NaturalFrequencies[Index] = NewNaturalFrequency;
+		FullStepDirty[Index] = true;
+	}
+}
+
+void FCritDampSpringInterpolatorBatch::Reset(int32 Index)
+{
+	PendingResets[Index] = true;
+}
+
+void FCritDampSpringInterpolatorBatch::SetInitialValue(int32 Index, const FVector& InitialValue)
+{
+	Pos.Set(Index, InitialValue);
+	Velocity.Set(Index, FVector::ZeroVector);
+	PosAfterLastFullStep.Set(Index, InitialValue);
+	VelAfterLastFullStep.Set(Index, FVector::ZeroVector);
+	PendingResets[Index] = false;
+}
+
+FVector FCritDampSpringInterpolatorBatch::GetCurrentValue(int32 Index) const
+{
+	return Pos.Get(Index);
+}
+
+void FCritDampSpringInterpolatorBatch::EvalSubstepped(float DeltaTime)
+{
+	if (NumSprings == 0)
+	{
+		return;
+	}
+
+	// like the scalar reset, a batch that is only resetting snaps without carrying any leftover time
+	if (Algo::Count(PendingResets, true) == Num())
+	{
+		LastUpdateLeftoverTime = 0.f;
+		DeltaTime = 0.f;
+	}
+
+	float RemainingTime = DeltaTime;
+
+	// handle leftover rewind, every spring rewinds to its state at the end of the last full MaxSubstepTime update
+	const bool bRewind = (LastUpdateLeftoverTime > 0.f);
+	if (bRewind)
+	{
+		RemainingTime += LastUpdateLeftoverTime;
+		LastUpdateLeftoverTime = 0.f;
+	}
+
+	// work out the substep schedule once for the whole batch, mirroring the scalar loop
+	int32 NumFullSteps = 0;
+	float PartialStepTime = 0.f;
+	InterpolatorBatchHelpers::ComputeSubstepSchedule(RemainingTime, MaxSubstepTime, NumFullSteps, PartialStepTime);
+
+	LastUpdateLeftoverTime = PartialStepTime;
+
+	const int32 NumLanes = Align(NumSprings, InterpolatorBatchHelpers::LaneWidth);
+
+	// full step coefficients only change with the natural frequency
+	for (int32 Index = 0; Index < NumLanes; ++Index)
+	{
+		if (FullStepDirty[Index])
+		{
+			FullStep.Compute(Index, NaturalFrequencies[Index], MaxSubstepTime);
+			FullStepDirty[Index] = false;
+		}
+
+		if (PartialStepTime > 0.f)
+		{
+			PartialStep.Compute(Index, NaturalFrequencies[Index], PartialStepTime);
+		}
+	}
+
+	const bool bStepped = (NumFullSteps > 0) || (PartialStepTime > 0.f);
+	const FVector::FReal InvRemainingTime = 1.f / RemainingTime;
+	const VectorRegister4Double InvRemainingTimeReg = MakeVectorRegisterDouble(InvRemainingTime, InvRemainingTime, InvRemainingTime, InvRemainingTime);
+	const VectorRegister4Double FullStepTimeReg = MakeVectorRegisterDouble(MaxSubstepTime, MaxSubstepTime, MaxSubstepTime, MaxSubstepTime);
+	const VectorRegister4Double PartialStepTimeReg = MakeVectorRegisterDouble(PartialStepTime, PartialStepTime, PartialStepTime, PartialStepTime);
+
+	for (int32 Base = 0; Base < NumLanes; Base += InterpolatorBatchHelpers::LaneWidth)
+	{
+		const VectorRegister4Double FullDisplacementScale = VectorLoad(FullStep.DisplacementScale.GetData() + Base);
+		const VectorRegister4Double FullVelocityToDisplacement = VectorLoad(FullStep.VelocityToDisplacement.GetData() + Base);
+		const VectorRegister4Double FullDisplacementToVelocity = VectorLoad(FullStep.DisplacementToVelocity.GetData() + Base);
+		const VectorRegister4Double FullVelocityScale = VectorLoad(FullStep.VelocityScale.GetData() + Base);
+
+		// components are independent, step each through the whole schedule while it sits in registers
+		for (int32 Component = 0; Component < 3; ++Component)
+		{
+			FVector::FReal* PosData = Pos.Components[Component].GetData() + Base;
+			FVector::FReal* VelData = Velocity.Components[Component].GetData() + Base;
+			FVector::FReal* LastEquilibriumData = LastEquilibrium.Components[Component].GetData() + Base;
+			FVector::FReal* PosAfterData = PosAfterLastFullStep.Components[Component].GetData() + Base;
+			FVector::FReal* VelAfterData = VelAfterLastFullStep.Components[Component].GetData() + Base;
+			const FVector::FReal* GoalData = Goal.Components[Component].GetData() + Base;
+
+			VectorRegister4Double P = VectorLoad(bRewind ? PosAfterData : PosData);
+			VectorRegister4Double V = VectorLoad(bRewind ? VelAfterData : VelData);
+
+			// move the goal linearly toward goal while we substep
+			const VectorRegister4Double LastEq = VectorLoad(LastEquilibriumData);
+			const VectorRegister4Double GoalReg = VectorLoad(GoalData);
+			const VectorRegister4Double EquilibriumStepRate = VectorMultiply(VectorSubtract(GoalReg, LastEq), InvRemainingTimeReg);
+			const VectorRegister4Double FullStepGoalDelta = VectorMultiply(EquilibriumStepRate, FullStepTimeReg);
+			VectorRegister4Double LerpedEq = LastEq;
+
+			for (int32 Step = 0; Step < NumFullSteps; ++Step)
+			{
+				LerpedEq = VectorAdd(LerpedEq, FullStepGoalDelta);
+
+				const VectorRegister4Double Displacement = VectorSubtract(P, LerpedEq);
+				const VectorRegister4Double NewDisplacement = VectorMultiplyAdd(Displacement, FullDisplacementScale, VectorMultiply(V, FullVelocityToDisplacement));
+				V = VectorMultiplyAdd(NewDisplacement, FullDisplacementToVelocity, VectorMultiply(V, FullVelocityScale));
+				P = VectorAdd(NewDisplacement, LerpedEq);
+			}
+
+			if (PartialStepTime > 0.f)
+			{
+				// last partial step, cache where we were after last full step
+				// so we can resume from there on the next eval
+				VectorStore(P, PosAfterData);
+				VectorStore(V, VelAfterData);
+
+				LerpedEq = VectorAdd(LerpedEq, VectorMultiply(EquilibriumStepRate, PartialStepTimeReg));
+
+				const VectorRegister4Double Displacement = VectorSubtract(P, LerpedEq);
+				const VectorRegister4Double NewDisplacement = VectorMultiplyAdd(Displacement, VectorLoad(PartialStep.DisplacementScale.GetData() + Base), VectorMultiply(V, VectorLoad(PartialStep.VelocityToDisplacement.GetData() + Base)));
+				V = VectorMultiplyAdd(NewDisplacement, VectorLoad(PartialStep.DisplacementToVelocity.GetData() + Base), VectorMultiply(V, VectorLoad(PartialStep.VelocityScale.GetData() + Base)));
+				P = VectorAdd(NewDisplacement, LerpedEq);
+			}
+
+			VectorStore(P, PosData);
+			VectorStore(V, VelData);
+
+			if (bStepped)
+			{
+				VectorStore(GoalReg, LastEquilibriumData);
+			}
+		}
+	}
+
+	// springs with a pending reset snap to their goal, at rest
+	for (int32 Index = 0; Index < NumSprings; ++Index)
+	{
+		if (PendingResets[Index])
+		{
+			const FVector GoalValue = Goal.Get(Index);
+			Pos.Set(Index, GoalValue);
+			Velocity.Set(Index, FVector::ZeroVector);
+			LastEquilibrium.Set(Index, GoalValue);
+			PosAfterLastFullStep.Set(Index, GoalValue);
+			VelAfterLastFullStep.Set(Index, FVector::ZeroVector);
+			PendingResets[Index] = false;
+		}
+	}
+}
+
+int32 FIIRInterpolatorBatch::Add(float InterpSpeed)
+{
+	int32 Index = INDEX_NONE;
+
+	if (FreeIndices.Num())
+	{
+		Index = FreeIndices.Pop(false);
+	}
+	else
+	{
+		Index = NumInterpolators++;
+
+		// grow every lane array to the next full vector register
+		const int32 NumLanes = Align(NumInterpolators, InterpolatorBatchHelpers::LaneWidth);
+
+		if (NumLanes > InterpSpeeds.Num())
+		{
+			Value.SetNum(NumLanes);
+			Goal.SetNum(NumLanes);
+			LastGoal.SetNum(NumLanes);
+			ValueAfterLastFullStep.SetNum(NumLanes);
+			InterpSpeeds.SetNumZeroed(NumLanes);
+			PendingResets.SetNumZeroed(NumLanes);
+			FullStepAlphas.SetNumZeroed(NumLanes);
+			PartialStepAlphas.SetNumZeroed(NumLanes);
+		}
+	}
+
+	SetInterpSpeed(Index, InterpSpeed);
+	PendingResets[Index] = true;
+
+	return Index;
+}
+
+void FIIRInterpolatorBatch::Remove(int32 Index)
+{
+	if (Index >= 0 && Index < NumInterpolators && FreeIndices.Contains(Index) == false)
+	{
+		// leave the lane at rest, it keeps being stepped until reused
+		Value.Set(Index, FVector::ZeroVector);
+		Goal.Set(Index, FVector::ZeroVector);
+		LastGoal.Set(Index, FVector::ZeroVector);
+		ValueAfterLastFullStep.Set(Index, FVector::ZeroVector);
+		PendingResets[Index] = false;
+
+		FreeIndices.Add(Index);
+	}
+}
+
+void FIIRInterpolatorBatch::SetGoal(int32 Index, const FVector& NewGoalValue)
+{
+	Goal.Set(Index, NewGoalValue);
+}
+
+void FIIRInterpolatorBatch::SetInterpSpeed(int32 Index, float NewInterpSpeed)
+{
+	InterpSpeeds[Index] = NewInterpSpeed;
+	FullStepAlphas[Index] = InterpolatorBatchHelpers::ComputeIIRAlpha(NewInterpSpeed, MaxSubstepTime);
+}
+
+void FIIRInterpolatorBatch::Reset(int32 Index)
+{
+	PendingResets[Index] = true;
+}
+
+void FIIRInterpolatorBatch::SetInitialValue(int32 Index, const FVector& InitialValue)
+{
+	Value.Set(Index, InitialValue);
+	ValueAfterLastFullStep.Set(Index, InitialValue);
+	PendingResets[Index] = false;
+}
+
+FVector FIIRInterpolatorBatch::GetCurrentValue(int32 Index) const
+{
+	return Value.Get(Index);
+}
+
+void FIIRInterpolatorBatch::EvalSubstepped(float DeltaTime)
+{
+	if (NumInterpolators == 0)
+	{
+		return;
+	}
+
+	// like the scalar reset, a batch that is only resetting snaps without carrying any leftover time
+	if (Algo::Count(PendingResets, true) == Num())
+	{
+		LastUpdateLeftoverTime = 0.f;
+		DeltaTime = 0.f;
+	}
+
+	float RemainingTime = DeltaTime;
+
+	// handle leftover rewind, every interpolator rewinds to its value at the end of the last full MaxSubstepTime update
+	const bool bRewind = (LastUpdateLeftoverTime > 0.f);
+	if (bRewind)
+	{
+		RemainingTime += LastUpdateLeftoverTime;
+		LastUpdateLeftoverTime = 0.f;
+	}
+
+	int32 NumFullSteps = 0;
+	float PartialStepTime = 0.f;
+	InterpolatorBatchHelpers::ComputeSubstepSchedule(RemainingTime, MaxSubstepTime, NumFullSteps, PartialStepTime);
+
+	LastUpdateLeftoverTime = PartialStepTime;
+
+	const int32 NumLanes = Align(NumInterpolators, InterpolatorBatchHelpers::LaneWidth);
+
+	if (PartialStepTime > 0.f)
+	{
+		for (int32 Index = 0; Index < NumLanes; ++Index)
+		{
+			PartialStepAlphas[Index] = InterpolatorBatchHelpers::ComputeIIRAlpha(InterpSpeeds[Index], PartialStepTime);
+		}
+	}
+
+	const bool bStepped = (NumFullSteps > 0) || (PartialStepTime > 0.f);
+	const FVector::FReal InvRemainingTime = 1.f / RemainingTime;
+	const VectorRegister4Double InvRemainingTimeReg = MakeVectorRegisterDouble(InvRemainingTime, InvRemainingTime, InvRemainingTime, InvRemainingTime);
+	const VectorRegister4Double FullStepTimeReg = MakeVectorRegisterDouble(MaxSubstepTime, MaxSubstepTime, MaxSubstepTime, MaxSubstepTime);
+	const VectorRegister4Double PartialStepTimeReg = MakeVectorRegisterDouble(PartialStepTime, PartialStepTime, PartialStepTime, PartialStepTime);
+	const VectorRegister4Double SnapDistanceSquaredReg = MakeVectorRegisterDouble(KINDA_SMALL_NUMBER, KINDA_SMALL_NUMBER, KINDA_SMALL_NUMBER, KINDA_SMALL_NUMBER);
+
+	// one VInterpTo step on all three components, the snap to a goal within KINDA_SMALL_NUMBER needs the whole vector
+	auto Step = [&SnapDistanceSquaredReg](VectorRegister4Double* V, const VectorRegister4Double* StepGoal, const VectorRegister4Double& Alpha)
+	{
+		VectorRegister4Double Dist[3];
+		for (int32 Component = 0; Component < 3; ++Component)
+		{
+			Dist[Component] = VectorSubtract(StepGoal[Component], V[Component]);
+		}
+
+		const VectorRegister4Double DistSquared = VectorMultiplyAdd(Dist[2], Dist[2], VectorMultiplyAdd(Dist[1], Dist[1], VectorMultiply(Dist[0], Dist[0])));
+		const VectorRegister4Double SnapMask = VectorCompareLT(DistSquared, SnapDistanceSquaredReg);
+
+		for (int32 Component = 0; Component < 3; ++Component)
+		{
+			V[Component] = VectorSelect(SnapMask, StepGoal[Component], VectorMultiplyAdd(Dist[Component], Alpha, V[Component]));
+		}
+	};
+
+	for (int32 Base = 0; Base < NumLanes; Base += InterpolatorBatchHelpers::LaneWidth)
+	{
+		const VectorRegister4Double FullAlpha = VectorLoad(FullStepAlphas.GetData() + Base);
+
+		VectorRegister4Double V[3];
+		VectorRegister4Double LerpedGoal[3];
+		VectorRegister4Double GoalStepRate[3];
+		VectorRegister4Double FullStepGoalDelta[3];
+		VectorRegister4Double GoalReg[3];
+
+		for (int32 Component = 0; Component < 3; ++Component)
+		{
+			V[Component] = VectorLoad((bRewind ? ValueAfterLastFullStep : Value).Components[Component].GetData() + Base);
+
+			// move the goal linearly toward goal while we substep
+			LerpedGoal[Component] = VectorLoad(LastGoal.Components[Component].GetData() + Base);
+			GoalReg[Component] = VectorLoad(Goal.Components[Component].GetData() + Base);
+			GoalStepRate[Component] = VectorMultiply(VectorSubtract(GoalReg[Component], LerpedGoal[Component]), InvRemainingTimeReg);
+			FullStepGoalDelta[Component] = VectorMultiply(GoalStepRate[Component], FullStepTimeReg);
+		}
+
+		for (int32 FullStepIndex = 0; FullStepIndex < NumFullSteps; ++FullStepIndex)
+		{
+			for (int32 Component = 0; Component < 3; ++Component)
+			{
+				LerpedGoal[Component] = VectorAdd(LerpedGoal[Component], FullStepGoalDelta[Component]);
+			}
+
+			Step(V, LerpedGoal, FullAlpha);
+		}
+
+		if (PartialStepTime > 0.f)
+		{
+			for (int32 Component = 0; Component < 3; ++Component)
+			{
+				// last partial step, cache where we were after last full step
+				// so we can resume from there on the next eval
+				VectorStore(V[Component], ValueAfterLastFullStep.Components[Component].GetData() + Base);
+				LerpedGoal[Component] = VectorAdd(LerpedGoal[Component], VectorMultiply(GoalStepRate[Component], PartialStepTimeReg));
+			}
+
+			Step(V, LerpedGoal, VectorLoad(PartialStepAlphas.GetData() + Base));
+		}
+
+		for (int32 Component = 0; Component < 3; ++Component)
+		{
+			VectorStore(V[Component], Value.Components[Component].GetData() + Base);
+
+			if (bStepped)
+			{
+				VectorStore(GoalReg[Component], LastGoal.Components[Component].GetData() + Base);
+			}
+		}
+	}
+
+	// interpolators with a pending reset snap to their goal
+	for (int32 Index = 0; Index < NumInterpolators; ++Index)
+	{
+		if (PendingResets[Index])
+		{
+			const FVector GoalValue = Goal.Get(Index);
+			Value.Set(Index, GoalValue);
+			LastGoal.Set(Index, GoalValue);
+			ValueAfterLastFullStep.Set(Index, GoalValue);
+			PendingResets[Index] = false;
+		}
+	}
+}
 
 bool FInterpolatorTests::RunSubstepTest_CDSpringVector()
 {
@@ -59,4 +555,319 @@ bool FInterpolatorTests::RunSubstepTest_CDSpringVector()
 
 	UE_LOG(LogTemp, Log, TEXT("... TEST FAILED!"));
 	return false;
-}
\ No newline at end of file
+}
+
+bool FInterpolatorTests::RunClosedFormTest_CDSpringVector()
+{
+	static const float NaturalFrequencies[] = { 1.f, 5.f, 10.f, 20.f, 40.f };
+	static const float HitchTimes[] = { 0.05f, 0.1f, 0.25f, 0.4f, 1.f };
+	static const float GoalSpeeds[] = { 0.f, 1.f, 100.f, 1000.f };
+	static const float SteadyDeltaTime = 1.f / 60.f;
+	static const int NumSteadyUpdates = 10;
+
+	bool bPassed = true;
+
+	for (const float NaturalFrequency : NaturalFrequencies)
+	{
+		for (const float HitchTime : HitchTimes)
+		{
+			for (const float GoalSpeed : GoalSpeeds)
+			{
+				TCritDampSpringInterpolator<FVector> ClosedForm(NaturalFrequency);
+				TCritDampSpringInterpolator<FVector> Iterated(NaturalFrequency);
+				Iterated.bUseClosedFormSubsteps = false;
+
+				// get them started at 0,0,0
+				ClosedForm.Reset();
+				Iterated.Reset();
+				ClosedForm.EvalSubstepped(FVector::ZeroVector, 0.001f);
+				Iterated.EvalSubstepped(FVector::ZeroVector, 0.001f);
+
+				// a few steady frames chasing a moving goal, then the hitch, then steady frames again
+				const FVector GoalVelocity = FVector(1.f, 0.5f, -0.25f) * GoalSpeed;
+				FVector Goal(10.f, 0.f, 0.f);
+				float MaxError = 0.f;
+
+				for (int i = 0; i < NumSteadyUpdates * 2 + 1; ++i)
+				{
+					const float dt = (i == NumSteadyUpdates) ? HitchTime : SteadyDeltaTime;
+					Goal += GoalVelocity * dt;
+
+					const FVector ClosedFormPos = ClosedForm.EvalSubstepped(Goal, dt);
+					const FVector IteratedPos = Iterated.EvalSubstepped(Goal, dt);
+					MaxError = FMath::Max(MaxError, static_cast<float>((ClosedFormPos - IteratedPos).Size()));
+				}
+
+				// tolerance scales with how far the goal travelled
+				const float Tolerance = 0.001f * (1.f + Goal.Size());
+				if (MaxError > Tolerance)
+				{
+					UE_LOG(LogTemp, Log, TEXT("NaturalFrequency = %f, HitchTime = %f, GoalSpeed = %f, closed form off by %f (tolerance %f)"), NaturalFrequency, HitchTime, GoalSpeed, MaxError, Tolerance);
+					bPassed = false;
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%s"), bPassed ? TEXT("... TEST PASSED!") : TEXT("... TEST FAILED!"));
+	return bPassed;
+}
+
+bool FInterpolatorTests::RunClosedFormTest_IIRVector()
+{
+	static const float InterpSpeeds[] = { 1.f, 6.f, 15.f, 60.f, 200.f };
+	static const float HitchTimes[] = { 0.05f, 0.1f, 0.25f, 0.4f, 1.f };
+	static const float GoalSpeeds[] = { 0.f, 1.f, 100.f, 1000.f };
+	static const float SteadyDeltaTime = 1.f / 60.f;
+	static const int NumSteadyUpdates = 10;
+
+	bool bPassed = true;
+
+	for (const float InterpSpeed : InterpSpeeds)
+	{
+		for (const float HitchTime : HitchTimes)
+		{
+			for (const float GoalSpeed : GoalSpeeds)
+			{
+				TGenericIIRInterpolator<FVector> ClosedForm(InterpSpeed);
+				TGenericIIRInterpolator<FVector> Iterated(InterpSpeed);
+				Iterated.SetUseClosedFormSubsteps(false);
+
+				ClosedForm.EvalSubstepped(FVector::ZeroVector, 0.001f);
+				Iterated.EvalSubstepped(FVector::ZeroVector, 0.001f);
+
+				const FVector GoalVelocity = FVector(1.f, 0.5f, -0.25f) * GoalSpeed;
+				FVector Goal(10.f, 0.f, 0.f);
+				float MaxError = 0.f;
+
+				for (int i = 0; i < NumSteadyUpdates * 2 + 1; ++i)
+				{
+					const float dt = (i == NumSteadyUpdates) ? HitchTime : SteadyDeltaTime;
+					Goal += GoalVelocity * dt;
+
+					const FVector ClosedFormPos = ClosedForm.EvalSubstepped(Goal, dt);
+					const FVector IteratedPos = Iterated.EvalSubstepped(Goal, dt);
+					MaxError = FMath::Max(MaxError, static_cast<float>((ClosedFormPos - IteratedPos).Size()));
+				}
+
+				// the iterated path snaps onto goals closer than KINDA_SMALL_NUMBER, the closed form does not
+				const float Tolerance = 0.001f * (1.f + Goal.Size()) + 0.01f;
+				if (MaxError > Tolerance)
+				{
+					UE_LOG(LogTemp, Log, TEXT("InterpSpeed = %f, HitchTime = %f, GoalSpeed = %f, closed form off by %f (tolerance %f)"), InterpSpeed, HitchTime, GoalSpeed, MaxError, Tolerance);
+					bPassed = false;
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%s"), bPassed ? TEXT("... TEST PASSED!") : TEXT("... TEST FAILED!"));
+	return bPassed;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterpolatorSubstepTest, "AncientGame.Camera.Interpolators.Substep", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FInterpolatorSubstepTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Hitched spring catches up with the unhitched one"), FInterpolatorTests::RunSubstepTest_CDSpringVector());
+	TestTrue(TEXT("Closed form spring hitches match iterated substeps"), FInterpolatorTests::RunClosedFormTest_CDSpringVector());
+	TestTrue(TEXT("Closed form IIR hitches match iterated substeps"), FInterpolatorTests::RunClosedFormTest_IIRVector());
+	TestTrue(TEXT("Batched springs match scalar springs"), FInterpolatorTests::RunBatchBenchmark_CDSpringVector(61, 300));
+	TestTrue(TEXT("Batched IIR interpolators match scalar IIR interpolators"), FInterpolatorTests::RunBatchBenchmark_IIRVector(61, 300));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+bool FInterpolatorTests::RunBatchBenchmark_CDSpringVector(int32 NumSprings, int32 NumFrames)
+{
+	NumSprings = FMath::Max(NumSprings, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+
+	FRandomStream RandomStream(1234);
+
+	TArray<float> NaturalFrequencies;
+	TArray<FVector> GoalOffsets;
+	TArray<float> DeltaTimes;
+
+	for (int32 Index = 0; Index < NumSprings; ++Index)
+	{
+		NaturalFrequencies.Add(RandomStream.FRandRange(5.f, 30.f));
+		GoalOffsets.Add(RandomStream.GetUnitVector() * RandomStream.FRandRange(100.f, 1000.f));
+	}
+
+	// mostly steady frames with the odd hitch, so the partial-step rewind gets exercised
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		DeltaTimes.Add(RandomStream.FRand() < 0.05f ? RandomStream.FRandRange(0.05f, 0.2f) : RandomStream.FRandRange(1.f / 70.f, 1.f / 50.f));
+	}
+
+	auto GetGoal = [&GoalOffsets](int32 Index, float Time)
+	{
+		return GoalOffsets[Index] * FMath::Sin(Time * (1.f + (Index % 7)));
+	};
+
+	// scalar path
+	TArray<TCritDampSpringInterpolator<FVector>> Springs;
+	for (int32 Index = 0; Index < NumSprings; ++Index)
+	{
+		TCritDampSpringInterpolator<FVector>& Spring = Springs.Emplace_GetRef(NaturalFrequencies[Index]);
+		Spring.Reset();
+
+		// the batch iterates every substep, so hitches must not take the closed form here
+		Spring.SetUseClosedFormSubsteps(false);
+	}
+
+	float Time = 0.f;
+	const double ScalarStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Time += DeltaTimes[Frame];
+		for (int32 Index = 0; Index < NumSprings; ++Index)
+		{
+			Springs[Index].EvalSubstepped(GetGoal(Index, Time), DeltaTimes[Frame]);
+		}
+	}
+	const double ScalarTime = FPlatformTime::Seconds() - ScalarStartTime;
+
+	// batch path
+	FCritDampSpringInterpolatorBatch Batch;
+	for (int32 Index = 0; Index < NumSprings; ++Index)
+	{
+		Batch.Add(NaturalFrequencies[Index]);
+	}
+
+	Time = 0.f;
+	const double BatchStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Time += DeltaTimes[Frame];
+		for (int32 Index = 0; Index < NumSprings; ++Index)
+		{
+			Batch.SetGoal(Index, GetGoal(Index, Time));
+		}
+		Batch.EvalSubstepped(DeltaTimes[Frame]);
+	}
+	const double BatchTime = FPlatformTime::Seconds() - BatchStartTime;
+
+	FVector::FReal MaxError = 0.f;
+	for (int32 Index = 0; Index < NumSprings; ++Index)
+	{
+		MaxError = FMath::Max(MaxError, FVector::Dist(Springs[Index].GetCurrentValue(), Batch.GetCurrentValue(Index)));
+	}
+
+	UE_LOG(LogAncientGame, Log, TEXT("CD spring batch benchmark, %d springs over %d frames: scalar %.3f ms, batch %.3f ms (%.2fx), max difference %f"),
+		NumSprings, NumFrames, ScalarTime * 1000.0, BatchTime * 1000.0, BatchTime > 0.0 ? ScalarTime / BatchTime : 0.0, MaxError);
+
+	if (MaxError < 0.01f)
+	{
+		UE_LOG(LogAncientGame, Log, TEXT("... TEST PASSED!"));
+		return true;
+	}
+
+	UE_LOG(LogAncientGame, Log, TEXT("... TEST FAILED!"));
+	return false;
+}
+
+bool FInterpolatorTests::RunBatchBenchmark_IIRVector(int32 NumInterpolators, int32 NumFrames)
+{
+	NumInterpolators = FMath::Max(NumInterpolators, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+
+	FRandomStream RandomStream(1234);
+
+	TArray<float> InterpSpeeds;
+	TArray<FVector> GoalOffsets;
+	TArray<float> DeltaTimes;
+
+	for (int32 Index = 0; Index < NumInterpolators; ++Index)
+	{
+		InterpSpeeds.Add(RandomStream.FRandRange(2.f, 20.f));
+		GoalOffsets.Add(RandomStream.GetUnitVector() * RandomStream.FRandRange(100.f, 1000.f));
+	}
+
+	// mostly steady frames with the odd hitch, so the partial-step rewind gets exercised
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		DeltaTimes.Add(RandomStream.FRand() < 0.05f ? RandomStream.FRandRange(0.05f, 0.2f) : RandomStream.FRandRange(1.f / 70.f, 1.f / 50.f));
+	}
+
+	auto GetGoal = [&GoalOffsets](int32 Index, float Time)
+	{
+		return GoalOffsets[Index] * FMath::Sin(Time * (1.f + (Index % 7)));
+	};
+
+	// scalar path
+	TArray<TGenericIIRInterpolator<FVector>> Interpolators;
+	for (int32 Index = 0; Index < NumInterpolators; ++Index)
+	{
+		TGenericIIRInterpolator<FVector>& Interpolator = Interpolators.Emplace_GetRef(InterpSpeeds[Index]);
+		Interpolator.Reset();
+
+		// the batch iterates every substep, so hitches must not take the closed form here
+		Interpolator.SetUseClosedFormSubsteps(false);
+	}
+
+	float Time = 0.f;
+	const double ScalarStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Time += DeltaTimes[Frame];
+		for (int32 Index = 0; Index < NumInterpolators; ++Index)
+		{
+			Interpolators[Index].EvalSubstepped(GetGoal(Index, Time), DeltaTimes[Frame]);
+		}
+	}
+	const double ScalarTime = FPlatformTime::Seconds() - ScalarStartTime;
+
+	// batch path
+	FIIRInterpolatorBatch Batch;
+	for (int32 Index = 0; Index < NumInterpolators; ++Index)
+	{
+		Batch.Add(InterpSpeeds[Index]);
+	}
+
+	Time = 0.f;
+	const double BatchStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Time += DeltaTimes[Frame];
+		for (int32 Index = 0; Index < NumInterpolators; ++Index)
+		{
+			Batch.SetGoal(Index, GetGoal(Index, Time));
+		}
+		Batch.EvalSubstepped(DeltaTimes[Frame]);
+	}
+	const double BatchTime = FPlatformTime::Seconds() - BatchStartTime;
+
+	FVector::FReal MaxError = 0.f;
+	for (int32 Index = 0; Index < NumInterpolators; ++Index)
+	{
+		MaxError = FMath::Max(MaxError, FVector::Dist(Interpolators[Index].GetCurrentValue(), Batch.GetCurrentValue(Index)));
+	}
+
+	UE_LOG(LogAncientGame, Log, TEXT("IIR batch benchmark, %d interpolators over %d frames: scalar %.3f ms, batch %.3f ms (%.2fx), max difference %f"),
+		NumInterpolators, NumFrames, ScalarTime * 1000.0, BatchTime * 1000.0, BatchTime > 0.0 ? ScalarTime / BatchTime : 0.0, MaxError);
+
+	if (MaxError < 0.01f)
+	{
+		UE_LOG(LogAncientGame, Log, TEXT("... TEST PASSED!"));
+		return true;
+	}
+
+	UE_LOG(LogAncientGame, Log, TEXT("... TEST FAILED!"));
+	return false;
+}
+
+static FAutoConsoleCommand InterpolatorBatchBenchmarkCommand(
+	TEXT("AncientGame.Interpolators.BatchBenchmark"),
+	TEXT("Compare scalar and batched critically damped spring and IIR interpolators. Usage: AncientGame.Interpolators.BatchBenchmark [NumInterpolators] [NumFrames]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 NumInterpolators = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 256;
+		const int32 NumFrames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 600;
+		FInterpolatorTests::RunBatchBenchmark_CDSpringVector(NumInterpolators, NumFrames);
+		FInterpolatorTests::RunBatchBenchmark_IIRVector(NumInterpolators, NumFrames);
+	}));
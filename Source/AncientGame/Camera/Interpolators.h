@@ -15,6 +15,32 @@ namespace InterpolatorHelpers
 
 	template<class T> T NormalizeIfRotator(T Input) { return Input; }
 	template<> inline FRotator NormalizeIfRotator(FRotator Input) { return Input.GetNormalized(); };
+
+	/** True for types whose IIR step is a plain linear blend, so runs of steps have a closed form. */
+	template<class T> bool HasLinearInterpTo() { return false; }
+	template<> inline bool HasLinearInterpTo<float>() { return true; };
+	template<> inline bool HasLinearInterpTo<FVector>() { return true; };
+	template<> inline bool HasLinearInterpTo<FRotator>() { return true; };
+
+	/**
+	 * Full substeps in a timeslice, OutRemainingTime is what is left for the partial step.
+	 * Counted the same way the substep loops subtract, so float rounding splits the timeslice identically.
+	 */
+	inline int32 CountFullSubsteps(float RemainingTime, float MaxSubstepTime, float& OutRemainingTime)
+	{
+		int32 NumFullSubsteps = 0;
+		while ((RemainingTime > KINDA_SMALL_NUMBER) && (RemainingTime >= MaxSubstepTime))
+		{
+			RemainingTime -= MaxSubstepTime;
+			++NumFullSubsteps;
+		}
+
+		OutRemainingTime = RemainingTime;
+		return NumFullSubsteps;
+	}
+
+	/** Full substeps beyond which hitch frames are evaluated in closed form instead of iterated. */
+	static constexpr int32 MaxIteratedSubsteps = 4;
 }
 
 /** 
@@ -76,6 +102,16 @@ public:
 			const T EquilibriumStepRate = InterpolatorHelpers::NormalizeIfRotator<T>(NewGoalValue - LastGoalValue) * (1.f / RemainingTime);
 			T LerpedGoalValue = LastGoalValue;
 
+			// hitches take their full substeps in one closed form eval instead of iterating them
+			float PartialStepTime = 0.f;
+			const int32 NumFullSubsteps = InterpolatorHelpers::CountFullSubsteps(RemainingTime, MaxSubstepTime, PartialStepTime);
+			if (bUseClosedFormSubsteps && (NumFullSubsteps > InterpolatorHelpers::MaxIteratedSubsteps) && (InterpSpeed > 0.f) && InterpolatorHelpers::HasLinearInterpTo<T>())
+			{
+				LerpedGoalValue = ClosedFormFullSubsteps(LerpedGoalValue, EquilibriumStepRate, NumFullSubsteps);
+				RemainingTime = PartialStepTime;
+				LastGoalValue = NewGoalValue;
+			}
+
 			while (RemainingTime > KINDA_SMALL_NUMBER)
 			{
 				const float StepTime = FMath::Min(MaxSubstepTime, RemainingTime);
@@ -130,6 +166,12 @@ public:
 		bPendingReset = true; 
 	}
 
+	/** If false, EvalSubstepped always iterates every substep. */
+	void SetUseClosedFormSubsteps(bool bUseClosedForm)
+	{
+		bUseClosedFormSubsteps = bUseClosedForm;
+	}
+
 protected:
 	/** Maximum timeslice per substep. */
 	static constexpr float MaxSubstepTime = 1.f / 120.f;
@@ -147,6 +189,7 @@ protected:
 	bool bPendingReset = true;
 
 	bool bDoLeftoverRewind = true;
+	bool bUseClosedFormSubsteps = true;
 	float LastUpdateLeftoverTime = 0.f;
 	T ValueAfterLastFullStep;
 	T LastGoalValue;
@@ -159,6 +202,29 @@ protected:
 		return T();
 	}
 
+	/**
+	 * Takes NumSteps full substeps towards a goal moving linearly from StartGoalValue, returns where the goal ends up.
+	 * Each step keeps (1 - Alpha) of the lag behind the goal, so the lag settles geometrically on a steady
+	 * -(1 - Alpha) / Alpha goal steps:
+	 * lag(n) = (1 - Alpha)^n * (lag(0) - steady) + steady
+	 * Matches iterating SingleStepEval, apart from the snap to a goal within KINDA_SMALL_NUMBER.
+	 */
+	T ClosedFormFullSubsteps(T StartGoalValue, T GoalStepRate, int32 NumSteps)
+	{
+		const float Alpha = FMath::Clamp(MaxSubstepTime * InterpSpeed, 0.f, 1.f);
+		const float Retain = 1.f - Alpha;
+		const float RetainAfterSteps = static_cast<float>(FMath::Pow(static_cast<double>(Retain), NumSteps));
+
+		const T GoalStep = GoalStepRate * MaxSubstepTime;
+		const T SteadyLag = GoalStep * (-Retain / Alpha);
+		const T Lag = InterpolatorHelpers::NormalizeIfRotator<T>(CurrentValue - StartGoalValue);
+		const T EndGoalValue = StartGoalValue + GoalStep * static_cast<float>(NumSteps);
+
+		CurrentValue = InterpolatorHelpers::NormalizeIfRotator<T>((Lag - SteadyLag) * RetainAfterSteps + SteadyLag + EndGoalValue);
+
+		return EndGoalValue;
+	}
+
 	void PerformReset(T NewGoalValue)
 	{
 		CurrentValue = NewGoalValue;
@@ -960,6 +1026,16 @@ public:
 			// NaturalFrequency could theoretically be changed at runtime
 			CacheScalars(NaturalFrequency, MaxSubstepTime);
 
+			// hitches take their full substeps in one closed form eval instead of iterating them
+			float PartialStepTime = 0.f;
+			const int32 NumFullSubsteps = InterpolatorHelpers::CountFullSubsteps(RemainingTime, MaxSubstepTime, PartialStepTime);
+			if (bUseClosedFormSubsteps && (NumFullSubsteps > InterpolatorHelpers::MaxIteratedSubsteps)
+				&& ClosedFormFullSubsteps(LerpedEquilibriumPos, EquilibriumStepRate, NumFullSubsteps))
+			{
+				RemainingTime = PartialStepTime;
+				LastEquilibrium = NewEquilibriumPos;
+			}
+
 			while (RemainingTime > KINDA_SMALL_NUMBER)
 			{
 				const float StepTime = FMath::Min(MaxSubstepTime, RemainingTime);
@@ -1052,6 +1128,92 @@ protected:
 		bPendingReset = false;
 	}
 
+	/** 2x2 matrix taking (lag behind the equilibrium, velocity) through substeps. */
+	struct FCDSpringStepMatrix
+	{
+		double M11 = 1.0;
+		double M12 = 0.0;
+		double M21 = 0.0;
+		double M22 = 1.0;
+
+		FCDSpringStepMatrix operator*(const FCDSpringStepMatrix& Other) const
+		{
+			FCDSpringStepMatrix Out;
+			Out.M11 = M11 * Other.M11 + M12 * Other.M21;
+			Out.M12 = M11 * Other.M12 + M12 * Other.M22;
+			Out.M21 = M21 * Other.M11 + M22 * Other.M21;
+			Out.M22 = M21 * Other.M12 + M22 * Other.M22;
+			return Out;
+		}
+
+		FCDSpringStepMatrix Pow(int32 Exponent) const
+		{
+			// square and multiply, log2(Exponent) products
+			FCDSpringStepMatrix Out;
+			FCDSpringStepMatrix Base = *this;
+			while (Exponent > 0)
+			{
+				if (Exponent & 1)
+				{
+					Out = Out * Base;
+				}
+				Base = Base * Base;
+				Exponent >>= 1;
+			}
+			return Out;
+		}
+	};
+
+	/**
+	 * Takes NumSteps full substeps towards an equilibrium moving linearly from InOutEquilibriumPos, in closed form.
+	 * With the equilibrium held at the end of each substep, as the iterated loop does, one substep is an affine map
+	 * of (lag, velocity):
+	 * lag' = A * (lag - step) + B * vel
+	 * vel' = C * lag' + D * vel
+	 * where step is how far the equilibrium moves per substep and A, B, C, D are SingleStepEval's coefficients.
+	 * Its fixed point is the steady lag and velocity of a spring chasing the moving equilibrium, so n substeps are
+	 * (lag, vel)(n) = M^n * ((lag, vel)(0) - steady) + steady
+	 * Returns false, leaving the state untouched, if the map has no fixed point (a spring with no stiffness).
+	 */
+	bool ClosedFormFullSubsteps(T& InOutEquilibriumPos, T EquilibriumStepRate, int32 NumSteps)
+	{
+		const FCDSpringScalars Scalars = GetScalars(NaturalFrequency, MaxSubstepTime);
+		const double A = Scalars.ExDTxW + Scalars.E;
+		const double B = Scalars.ExDT;
+		const double C = -Scalars.ExDTxW * NaturalFrequency;
+		const double D = Scalars.E - Scalars.ExDTxW;
+
+		const double Determinant = (1.0 - A) * (1.0 - B * C - D) - A * B * C;
+		if (FMath::Abs(Determinant) < SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		FCDSpringStepMatrix StepMatrix;
+		StepMatrix.M11 = A;
+		StepMatrix.M12 = B;
+		StepMatrix.M21 = A * C;
+		StepMatrix.M22 = B * C + D;
+		const FCDSpringStepMatrix Steps = StepMatrix.Pow(NumSteps);
+
+		// steady state, in units of the per-substep equilibrium step
+		const T EquilibriumStep = EquilibriumStepRate * MaxSubstepTime;
+		const T SteadyLag = EquilibriumStep * static_cast<float>(-A * (1.0 - D) / Determinant);
+		const T SteadyVel = EquilibriumStep * static_cast<float>(-A * C / Determinant);
+
+		const T LagOffset = InterpolatorHelpers::NormalizeIfRotator<T>(CurrentPos - InOutEquilibriumPos) - SteadyLag;
+		const T VelOffset = CurrentVelocity - SteadyVel;
+
+		const T NewLag = LagOffset * static_cast<float>(Steps.M11) + VelOffset * static_cast<float>(Steps.M12) + SteadyLag;
+		const T NewVel = LagOffset * static_cast<float>(Steps.M21) + VelOffset * static_cast<float>(Steps.M22) + SteadyVel;
+
+		InOutEquilibriumPos += EquilibriumStep * static_cast<float>(NumSteps);
+		CurrentPos = InterpolatorHelpers::NormalizeIfRotator<T>(NewLag + InOutEquilibriumPos);
+		CurrentVelocity = NewVel;
+
+		return true;
+	}
+
 public:
 	T CurrentPos;
 	T CurrentVelocity;
@@ -1061,6 +1223,10 @@ public:
 
 	bool bPendingReset = false;
 	bool bDoLeftoverRewind = true;
+
+	/** If false, EvalSubstepped always iterates every substep. */
+	bool bUseClosedFormSubsteps = true;
+
 	float LastUpdateLeftoverTime = 0.f;
 	T PosAfterLastFullStep;
 	T VelAfterLastFullStep;
@@ -1170,8 +1336,152 @@ private:
 };
 
 
+/** Vector state of a batch of interpolators, one lane per interpolator, padded to a multiple of the vector width. */
+struct FInterpolatorBatchLanes
+{
+	/** X, Y and Z of every interpolator. */
+	TArray<FVector::FReal> Components[3];
+
+	void SetNum(int32 NewNum);
+	void Set(int32 Index, const FVector& Value);
+	FVector Get(int32 Index) const;
+};
+
+/**
+ * Struct-of-arrays container stepping many critically damped spring vector interpolators at once.
+ * Every spring in the batch shares the delta time, so the substep schedule (and the partial-step rewind)
+ * is worked out once per eval and the springs are stepped four at a time with vector registers.
+ * Results match TCritDampSpringInterpolator<FVector>::EvalSubstepped for springs evaluated every frame.
+ */
+class FCritDampSpringInterpolatorBatch
+{
+public:
+	/** Adds a spring, snapping to its goal on the next eval. Returns its index, stable until it is removed. */
+	int32 Add(float NaturalFrequency = 20.f);
+
+	/** Removes a spring, its index may be reused by the next Add. */
+	void Remove(int32 Index);
+
+	/** Sets the equilibrium the spring is pulled towards on the next eval. */
+	void SetGoal(int32 Index, const FVector& NewEquilibrium);
+
+	void SetNaturalFrequency(int32 Index, float NewNaturalFrequency);
+
+	/** Spring will snap directly to its goal on the next eval. */
+	void Reset(int32 Index);
+
+	void SetInitialValue(int32 Index, const FVector& InitialValue);
+
+	FVector GetCurrentValue(int32 Index) const;
+
+	/** Substeps every spring in the batch towards its goal, with partial-interval rewinding. */
+	void EvalSubstepped(float DeltaTime);
+
+	int32 Num() const { return NumSprings - FreeIndices.Num(); }
+
+	static constexpr float MaxSubstepTime = 1.f / 120.f;
+
+private:
+	/** Per-spring step coefficients, see TCritDampSpringInterpolator::SingleStepEval. */
+	struct FCoefficients
+	{
+		TArray<FVector::FReal> DisplacementScale;
+		TArray<FVector::FReal> VelocityToDisplacement;
+		TArray<FVector::FReal> DisplacementToVelocity;
+		TArray<FVector::FReal> VelocityScale;
+
+		void SetNum(int32 NewNum);
+		void Compute(int32 Index, float NaturalFrequency, float StepTime);
+	};
+
+	FInterpolatorBatchLanes Pos;
+	FInterpolatorBatchLanes Velocity;
+	FInterpolatorBatchLanes Goal;
+	FInterpolatorBatchLanes LastEquilibrium;
+	FInterpolatorBatchLanes PosAfterLastFullStep;
+	FInterpolatorBatchLanes VelAfterLastFullStep;
+
+	TArray<float> NaturalFrequencies;
+	TArray<bool> PendingResets;
+
+	/** Coefficients for a full MaxSubstepTime step, and for this eval's partial step. */
+	FCoefficients FullStep;
+	FCoefficients PartialStep;
+	TArray<bool> FullStepDirty;
+
+	TArray<int32> FreeIndices;
+	int32 NumSprings = 0;
+
+	/** Shared by every spring, they all step on the same schedule. */
+	float LastUpdateLeftoverTime = 0.f;
+};
+
+/**
+ * Struct-of-arrays container stepping many IIR vector interpolators at once, laid out like FCritDampSpringInterpolatorBatch.
+ * Results match TGenericIIRInterpolator<FVector>::EvalSubstepped with closed form substeps off, for interpolators evaluated every frame.
+ */
+class FIIRInterpolatorBatch
+{
+public:
+	/** Adds an interpolator, snapping to its goal on the next eval. Returns its index, stable until it is removed. */
+	int32 Add(float InterpSpeed = 6.f);
+
+	/** Removes an interpolator, its index may be reused by the next Add. */
+	void Remove(int32 Index);
+
+	/** Sets the value the interpolator approaches on the next eval. */
+	void SetGoal(int32 Index, const FVector& NewGoalValue);
+
+	void SetInterpSpeed(int32 Index, float NewInterpSpeed);
+
+	/** Interpolator will snap directly to its goal on the next eval. */
+	void Reset(int32 Index);
+
+	void SetInitialValue(int32 Index, const FVector& InitialValue);
+
+	FVector GetCurrentValue(int32 Index) const;
+
+	/** Substeps every interpolator in the batch towards its goal, with partial-interval rewinding. */
+	void EvalSubstepped(float DeltaTime);
+
+	int32 Num() const { return NumInterpolators - FreeIndices.Num(); }
+
+	static constexpr float MaxSubstepTime = 1.f / 120.f;
+
+private:
+	FInterpolatorBatchLanes Value;
+	FInterpolatorBatchLanes Goal;
+	FInterpolatorBatchLanes LastGoal;
+	FInterpolatorBatchLanes ValueAfterLastFullStep;
+
+	TArray<float> InterpSpeeds;
+	TArray<bool> PendingResets;
+
+	/** Fraction of the distance to the goal covered by a full MaxSubstepTime step, and by this eval's partial step. */
+	TArray<FVector::FReal> FullStepAlphas;
+	TArray<FVector::FReal> PartialStepAlphas;
+
+	TArray<int32> FreeIndices;
+	int32 NumInterpolators = 0;
+
+	/** Shared by every interpolator, they all step on the same schedule. */
+	float LastUpdateLeftoverTime = 0.f;
+};
+
 struct FInterpolatorTests
 {
 public:
 	static bool RunSubstepTest_CDSpringVector();
+
+	/** Sweeps natural frequencies, hitch lengths and goal speeds, comparing closed form hitch evals to iterated substeps. */
+	static bool RunClosedFormTest_CDSpringVector();
+
+	/** Same sweep for the IIR interpolator, over interp speeds. */
+	static bool RunClosedFormTest_IIRVector();
+
+	/** Steps the same springs through the scalar and batch paths, logs timings and the largest difference. */
+	static bool RunBatchBenchmark_CDSpringVector(int32 NumSprings, int32 NumFrames);
+
+	/** Steps the same interpolators through the scalar and batch IIR paths, logs timings and the largest difference. */
+	static bool RunBatchBenchmark_IIRVector(int32 NumInterpolators, int32 NumFrames);
 };
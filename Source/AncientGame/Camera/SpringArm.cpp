@@ -10,7 +10,7 @@
 //////////////////////////////////////////////////////////////////////////
 // FSpringArm
 
-void FSpringArm::UpdateDesiredArmLocation(const UWorld* WorldContext, const TArray<const AActor*>& IgnoreActors, const FTransform& InitialTransform, const FVector OffsetLocation, bool bDoTrace)
+void FSpringArm::UpdateDesiredArmLocation(const UWorld* WorldContext, TArrayView<const AActor* const> IgnoreActors, const FTransform& InitialTransform, const FVector OffsetLocation, bool bDoTrace)
 {
 	FVector PivotLocation = InitialTransform.GetLocation();
 	FRotator DesiredRot = InitialTransform.Rotator();
@@ -35,15 +35,48 @@ void FSpringArm::UpdateDesiredArmLocation(const UWorld* WorldContext, const TArr
 	if (bDoTrace && (TargetArmLength != 0.0f) && WorldContext != nullptr)
 	{
 		bIsCameraFixed = true;
-		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SpringArm), false);
-		QueryParams.AddIgnoredActors(IgnoreActors);
+		UpdateQueryParams(IgnoreActors);
 
-		FHitResult Result;
-		WorldContext->SweepSingleByChannel(Result, ArmOrigin, DesiredLoc, FQuat::Identity, ProbeChannel, FCollisionShape::MakeSphere(ProbeSize), QueryParams);
-		
 		UnfixedCameraPosition = DesiredLoc;
 
-		ResultLoc = BlendLocations(DesiredLoc, Result.Location, Result.bBlockingHit);
+		if (bUseAsyncCollisionTest)
+		{
+			ConsumeAsyncTrace(WorldContext);
+
+			// Outside the reuse tolerances the last hit can't be trusted, block on a sweep for this tick instead of
+			// issuing an async one. The arm is back within the tolerances of the fresh result on the next tick
+			const bool bSweepNow = CanReuseTrace(ArmOrigin, DesiredLoc) == false;
+			if (bSweepNow)
+			{
+				FHitResult Result;
+				WorldContext->SweepSingleByChannel(Result, ArmOrigin, DesiredLoc, FQuat::Identity, ProbeChannel, FCollisionShape::MakeSphere(ProbeSize), CachedQueryParams);
+				StoreTrace(ArmOrigin, DesiredLoc, Result.bBlockingHit ? &Result : nullptr);
+
+				// A sweep still in flight is older than this one, don't let it replace this result
+				PendingTraceHandle.Invalidate();
+				PendingTraceWorld.Reset();
+			}
+
+			// Apply the hit as a fraction of the current arm, so the camera follows small arm motions
+			const FVector HitLoc = ArmOrigin + (DesiredLoc - ArmOrigin) * LastTraceHitTime;
+			ResultLoc = BlendLocations(DesiredLoc, HitLoc, bLastTraceHit);
+
+			// Sweep the current arm for the next tick, unless this tick already swept it or a sweep issued earlier this frame is still in flight
+			if (bSweepNow == false && PendingTraceHandle.IsValid() == false)
+			{
+				// Async traces are queued on the world, the const world context is only a query interface
+				UWorld* World = const_cast<UWorld*>(WorldContext);
+				PendingTraceHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, ArmOrigin, DesiredLoc, FQuat::Identity, ProbeChannel, FCollisionShape::MakeSphere(ProbeSize), CachedQueryParams);
+				PendingTraceWorld = WorldContext;
+			}
+		}
+		else
+		{
+			FHitResult Result;
+			WorldContext->SweepSingleByChannel(Result, ArmOrigin, DesiredLoc, FQuat::Identity, ProbeChannel, FCollisionShape::MakeSphere(ProbeSize), CachedQueryParams);
+
+			ResultLoc = BlendLocations(DesiredLoc, Result.Location, Result.bBlockingHit);
+		}
 
 		if (ResultLoc == DesiredLoc) 
 		{	
@@ -63,6 +96,98 @@ void FSpringArm::UpdateDesiredArmLocation(const UWorld* WorldContext, const TArr
 	StateIsValid = true;
 }
 
+void FSpringArm::UpdateQueryParams(TArrayView<const AActor* const> IgnoreActors)
+{
+	bool bIgnoreActorsChanged = bQueryParamsValid == false || CachedIgnoreActors.Num() != IgnoreActors.Num();
+
+	for (int32 ActorIndex = 0; bIgnoreActorsChanged == false && ActorIndex < IgnoreActors.Num(); ++ActorIndex)
+	{
+		bIgnoreActorsChanged = CachedIgnoreActors[ActorIndex].Get() != IgnoreActors[ActorIndex];
+	}
+
+	if (bIgnoreActorsChanged == false)
+	{
+		return;
+	}
+
+	CachedQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(SpringArm), false);
+	CachedIgnoreActors.Reset(IgnoreActors.Num());
+
+	for (const AActor* IgnoreActor : IgnoreActors)
+	{
+		CachedQueryParams.AddIgnoredActor(IgnoreActor);
+		CachedIgnoreActors.Add(IgnoreActor);
+	}
+
+	bQueryParamsValid = true;
+}
+
+void FSpringArm::ConsumeAsyncTrace(const UWorld* WorldContext)
+{
+	if (PendingTraceHandle.IsValid() == false)
+	{
+		return;
+	}
+
+	// A sweep issued in another world can't be queried here
+	if (PendingTraceWorld.Get() == WorldContext)
+	{
+		UWorld* World = const_cast<UWorld*>(WorldContext);
+
+		FTraceDatum TraceData;
+		if (World->QueryTraceData(PendingTraceHandle, TraceData))
+		{
+			const FHitResult* BlockingHit = TraceData.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+			StoreTrace(TraceData.Start, TraceData.End, BlockingHit);
+		}
+		else if (World->IsTraceHandleValid(PendingTraceHandle, false))
+		{
+			// Issued earlier this frame, its results come in next frame
+			return;
+		}
+	}
+
+	// Results are only kept for one frame, a tick that missed them falls back on CanReuseTrace
+	PendingTraceHandle.Invalidate();
+	PendingTraceWorld.Reset();
+}
+
+bool FSpringArm::CanReuseTrace(const FVector& ArmOrigin, const FVector& DesiredLoc) const
+{
+	if (bHasLastTrace == false)
+	{
+		return false;
+	}
+
+	if (FVector::DistSquared(ArmOrigin, LastTraceStart) > FMath::Square(AsyncReuseDistance))
+	{
+		return false;
+	}
+
+	const FVector Arm = DesiredLoc - ArmOrigin;
+	const float ArmLength = Arm.Size();
+
+	if (FMath::Abs(ArmLength - LastTraceLength) > AsyncReuseDistance)
+	{
+		return false;
+	}
+
+	// The arm direction has to stay inside the cone around the last sweep
+	return (Arm.GetSafeNormal() | LastTraceDirection) >= FMath::Cos(FMath::DegreesToRadians(AsyncReuseAngle));
+}
+
+void FSpringArm::StoreTrace(const FVector& TraceStart, const FVector& TraceEnd, const FHitResult* BlockingHit)
+{
+	const FVector Trace = TraceEnd - TraceStart;
+
+	bHasLastTrace = true;
+	bLastTraceHit = BlockingHit != nullptr;
+	LastTraceStart = TraceStart;
+	LastTraceDirection = Trace.GetSafeNormal();
+	LastTraceLength = Trace.Size();
+	LastTraceHitTime = BlockingHit ? BlockingHit->Time : 1.0f;
+}
+
 FVector FSpringArm::BlendLocations(const FVector& DesiredArmLocation, const FVector& TraceHitLocation, bool bHitSomething)
 {
 	return bHitSomething ? TraceHitLocation : DesiredArmLocation;
@@ -72,13 +197,14 @@ void FSpringArm::Initialize()
 {
 	bIsCameraFixed = false;
 	StateIsValid = false;
+	bHasLastTrace = false;
+	PendingTraceHandle.Invalidate();
+	PendingTraceWorld.Reset();
 }
 
 void FSpringArm::Tick(const UWorld* WorldContext, const AActor* IgnoreActor, const FTransform& InitialTransform, const FVector OffsetLocation)
 {
-	TArray<const AActor*> IgnoreActorArray;
-	IgnoreActorArray.Add(IgnoreActor);
-	Tick(WorldContext, IgnoreActorArray, InitialTransform, OffsetLocation);
+	UpdateDesiredArmLocation(WorldContext, MakeArrayView(&IgnoreActor, 1), InitialTransform, OffsetLocation, bDoCollisionTest);
 }
 
 void FSpringArm::Tick(const UWorld* WorldContext, const TArray<const AActor*>& IgnoreActors, const FTransform& InitialTransform, const FVector OffsetLocation)
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "SpringArm.generated.h"
 
@@ -45,6 +46,21 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=CameraCollision)
 	bool bDoCollisionTest = true;
 
+	/**
+	 * If true, the collision test is issued as an async sweep and its result is consumed on the next tick, so the game thread does not wait on it.
+	 * The last result is reused while the arm stays within the reuse tolerances, otherwise a blocking sweep replaces the async sweep for that tick.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=CameraCollision, meta=(EditCondition="bDoCollisionTest"))
+	bool bUseAsyncCollisionTest = false;
+
+	/** Maximum angle (in degrees) the arm can turn away from the last sweep for its hit to be reused */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=CameraCollision, meta=(EditCondition="bDoCollisionTest && bUseAsyncCollisionTest", ClampMin="0.0", ClampMax="90.0"))
+	float AsyncReuseAngle = 5.0f;
+
+	/** Maximum distance (in unreal units) the arm origin and length can move away from the last sweep for its hit to be reused */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=CameraCollision, meta=(EditCondition="bDoCollisionTest && bUseAsyncCollisionTest", ClampMin="0.0"))
+	float AsyncReuseDistance = 20.0f;
+
 	/** Should we inherit pitch from parent component. Does nothing if using Absolute Rotation. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=CameraSettings)
 	bool bInheritPitch = true;
@@ -66,7 +82,19 @@ public:
 private:
 
 	/** Updates the desired arm location, calling BlendLocations to do the actual blending if a trace is done */
-	void UpdateDesiredArmLocation(const UWorld* WorldContext, const TArray<const AActor*>& IgnoreActors, const FTransform& InitialTransform, const FVector OffsetLocation, bool bDoTrace);
+	void UpdateDesiredArmLocation(const UWorld* WorldContext, TArrayView<const AActor* const> IgnoreActors, const FTransform& InitialTransform, const FVector OffsetLocation, bool bDoTrace);
+
+	/** Rebuilds the cached query params if the ignored actors changed since the last tick */
+	void UpdateQueryParams(TArrayView<const AActor* const> IgnoreActors);
+
+	/** Picks up the async sweep issued on the previous tick, if its results are ready */
+	void ConsumeAsyncTrace(const UWorld* WorldContext);
+
+	/** Whether the last sweep is close enough to the current arm for its hit to be reused */
+	bool CanReuseTrace(const FVector& ArmOrigin, const FVector& DesiredLoc) const;
+
+	/** Stores a sweep result as the one later ticks can reuse */
+	void StoreTrace(const FVector& TraceStart, const FVector& TraceEnd, const FHitResult* BlockingHit);
 	
 	/**
 	 * This function allows subclasses to blend the trace hit location with the desired arm location;
@@ -80,6 +108,23 @@ private:
 	bool bIsCameraFixed = false;
 	bool StateIsValid = false;
 	FVector UnfixedCameraPosition;
+
+	/** Ignored actors the cached query params were built for */
+	TArray<TWeakObjectPtr<const AActor>> CachedIgnoreActors;
+	FCollisionQueryParams CachedQueryParams;
+	bool bQueryParamsValid = false;
+
+	/** Async sweep issued on the previous tick and the world it was issued in */
+	FTraceHandle PendingTraceHandle;
+	TWeakObjectPtr<const UWorld> PendingTraceWorld;
+
+	/** Last sweep result, kept as a fraction of the arm so it can follow small arm motions */
+	bool bHasLastTrace = false;
+	bool bLastTraceHit = false;
+	FVector LastTraceStart = FVector::ZeroVector;
+	FVector LastTraceDirection = FVector::ForwardVector;
+	float LastTraceLength = 0.0f;
+	float LastTraceHitTime = 1.0f;
 };
 
 UCLASS(meta = (BlueprintThreadSafe, ScriptName = "SpringArmLibrary"))
@@ -14,20 +14,14 @@ void USpringArmCameraMode::OnActivation(AActor* TargetActor)
 	RotationSpringInterpolator.Reset();
 }
 
-FAncientGameCameraModeView USpringArmCameraMode::UpdateView_Implementation(float DeltaTime, AActor* TargetActor)
+bool USpringArmCameraMode::CanUpdateViewInParallel() const
 {
-	UObject* WorldContext = this;
-	TArray<const AActor*> AllIgnoreActors;
-
-	if (TargetActor)
-	{
-		WorldContext = TargetActor;
-
-		// Skip this actor and any attached actors when testing for collision
-		AllIgnoreActors.Add(TargetActor);
-		TargetActor->ForEachAttachedActors([&AllIgnoreActors](AActor* Actor) { AllIgnoreActors.AddUnique(Actor); return true; });
-	}
+	// The pivot only reads the target actor, the springs are owned by this mode and the arm defers its collision sweep to FinishUpdateView
+	return !IsViewScripted();
+}
 
+FAncientGameCameraModeView USpringArmCameraMode::UpdateView_Implementation(float DeltaTime, AActor* TargetActor)
+{
 	FAncientGameCameraModeView NewView = Super::UpdateView_Implementation(DeltaTime, TargetActor);
 
 	// update springs
@@ -38,11 +32,43 @@ FAncientGameCameraModeView USpringArmCameraMode::UpdateView_Implementation(float
 
 	// Update the spring arm using the Pivot and offset provided
 	FTransform CameraTransform(SmoothedRotation, SmoothedLocation);
-	SpringArm.Tick(WorldContext->GetWorld(), AllIgnoreActors, CameraTransform, Offset);
 
-	CameraTransform = SpringArm.GetCameraTransform();
-	NewView.Location = CameraTransform.GetLocation();
-	NewView.Rotation = CameraTransform.Rotator();
+	if (bDeferGameThreadWork)
+	{
+		// The arm's collision sweep has to run on the game thread
+		DeferredArmTransform = CameraTransform;
+	}
+	else
+	{
+		UpdateSpringArm(NewView, CameraTransform, TargetActor);
+	}
 
 	return NewView;
 }
+
+void USpringArmCameraMode::FinishUpdateView(AActor* TargetActor)
+{
+	Super::FinishUpdateView(TargetActor);
+	UpdateSpringArm(View, DeferredArmTransform, TargetActor);
+}
+
+void USpringArmCameraMode::UpdateSpringArm(FAncientGameCameraModeView& InOutView, const FTransform& ArmTransform, AActor* TargetActor)
+{
+	UObject* WorldContext = this;
+	CollisionIgnoreActors.Reset();
+
+	if (TargetActor)
+	{
+		WorldContext = TargetActor;
+
+		// Skip this actor and any attached actors when testing for collision
+		CollisionIgnoreActors.Add(TargetActor);
+		TargetActor->ForEachAttachedActors([this](AActor* Actor) { CollisionIgnoreActors.AddUnique(Actor); return true; });
+	}
+
+	SpringArm.Tick(WorldContext->GetWorld(), CollisionIgnoreActors, ArmTransform, Offset);
+
+	const FTransform& CameraTransform = SpringArm.GetCameraTransform();
+	InOutView.Location = CameraTransform.GetLocation();
+	InOutView.Rotation = CameraTransform.Rotator();
+}
@@ -21,6 +21,7 @@ public:
 
 	//~ Begin ULyraCameraMode interface
 	virtual void OnActivation(AActor* TargetActor) override;
+	virtual bool CanUpdateViewInParallel() const override;
 	//~ End ULyraCameraMode interface
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
@@ -42,5 +43,17 @@ protected:
 
 	//~ Begin UAncientGameCameraMode interface
 	virtual FAncientGameCameraModeView UpdateView_Implementation(float DeltaTime, AActor* TargetActor) override;
+	virtual void FinishUpdateView(AActor* TargetActor) override;
 	//~ End ULyraCameraMode interface
+
+private:
+
+	// Moves the view to the end of the spring arm, sweeping for collision
+	void UpdateSpringArm(FAncientGameCameraModeView& InOutView, const FTransform& ArmTransform, AActor* TargetActor);
+
+	// Arm transform of a view updated in parallel, waiting for FinishUpdateView
+	FTransform DeferredArmTransform;
+
+	// Actors the spring arm ignores, kept between updates so the list is not reallocated every frame
+	TArray<const AActor*> CollisionIgnoreActors;
 };